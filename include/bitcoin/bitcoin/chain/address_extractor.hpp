@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_ADDRESS_EXTRACTOR_HPP
+#define LIBBITCOIN_CHAIN_ADDRESS_EXTRACTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/history.hpp>
+#include <bitcoin/bitcoin/chain/script/operation.hpp>
+#include <bitcoin/bitcoin/chain/script/script.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// This class is not thread safe.
+/// Extracts address index rows from blocks. Scripts are classified from their
+/// serialized form, without parsing operations or encoding payment addresses.
+/// Public keys are collected as the block is walked and hashed in one pass at
+/// the end. Working space is retained across blocks.
+class BC_API address_extractor
+{
+public:
+    typedef std::vector<data_slice> payloads;
+
+    /// Classify a serialized output script, setting the payloads from which
+    /// its addresses derive: the hash of a pay-key-hash or pay-script-hash
+    /// script, or the keys of a pay-public-key or bare multisig script. Any
+    /// other script is non_standard, and null_data has no payloads. The
+    /// payloads refer to the script.
+    static script_pattern classify(payloads& out, data_slice script);
+
+    address_extractor();
+
+    /// Append a row for each address paid by an output of the block, and for
+    /// each address spent by a pay-key-hash or pay-script-hash input.
+    void extract(address_row::list& out, const block& block,
+        uint32_t height);
+
+private:
+    typedef std::vector<size_t> indexes;
+
+    const data_chunk& serialized(const script& script);
+    void extract_output(address_row::list& out, const data_chunk& script);
+    void extract_input(address_row::list& out, const data_chunk& script);
+    void add_hash(address_row::list& out, data_slice hash);
+    void add_preimage(address_row::list& out, data_slice preimage);
+    void hash_preimages(address_row::list& out);
+
+    payloads payloads_;
+    payloads pushes_;
+    data_chunk script_;
+    data_chunk preimages_;
+    indexes preimage_rows_;
+    indexes preimage_offsets_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
@@ -35,6 +35,7 @@
 #include <bitcoin/bitcoin/math/hash_number.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -63,6 +64,10 @@ public:
     static block factory_from_data(reader& source);
 
     static hash_number difficulty(uint32_t bits);
+
+    /// The cumulative proof of work of the headers (chain work).
+    static hash_number difficulty(const header::list& headers);
+
     static uint64_t subsidy(size_t height);
     static size_t locator_size(size_t top);
     static indexes locator_heights(size_t top);
@@ -101,6 +106,11 @@ public:
     code connect(const chain_state& state) const;
     code connect_transactions(const chain_state& state) const;
 
+    /// Connect transaction inputs concurrently, same result as serial.
+    /// This blocks the calling thread, which must not be of the pool.
+    code connect_transactions(const chain_state& state,
+        threadpool& pool) const;
+
     uint64_t fees() const;
     uint64_t claim() const;
     uint64_t reward(size_t height) const;
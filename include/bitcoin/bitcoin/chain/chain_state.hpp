@@ -33,6 +33,8 @@
 namespace libbitcoin {
 namespace chain {
 
+class header;
+
 class BC_API chain_state
 {
 public:
@@ -100,6 +102,17 @@ public:
     /// Checkpoints must be ordered by height with greatest at back.
     chain_state(data&& values, const checkpoints& checkpoints);
 
+    /// Promote the parent state to the next height, where top is the header
+    /// at the parent height. Forks are enabled if enabled in the parent and
+    /// samples are copied from the parent, sliding by one height to the ranges
+    /// of the height map. Version counts and the median time past window are
+    /// maintained incrementally, not recounted or resorted. The parent
+    /// version sample is taken as ordered by height. The timestamp of the
+    /// block at the new height is used only on testnet, and the timestamp of
+    /// the block one retargeting interval below it only at retarget heights.
+    chain_state(const chain_state& parent, const header& top,
+        uint32_t timestamp_self, uint32_t timestamp_retarget);
+
     /// Properties.
     size_t height() const;
     uint32_t enabled_forks() const;
@@ -140,6 +153,24 @@ protected:
     static uint32_t work_required(const data& values);
 
 private:
+    struct version_counts
+    {
+        size_t count_4;
+        size_t count_3;
+        size_t count_2;
+    };
+
+    static data to_promoted(const data& parent, bool enabled,
+        const header& top, uint32_t timestamp_self,
+        uint32_t timestamp_retarget);
+    static version_counts count_versions(const versions& history);
+    static version_counts promote_counts(const version_counts& parent,
+        const versions& parent_history, const versions& history);
+    static timestamps sort_timestamps(const timestamps& ordered);
+    static timestamps promote_sorted(const timestamps& parent_sorted,
+        const timestamps& parent_ordered, const timestamps& ordered);
+    static activations activation(const data& values,
+        const version_counts& counts);
     static bool is_retarget_height(size_t height);
     static bool is_retarget_or_nonmax(size_t height, uint32_t bits);
     static uint32_t retarget_timespan(const chain_state::data& values);
@@ -150,6 +181,10 @@ private:
     // A similar height clone can be partially computed, reducing query cost.
     const data data_;
 
+    // These summarize the sample, so that promotion need not recompute them.
+    const version_counts version_counts_;
+    const timestamps sorted_timestamps_;
+
     // These are computed on construct from sample and checkpoints.
     const activations active_;
     const uint32_t median_time_past_;
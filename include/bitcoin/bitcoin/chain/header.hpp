@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_CHAIN_HEADER_HPP
 #define LIBBITCOIN_CHAIN_HEADER_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <istream>
 #include <string>
@@ -97,6 +98,9 @@ public:
     bool is_valid_time_stamp() const;
     bool is_valid_proof_of_work() const;
 
+    /// Proof of work against the hash of this header, such as from a batch.
+    bool is_valid_proof_of_work(const hash_digest& hash) const;
+
     code check() const;
     code accept(const chain_state& state) const;
 
@@ -111,8 +115,7 @@ public:
     bool operator!=(const header& other) const;
 
 private:
-    mutable upgrade_mutex mutex_;
-    mutable std::shared_ptr<hash_digest> hash_;
+    void invalidate_hash() const;
 
     uint32_t version_;
     hash_digest previous_block_hash_;
@@ -124,6 +127,10 @@ private:
     // The longest size (64) of a protocol variable int is deserialized here.
     // When writing a block the size of the transaction collection is used.
     uint64_t transaction_count_;
+
+    // The hash is published once computed, readers do not lock.
+    mutable std::atomic<uint8_t> hash_state_;
+    mutable hash_digest hash_;
 };
 
 } // namespace chain
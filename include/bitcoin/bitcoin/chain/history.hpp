@@ -25,6 +25,7 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/input_point.hpp>
 #include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -62,6 +63,34 @@ struct BC_API history_compact
     };
 };
 
+/// This structure is a history_compact row keyed by address hash160, as
+/// produced by address_extractor for building address indexes.
+struct BC_API address_row
+{
+    typedef std::vector<address_row> list;
+
+    /// The hash160 of the public key or script of the address.
+    short_hash hash;
+
+    // The type of point (output or spend).
+    point_kind kind;
+
+    /// The point that identifies the record.
+    chain::point point;
+
+    /// The height of the point.
+    uint32_t height;
+
+    union
+    {
+        /// If output, then satoshi value of output.
+        uint64_t value;
+
+        /// If spend, then checksum hash of previous output point.
+        uint64_t previous_checksum;
+    };
+};
+
 /// This structure is used between client and API callers in v3.
 /// This structure models the client-server protocol in v1/v2.
 /// The height values here are 64 bit, but 32 bits on the wire.
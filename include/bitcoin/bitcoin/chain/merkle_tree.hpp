@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_MERKLE_TREE_HPP
+#define LIBBITCOIN_CHAIN_MERKLE_TREE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// This class is thread safe.
+/// The merkle tree of a list of transaction hashes, with every level retained
+/// so that any number of partial trees (bip37) are built without rehashing.
+class BC_API merkle_tree
+{
+public:
+    typedef std::vector<size_t> indexes;
+
+    /// Decode and verify a partial tree of the given number of leaves. Returns
+    /// the root, or null_hash if the tree is malformed, setting the matched
+    /// leaf hashes and their positions in leaf order.
+    static hash_digest extract(hash_list& matches, indexes& positions,
+        size_t leaves, const hash_list& hashes, const data_chunk& flags);
+
+    merkle_tree(const hash_list& leaves);
+    merkle_tree(hash_list&& leaves);
+
+    /// The root, null_hash if there are no leaves.
+    hash_digest root() const;
+    size_t size() const;
+    const hash_list& leaves() const;
+
+    /// Encode the partial tree of the leaves at the sorted positions.
+    void partial(hash_list& hashes, data_chunk& flags,
+        const indexes& positions) const;
+
+private:
+    void build();
+    void traverse(hash_list& hashes, std::vector<bool>& bits,
+        const indexes& positions, size_t height, size_t position) const;
+
+    // The levels, from the leaves to the root.
+    std::vector<hash_list> levels_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
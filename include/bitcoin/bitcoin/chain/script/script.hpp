@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_CHAIN_SCRIPT_HPP
 #define LIBBITCOIN_CHAIN_SCRIPT_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <istream>
 #include <string>
@@ -28,6 +29,7 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/chain/script/operation.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
@@ -118,6 +120,10 @@ public:
     static code verify(const transaction& tx, uint32_t input_index,
         const script& prevout_script, uint32_t flags);
 
+    /// The valid signatures cached by check_signature, so that signatures
+    /// verified on pool acceptance are not verified again in block connect.
+    static signature_cache& verified_signatures();
+
     script();
     script(const operation::stack& operations);
     script(operation::stack&& operations);
@@ -132,6 +138,10 @@ public:
     script_pattern pattern() const;
     bool is_raw_data() const;
 
+    /// The serialized script (without prefix) retained when it was read, or
+    /// empty if it has since been constructed or modified from operations.
+    const data_chunk& retained_data() const;
+
     size_t pay_script_hash_sigops(const script& prevout) const;
     size_t sigops(bool serialized_script) const;
 
@@ -158,11 +168,17 @@ public:
     bool operator!=(const script& other) const;
 
 private:
-    bool deserialize(const data_chunk& raw_script, parse_mode mode);
-    bool parse(const data_chunk& raw_script);
-
-    operation::stack operations_;
+    bool deserialize(data_chunk&& raw_script, parse_mode mode);
+    void parse() const;
+    void clear_bytes();
+
+    // A read script retains its serialized form, which is authoritative until
+    // the operations are modified. Operations are parsed from it on demand.
+    data_chunk bytes_;
+    bool has_bytes_;
     bool is_raw_;
+    mutable std::atomic<uint8_t> parse_state_;
+    mutable operation::stack operations_;
 };
 
 } // namespace chain
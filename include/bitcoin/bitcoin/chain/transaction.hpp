@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_CHAIN_TRANSACTION_HPP
 #define LIBBITCOIN_CHAIN_TRANSACTION_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -32,6 +33,7 @@
 #include <bitcoin/bitcoin/chain/output.hpp>
 #include <bitcoin/bitcoin/chain/point.hpp>
 #include <bitcoin/bitcoin/chain/script/opcode.hpp>
+#include <bitcoin/bitcoin/chain/script/script.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
@@ -82,6 +84,7 @@ public:
         bool satoshi=true);
     static transaction factory_from_data(reader& source, bool satoshi=true);
     static sets_ptr reserve_buckets(size_t total, size_t fanout);
+    static sets_const_ptr balance_buckets(const set& elements, size_t fanout);
 
     transaction();
     transaction(uint32_t version, uint32_t locktime, const input::list& inputs,
@@ -129,6 +132,13 @@ public:
     uint64_t fees() const;
     hash_digest hash() const;
     hash_digest hash(uint32_t sighash_type) const;
+
+    /// Compute the signature hash of the input without copying the tx.
+    /// Serialization state common to all inputs is computed once and cached.
+    /// The input index must be valid and under sighash single must have a
+    /// corresponding output (see script::generate_signature_hash).
+    hash_digest signature_hash(uint32_t input_index, const script& script_code,
+        uint8_t sighash_type) const;
     uint64_t serialized_size() const;
     uint64_t total_input_value() const;
     uint64_t total_output_value() const;
@@ -157,13 +167,32 @@ public:
     mutable validation validation;
 
 private:
+    struct sighash_cache;
+    typedef std::shared_ptr<const sighash_cache> sighash_cache_ptr;
+
+    sighash_cache_ptr signature_hash_cache() const;
+    void invalidate_signature_hash_cache() const;
+    void invalidate_cache() const;
+
     uint32_t version_;
     uint32_t locktime_;
     input::list inputs_;
     output::list outputs_;
 
-    mutable upgrade_mutex hash_mutex_;
-    mutable std::shared_ptr<hash_digest> hash_;
+    // The hash is published once computed, readers do not lock.
+    mutable std::atomic<uint8_t> hash_state_;
+    mutable hash_digest hash_;
+
+    // Aggregates are published once computed, readers do not lock.
+    // Values that depend upon prevouts are not retained until populated.
+    mutable std::atomic<uint64_t> serialized_size_;
+    mutable std::atomic<uint64_t> total_input_value_;
+    mutable std::atomic<uint64_t> total_output_value_;
+    mutable std::atomic<size_t> signature_operations_;
+    mutable std::atomic<size_t> signature_operations_bip16_;
+
+    mutable upgrade_mutex sighash_mutex_;
+    mutable sighash_cache_ptr sighash_cache_;
 };
 
 } // namespace chain
@@ -21,8 +21,10 @@
 #define LIBBITCOIN_BASE_58_HPP
 
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/string.hpp>
 
 namespace libbitcoin {
 
@@ -36,6 +38,13 @@ BC_API bool is_base58(const std::string& text);
 template <size_t Size>
 bool decode_base58(byte_array<Size>& out, const std::string &in);
 
+/**
+ * Converts a batch of base58 strings to arrays of bytes, in order.
+ * @return false if any input is malformed, or the wrong length.
+ */
+template <size_t Size>
+bool decode_base58(std::vector<byte_array<Size>>& out, const string_list& in);
+
 /**
  * Converts a base58 string literal to a data array.
  * This would be better as a C++11 user-defined literal,
@@ -51,6 +60,20 @@ byte_array<Size * 733 / 1000> base58_literal(const char(&string)[Size]);
  */
 BC_API std::string encode_base58(data_slice unencoded);
 
+/**
+ * Encode a fixed size array as base58, without heap allocated working space.
+ * @return the base58 encoded string.
+ */
+template <size_t Size>
+std::string encode_base58(const byte_array<Size>& unencoded);
+
+/**
+ * Encode a batch of fixed size arrays as base58, in order.
+ * @return the base58 encoded strings.
+ */
+template <size_t Size>
+string_list encode_base58(const std::vector<byte_array<Size>>& unencoded);
+
 /**
  * Attempt to decode base58 data.
  * @return false if the input contains non-base58 characters.
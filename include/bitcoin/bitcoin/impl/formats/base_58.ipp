@@ -20,8 +20,14 @@
 #ifndef LIBBITCOIN_BASE_58_IPP
 #define LIBBITCOIN_BASE_58_IPP
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/string.hpp>
 
 namespace libbitcoin {
 
@@ -29,17 +35,71 @@ namespace libbitcoin {
 BC_API bool decode_base58_private(uint8_t* out, size_t out_size,
     const char* in);
 
+// For support of template implementation only, do not call directly.
+BC_API bool decode_base58_private(uint8_t* out, size_t out_size,
+    const char* in, size_t in_size, uint32_t* limbs);
+
+// For support of template implementation only, do not call directly.
+BC_API size_t encode_base58_private(char* out, const uint8_t* in,
+    size_t size, uint64_t* limbs);
+
 template <size_t Size>
 bool decode_base58(byte_array<Size>& out, const std::string &in)
 {
     byte_array<Size> result;
-    if (!decode_base58_private(result.data(), result.size(), in.data()))
+    uint32_t limbs[Size / 4 + 1];
+    if (!decode_base58_private(result.data(), result.size(), in.data(),
+        in.size(), limbs))
         return false;
 
     out = result;
     return true;
 }
 
+template <size_t Size>
+bool decode_base58(std::vector<byte_array<Size>>& out, const string_list& in)
+{
+    std::vector<byte_array<Size>> result(in.size());
+    uint32_t limbs[Size / 4 + 1];
+
+    for (size_t index = 0; index < in.size(); ++index)
+        if (!decode_base58_private(result[index].data(), Size,
+            in[index].data(), in[index].size(), limbs))
+            return false;
+
+    out = std::move(result);
+    return true;
+}
+
+// log(256) / log(58), rounded up, in limbs of five digits.
+template <size_t Size>
+std::string encode_base58(const byte_array<Size>& unencoded)
+{
+    uint64_t limbs[Size * 138 / 500 + 2];
+    char encoded[Size * 138 / 100 + 1];
+    const auto size = encode_base58_private(encoded, unencoded.data(), Size,
+        limbs);
+    return std::string(encoded, size);
+}
+
+template <size_t Size>
+string_list encode_base58(const std::vector<byte_array<Size>>& unencoded)
+{
+    string_list out;
+    out.reserve(unencoded.size());
+    uint64_t limbs[Size * 138 / 500 + 2];
+    char encoded[Size * 138 / 100 + 1];
+
+    for (const auto& item: unencoded)
+    {
+        const auto size = encode_base58_private(encoded, item.data(), Size,
+            limbs);
+        out.emplace_back(encoded, size);
+    }
+
+    return out;
+}
+
 // TODO: determine if the sizing function is always accurate.
 template <size_t Size>
 byte_array<Size * 733 / 1000> base58_literal(const char(&string)[Size])
@@ -30,7 +30,15 @@ template<size_t Size>
 byte_array<Size> scrypt(data_slice data, data_slice salt, uint64_t N,
     uint32_t p, uint32_t r)
 {
-    const auto out = scrypt(data, salt, N, r, p, Size);
+    const auto out = scrypt(data, salt, N, p, r, Size);
+    return to_array<Size>({ out });
+}
+
+template<size_t Size>
+byte_array<Size> scrypt(data_slice data, data_slice salt, uint64_t N,
+    uint32_t p, uint32_t r, data_chunk& scratch)
+{
+    const auto out = scrypt(data, salt, N, p, r, Size, scratch);
     return to_array<Size>({ out });
 }
 
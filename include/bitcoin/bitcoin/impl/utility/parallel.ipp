@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_IPP
+#define LIBBITCOIN_PARALLEL_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+template <typename Handler>
+void parallel_for(threadpool& pool, size_t count, Handler handler)
+{
+    if (count == 0)
+        return;
+
+    // Divide the count into contiguous ranges of (nearly) equal size.
+    const auto ranges = std::min(pool.size() + 1, count);
+    const auto quotient = count / ranges;
+    const auto remainder = count % ranges;
+
+    unique_mutex mutex;
+    boost::condition_variable completed;
+    std::exception_ptr failure;
+    auto remaining = ranges;
+
+    const auto handle = [&](size_t begin, size_t end)
+    {
+        std::exception_ptr exception;
+
+        try
+        {
+            handler(begin, end);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        boost::lock_guard<unique_mutex> lock(mutex);
+
+        if (exception && !failure)
+            failure = exception;
+
+        if (--remaining == 0)
+            completed.notify_one();
+        ///////////////////////////////////////////////////////////////////////
+    };
+
+    size_t begin = 0;
+
+    for (size_t range = 0; range < ranges; ++range)
+    {
+        const auto end = begin + quotient + (range < remainder ? 1 : 0);
+
+        // The last range is handled on the calling thread.
+        if (range + 1 == ranges)
+            handle(begin, end);
+        else
+            pool.service().post(std::bind(handle, begin, end));
+
+        begin = end;
+    }
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::unique_lock<unique_mutex> lock(mutex);
+
+    while (remaining != 0)
+        completed.wait(lock);
+
+    if (failure)
+        std::rethrow_exception(failure);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename Handler>
+void parallel_for(size_t threads, size_t count, Handler handler)
+{
+    // The calling thread handles one of the ranges.
+    const auto concurrency = std::min(threads, count);
+
+    // A single range requires no pool.
+    if (concurrency < 2)
+    {
+        if (count != 0)
+            handler(0, count);
+
+        return;
+    }
+
+    threadpool pool(concurrency - 1);
+    parallel_for(pool, count, handler);
+}
+
+} // namespace libbitcoin
+
+#endif
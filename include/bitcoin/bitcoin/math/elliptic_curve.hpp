@@ -21,6 +21,7 @@
 #define LIBBITCOIN_ELLIPTIC_CURVE_HPP
 
 #include <cstddef>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
@@ -32,6 +33,8 @@ namespace libbitcoin {
 BC_CONSTEXPR size_t ec_secret_size = 32;
 typedef byte_array<ec_secret_size> ec_secret;
 
+typedef std::vector<ec_secret> secret_list;
+
 /// Compressed public key:
 BC_CONSTEXPR size_t ec_compressed_size = 33;
 typedef byte_array<ec_compressed_size> ec_compressed;
@@ -61,6 +64,16 @@ struct BC_API recoverable_signature
     uint8_t recovery_id;
 };
 
+/// Potential point, signature hash and signature for batch verification:
+struct BC_API signature_verification
+{
+    typedef std::vector<signature_verification> list;
+
+    data_chunk point;
+    hash_digest hash;
+    ec_signature signature;
+};
+
 BC_CONSTEXPR ec_compressed null_compressed_point =
 {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -86,6 +99,13 @@ BC_API bool ec_add(ec_compressed& point, const ec_secret& secret);
 /// return false on failure (such as infinity or zero).
 BC_API bool ec_add(ec_uncompressed& point, const ec_secret& secret);
 
+/// Compute the sums out[i] = a + G*b[i], setting each in order. The point is
+/// parsed once and the sums are divided among the specified number of threads
+/// (including the calling thread). A failed sum is set to the null point.
+/// return false if the point is invalid or any sum fails.
+BC_API bool ec_add(point_list& out, const ec_compressed& point,
+    const secret_list& secrets, size_t threads=1);
+
 /// Compute the sum a = (a + b) % n, where n is the curve order.
 /// return false on failure (such as a zero result).
 BC_API bool ec_add(ec_secret& left, const ec_secret& right);
@@ -171,6 +191,13 @@ BC_API bool verify_signature(const ec_uncompressed& point,
 BC_API bool verify_signature(data_slice point, const hash_digest& hash,
     const ec_signature& signature);
 
+/// Verify a batch of EC signatures, setting the result of each in order.
+/// Each distinct point is parsed once and verification is divided among the
+/// specified number of threads (including the calling thread).
+/// Returns true if all signatures are valid (or the batch is empty).
+BC_API bool verify_signatures(std::vector<bool>& out,
+    const signature_verification::list& batch, size_t threads=1);
+
 // Recoverable sign/recover
 // ----------------------------------------------------------------------------
 
@@ -21,6 +21,7 @@
 #define LIBBITCOIN_HASH_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <boost/functional/hash_fwd.hpp>
@@ -54,6 +55,16 @@ typedef std::vector<long_hash> long_hash_list;
 typedef std::vector<short_hash> short_hash_list;
 typedef std::vector<mini_hash> mini_hash_list;
 
+/// The accelerated hash kernels, selected at runtime by cpu feature detection.
+enum hash_kernel : uint32_t
+{
+    portable_kernels = 0,
+    sse41_kernels = 1 << 0,
+    avx2_kernels = 1 << 1,
+    shani_kernels = 1 << 2,
+    all_kernels = sse41_kernels | avx2_kernels | shani_kernels
+};
+
 // Null-valued common bitcoin hashes.
 
 BC_CONSTEXPR hash_digest null_hash
@@ -112,6 +123,15 @@ template <size_t Size>
 byte_array<Size> scrypt(data_slice data, data_slice salt, uint64_t N,
     uint32_t p, uint32_t r);
 
+/**
+ * Generate a scrypt hash to fill a byte array, reusing the scratch space.
+ *
+ * scrypt(data, salt, params)
+ */
+template <size_t Size>
+byte_array<Size> scrypt(data_slice data, data_slice salt, uint64_t N,
+    uint32_t p, uint32_t r, data_chunk& scratch);
+
 /**
  * Generate a ripemd160 hash. This hash function is used in script for
  * op_ripemd160.
@@ -173,6 +193,27 @@ BC_API long_hash hmac_sha512_hash(data_slice data, data_slice key);
 BC_API long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations);
 
+/**
+ * Generate a pkcs5 pbkdf2 hmac sha512 hash of each passphrase with the salt
+ * at the same position. Hashes are divided among the threads, and each thread
+ * derives several at once where the cpu supports it. The result is empty if
+ * the number of salts differs from the number of passphrases.
+ */
+BC_API long_hash_list pkcs5_pbkdf2_hmac_sha512(const data_stack& passphrases,
+    const data_stack& salts, size_t iterations, size_t threads=1);
+
+/**
+ * The hash kernels in use, a combination of hash_kernel flags.
+ */
+BC_API uint32_t hash_kernels();
+
+/**
+ * Restrict the hash kernels to those in the mask, intersected with those that
+ * the cpu supports, returning the kernels in use. All results are unaffected,
+ * this allows each kernel to be tested against the portable implementation.
+ */
+BC_API uint32_t restrict_hash_kernels(uint32_t mask);
+
 /**
  * Generate a typical bitcoin hash. This is the most widely used
  * hash function in Bitcoin.
@@ -181,6 +222,24 @@ BC_API long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
  */
 BC_API hash_digest bitcoin_hash(data_slice data);
 
+/**
+ * Generate bitcoin hashes of each consecutive pair of hashes. This is the
+ * merkle tree node hash, computed in parallel lanes where the cpu supports
+ * it. The number of hashes must be even, out is resized to half of it.
+ *
+ * sha256(sha256(left + right))
+ */
+BC_API void bitcoin_hash_pairs(hash_list& out, const hash_list& hashes);
+
+/**
+ * Generate bitcoin hashes of each consecutive 80 byte block header in data,
+ * computed in parallel lanes where the cpu supports it. The data size must be
+ * a multiple of 80, out is resized to the number of headers.
+ *
+ * sha256(sha256(header))
+ */
+BC_API void bitcoin_hash_headers(hash_list& out, data_slice headers);
+
 /**
  * Generate a bitcoin short hash. This hash function is used in a
  * few specific cases where short hashes are desired.
@@ -189,6 +248,30 @@ BC_API hash_digest bitcoin_hash(data_slice data);
  */
 BC_API short_hash bitcoin_short_hash(data_slice data);
 
+/**
+ * Generate a 32 bit murmur3 hash. This hash function is used in bip37 bloom
+ * filters, where it is not required to be cryptographically secure.
+ *
+ * murmur3(data, seed)
+ */
+BC_API uint32_t murmur3_hash(data_slice data, uint32_t seed);
+
+/**
+ * Generate a 64 bit siphash-2-4 keyed hash. This hash function is used in
+ * bip152 compact block short transaction ids.
+ *
+ * siphash(k0, k1, data)
+ */
+BC_API uint64_t siphash(uint64_t k0, uint64_t k1, data_slice data);
+
+/**
+ * Generate a 64 bit siphash-2-4 keyed hash of a hash, specialized for the
+ * fixed size (bip152 short ids are computed for every candidate transaction).
+ *
+ * siphash(k0, k1, hash)
+ */
+BC_API uint64_t siphash(uint64_t k0, uint64_t k1, const hash_digest& hash);
+
 /**
  * Generate a scrypt hash of specified length.
  *
@@ -197,6 +280,27 @@ BC_API short_hash bitcoin_short_hash(data_slice data);
 BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
     uint32_t p, uint32_t r, size_t length);
 
+/**
+ * Generate a scrypt hash of specified length, reusing the scratch space.
+ * The scratch is enlarged as required and retained by the caller, which
+ * avoids reallocating the large working space over repeated calls. It must
+ * not be shared by concurrent calls.
+ *
+ * scrypt(data, salt, params)
+ */
+BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
+    uint32_t p, uint32_t r, size_t length, data_chunk& scratch);
+
+/**
+ * Generate a scrypt hash of specified length, mixing the p independent lanes
+ * in parallel, divided among the threads. Each thread requires its own
+ * working space of 128 * r * N bytes.
+ *
+ * scrypt(data, salt, params)
+ */
+BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
+    uint32_t p, uint32_t r, size_t length, size_t threads);
+
 } // namespace libbitcoin
 
 // Extend std and boost namespaces with our hash wrappers.
@@ -66,6 +66,10 @@ public:
     bool operator>=(const hash_number& value) const;
     bool operator<=(const hash_number& value) const;
 
+    /// True if the hash (little endian) does not exceed this target, compared
+    /// in place from the most significant limb.
+    bool is_met_by(const hash_digest& hash) const;
+
 private:
     uint256_t hash_;
 };
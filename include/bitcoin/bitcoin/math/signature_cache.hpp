@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIGNATURE_CACHE_HPP
+#define LIBBITCOIN_SIGNATURE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <unordered_set>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+/// This class is thread safe.
+/// A bounded set of successful signature verifications, identified by the
+/// hash of the point, signature hash and signature. Only valid signatures are
+/// stored, so a hit is always safe to accept. Once full the oldest entry is
+/// evicted for each new one.
+class BC_API signature_cache
+{
+public:
+    /// The default number of entries (about 32 bytes of key each).
+    static const size_t default_capacity;
+
+    /// Construct a cache of the specified number of entries.
+    signature_cache(size_t capacity=default_capacity);
+
+    /// This class is not copyable.
+    signature_cache(const signature_cache&) = delete;
+    void operator=(const signature_cache&) = delete;
+
+    /// True if the signature is cached as valid, counted as a hit or miss.
+    bool contains(data_slice point, const hash_digest& hash,
+        const ec_signature& signature) const;
+
+    /// Cache the signature as valid.
+    void store(data_slice point, const hash_digest& hash,
+        const ec_signature& signature);
+
+    /// Remove all entries and reset the counters.
+    void clear();
+
+    size_t capacity() const;
+    size_t size() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+private:
+    static hash_digest key(data_slice point, const hash_digest& hash,
+        const ec_signature& signature);
+
+    const size_t capacity_;
+    mutable std::atomic<uint64_t> hits_;
+    mutable std::atomic<uint64_t> misses_;
+
+    // These are protected by mutex.
+    std::unordered_set<hash_digest> entries_;
+    std::queue<hash_digest> order_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -27,17 +27,21 @@ public:
     }
 };
 
-/** Template base class for unsigned big integers. */
+/**
+ * Template base class for unsigned big integers.
+ * The value is stored in 64 bit limbs, least significant first, so that the
+ * byte order of begin()/end() is little endian on little endian platforms.
+ */
 template <unsigned int BITS>
 class BC_API base_uint
 {
 protected:
     enum 
     { 
-        WIDTH = BITS / 32
+        WIDTH = BITS / 64
     };
 
-    uint32_t pn[WIDTH];
+    uint64_t pn[WIDTH];
 
 public:
 
@@ -63,9 +67,8 @@ public:
 
     base_uint(uint64_t b)
     {
-        pn[0] = (unsigned int)b;
-        pn[1] = (unsigned int)(b >> 32);
-        for (int i = 2; i < WIDTH; i++)
+        pn[0] = b;
+        for (int i = 1; i < WIDTH; i++)
             pn[i] = 0;
     }
 
@@ -101,9 +104,8 @@ public:
 
     base_uint& operator=(uint64_t b)
     {
-        pn[0] = (unsigned int)b;
-        pn[1] = (unsigned int)(b >> 32);
-        for (int i = 2; i < WIDTH; i++)
+        pn[0] = b;
+        for (int i = 1; i < WIDTH; i++)
             pn[i] = 0;
 
         return *this;
@@ -135,15 +137,13 @@ public:
 
     base_uint& operator^=(uint64_t b)
     {
-        pn[0] ^= (unsigned int)b;
-        pn[1] ^= (unsigned int)(b >> 32);
+        pn[0] ^= b;
         return *this;
     }
 
     base_uint& operator|=(uint64_t b)
     {
-        pn[0] |= (unsigned int)b;
-        pn[1] |= (unsigned int)(b >> 32);
+        pn[0] |= b;
         return *this;
     }
 
@@ -155,9 +155,10 @@ public:
         uint64_t carry = 0;
         for (int i = 0; i < WIDTH; i++)
         {
-            uint64_t n = carry + pn[i] + b.pn[i];
-            pn[i] = n & 0xffffffff;
-            carry = n >> 32;
+            const uint64_t n = pn[i] + b.pn[i];
+            const uint64_t m = n + carry;
+            carry = (n < pn[i] ? 1 : 0) + (m < n ? 1 : 0);
+            pn[i] = m;
         }
 
         return *this;
@@ -171,9 +172,15 @@ public:
 
     base_uint& operator+=(uint64_t b64)
     {
-        base_uint b;
-        b = b64;
-        *this += b;
+        // Propagate the carry only as far as it goes.
+        pn[0] += b64;
+        if (pn[0] >= b64)
+            return *this;
+
+        int i = 1;
+        while (i < WIDTH && ++pn[i] == 0)
+            i++;
+
         return *this;
     }
 
@@ -211,7 +218,7 @@ public:
     {
         // prefix operator
         int i = 0;
-        while (--pn[i] == (uint32_t)-1 && i < WIDTH - 1)
+        while (--pn[i] == (uint64_t)-1 && i < WIDTH - 1)
             i++;
 
         return *this;
@@ -282,9 +289,14 @@ public:
 
     uint64_t GetLow64() const
     {
-        BITCOIN_ASSERT(WIDTH >= 2);
-        return pn[0] | (uint64_t)pn[1] << 32;
+        BITCOIN_ASSERT(WIDTH >= 1);
+        return pn[0];
     }
+
+    /**
+     * Compare to a little endian number of the same size, in place.
+     */
+    int CompareTo(const unsigned char* little_endian) const;
 };
 
 /** 256-bit unsigned big integer. */
@@ -329,6 +341,63 @@ public:
     uint32_t GetCompact(bool fNegative = false) const;
     uint256_t& SetCompact(uint32_t nCompact, bool *pfNegative = NULL,
         bool *pfOverflow = NULL);
+
+    /**
+     * Compile time decoding of the compact format, limb by limb, so that a
+     * target can be set without shifting.
+     */
+    static BC_CONSTFUNC uint32_t compact_exponent(uint32_t compact)
+    {
+        return compact >> 24;
+    }
+
+    static BC_CONSTFUNC uint32_t compact_mantissa(uint32_t compact)
+    {
+        return compact & 0x007fffff;
+    }
+
+    /** The mantissa, shifted right if the exponent is less than three. */
+    static BC_CONSTFUNC uint32_t compact_word(uint32_t compact)
+    {
+        return compact_exponent(compact) <= 3 ? compact_mantissa(compact) >>
+            (8 * (3 - compact_exponent(compact))) : compact_mantissa(compact);
+    }
+
+    static BC_CONSTFUNC bool is_negative_compact(uint32_t compact)
+    {
+        return compact_word(compact) != 0 && (compact & 0x00800000) != 0;
+    }
+
+    static BC_CONSTFUNC bool is_overflow_compact(uint32_t compact)
+    {
+        return compact_word(compact) != 0 && (
+            (compact_exponent(compact) > 34) ||
+            (compact_word(compact) > 0xff && compact_exponent(compact) > 33) ||
+            (compact_word(compact) > 0xffff && compact_exponent(compact) > 32));
+    }
+
+    /**
+     * The limb at the index (least significant first) of the decoded value,
+     * the mantissa shifted left by 8 * (exponent - 3) bits and truncated.
+     */
+    static BC_CONSTFUNC uint64_t compact_limb(uint32_t compact,
+        unsigned int index)
+    {
+        return compact_exponent(compact) <= 3 ?
+            (index == 0 ? uint64_t(compact_word(compact)) : 0) :
+            compact_limb_shifted(compact_mantissa(compact),
+                8 * (compact_exponent(compact) - 3), index);
+    }
+
+private:
+    static BC_CONSTFUNC uint64_t compact_limb_shifted(uint32_t mantissa,
+        uint32_t shift, unsigned int index)
+    {
+        return index == shift / 64 ?
+            uint64_t(mantissa) << (shift % 64) :
+            (index == shift / 64 + 1 && shift % 64 != 0 ?
+                uint64_t(mantissa) >> (64 - shift % 64) : 0);
+    }
 };
 
 } // namespace libbitcoin
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+#define LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/message/filter_add.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// This class is not thread safe.
+/// The bip37 filter of a peer, as loaded by filter_load and extended by
+/// filter_add. Matching a transaction may insert its outputs' points into
+/// the filter, as directed by the load flags, so that spends also match.
+class BC_API bloom_filter
+{
+public:
+    typedef std::shared_ptr<bloom_filter> ptr;
+    typedef std::vector<ptr> ptr_list;
+
+    /// The load flags, which direct filter updates on output matches.
+    enum update : uint8_t
+    {
+        update_none = 0,
+        update_all = 1,
+        update_pay_public_key_only = 2,
+        update_mask = 3
+    };
+
+    static const size_t max_filter_size;
+    static const uint32_t max_hash_functions;
+    static const size_t max_element_size;
+
+    /// A cleared filter, which matches everything.
+    bloom_filter();
+
+    /// A filter as loaded by a peer, which must be checked for validity.
+    bloom_filter(const filter_load& load);
+
+    /// An empty filter sized for elements at the false positive rate.
+    bloom_filter(size_t elements, double false_positive_rate, uint32_t tweak,
+        uint8_t flags);
+
+    const data_chunk& filter() const;
+    uint32_t hash_functions() const;
+    uint32_t tweak() const;
+    uint8_t flags() const;
+
+    /// True if the filter is within the bip37 size limits.
+    bool is_valid() const;
+
+    /// Replace the filter from a filter_load message.
+    void load(const filter_load& load);
+
+    /// Insert filter_add data, false if the data exceeds the element size.
+    bool add(const filter_add& add);
+
+    /// Clear the filter, as directed by a filter_clear message.
+    void clear();
+
+    void insert(data_slice element);
+    void insert(const chain::point& point);
+    bool contains(data_slice element) const;
+    bool contains(const chain::point& point) const;
+
+    /// Test the transaction, updating the filter with matched output points.
+    bool match(const chain::transaction& tx);
+
+    filter_load to_filter_load() const;
+
+private:
+    uint32_t bit_index(uint32_t function, data_slice element) const;
+    void update_state();
+
+    data_chunk filter_;
+    uint32_t hash_functions_;
+    uint32_t tweak_;
+    uint8_t flags_;
+    bool full_;
+    bool empty_;
+};
+
+} // end message
+} // end libbitcoin
+
+#endif
@@ -22,7 +22,9 @@
 
 #include <istream>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/message/prefilled_transaction.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -40,6 +42,9 @@ public:
     typedef mini_hash short_id;
     typedef mini_hash_list short_id_list;
 
+    /// The bip152 siphash key, derived from the header and nonce.
+    typedef struct { uint64_t k0; uint64_t k1; } short_id_key;
+
     static compact_block factory_from_data(uint32_t version,
         const data_chunk& data);
     static compact_block factory_from_data(uint32_t version,
@@ -47,6 +52,10 @@ public:
     static compact_block factory_from_data(uint32_t version,
         reader& source);
 
+    /// The bip152 short id (low 6 bytes of the keyed siphash) of a txid.
+    static short_id to_short_id(const short_id_key& key,
+        const hash_digest& hash);
+
     compact_block();
     compact_block(const chain::header& header, uint64_t nonce,
         const short_id_list& short_ids,
@@ -54,6 +63,10 @@ public:
     compact_block(chain::header&& header, uint64_t nonce,
         short_id_list&& short_ids,
         prefilled_transaction::list&& transactions);
+
+    /// Encode the block, prefilling only the coinbase transaction.
+    compact_block(const chain::block& block, uint64_t nonce);
+
     compact_block(const compact_block& other);
     compact_block(compact_block&& other);
 
@@ -85,6 +98,9 @@ public:
     void reset();
     uint64_t serialized_size(uint32_t version) const;
 
+    /// The siphash key of this block, sha256(header || nonce).
+    short_id_key to_short_id_key() const;
+
     // This class is move assignable but not copy assignable.
     compact_block& operator=(compact_block&& other);
     void operator=(const compact_block&) = delete;
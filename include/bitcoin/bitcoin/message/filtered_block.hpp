@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_FILTERED_BLOCK_HPP
+#define LIBBITCOIN_MESSAGE_FILTERED_BLOCK_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/merkle_tree.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
+#include <bitcoin/bitcoin/message/merkle_block.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// This class is thread safe, the filters are not.
+/// A block prepared once for matching against the bip37 filters of any number
+/// of peers. The merkle tree is built and the scripts of the block are parsed
+/// on construction and shared by all matches, so that each match is reduced
+/// to bloom_filter::match of each transaction. The block must outlive this.
+class BC_API filtered_block
+{
+public:
+    typedef chain::block::indexes indexes;
+
+    filtered_block(const chain::block& block);
+
+    /// This class is not copyable.
+    filtered_block(const filtered_block&) = delete;
+    void operator=(const filtered_block&) = delete;
+
+    const chain::block& block() const;
+
+    /// Match the block against the filter, updating the filter as directed by
+    /// its flags. Matched transaction positions are set in block order.
+    merkle_block match(bloom_filter& filter, indexes& matches) const;
+
+    /// Match the block against each filter, with the filters divided among
+    /// the specified number of threads (including the calling thread).
+    void match(merkle_block::list& out, std::vector<indexes>& matches,
+        const bloom_filter::ptr_list& filters, size_t threads=1) const;
+
+private:
+    static hash_list to_hashes(const chain::block& block);
+
+    const chain::block& block_;
+    const chain::merkle_tree tree_;
+};
+
+} // end message
+} // end libbitcoin
+
+#endif
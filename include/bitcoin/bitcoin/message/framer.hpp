@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_FRAMER_HPP
+#define LIBBITCOIN_MESSAGE_FRAMER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+class bitcoin_hash_buffer;
+
+namespace message {
+
+/// This class is not thread safe.
+/// Incremental decoder of the wire protocol message stream. Data is written
+/// in chunks of any size (as received from a socket or ring buffer). The
+/// heading is validated against magic and payload size limits as soon as it
+/// is complete, the payload checksum is computed as payload bytes arrive, and
+/// each verified payload is passed to the handler in place. A payload that
+/// is wholly contained in a written chunk is not copied at all.
+class BC_API framer
+{
+public:
+    /// Invoked once for each complete message with a valid checksum. The
+    /// payload is valid only for the duration of the call, parse it with
+    /// message::deserialize. Return false to reject the stream.
+    typedef std::function<bool(const heading&, const data_slice)> handler;
+
+    framer(uint32_t magic, uint32_t version, handler handle);
+    ~framer();
+
+    /// This class is not copyable.
+    framer(const framer&) = delete;
+    void operator=(const framer&) = delete;
+
+    /// Consume a chunk of the stream, invoking the handler for each message
+    /// completed by it. Returns error::bad_stream for invalid magic, excess
+    /// payload size, checksum mismatch or handler rejection, after which the
+    /// framer consumes nothing further until reset.
+    code write(const data_slice data);
+
+    /// The number of bytes required to complete the current heading or
+    /// payload, which may be used to size the next socket read.
+    size_t pending() const;
+
+    /// Discard any partial message and clear a stream failure.
+    void reset();
+
+    /// The negotiated protocol version used to limit payload size.
+    uint32_t version() const;
+    void set_version(uint32_t value);
+
+private:
+    code read_heading(const uint8_t*& it, const uint8_t* end);
+    code read_payload(const uint8_t*& it, const uint8_t* end);
+    code complete(const data_slice payload, uint32_t checksum);
+    code fail();
+
+    const uint32_t magic_;
+    uint32_t version_;
+    handler handle_;
+    bool failed_;
+    bool reading_payload_;
+    heading heading_;
+    data_chunk heading_data_;
+    size_t heading_fill_;
+    data_chunk payload_;
+    size_t payload_fill_;
+    std::unique_ptr<bitcoin_hash_buffer> hasher_;
+};
+
+} // end message
+} // end libbitcoin
+
+#endif
@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_MESSAGE_HEADERS_HPP
 #define LIBBITCOIN_MESSAGE_HEADERS_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
@@ -27,6 +28,7 @@
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
@@ -63,6 +65,13 @@ public:
     void to_inventory(inventory_vector::list& out,
         inventory::type_id type) const;
 
+    /// Check the proof of work and timestamp of each header and its linkage
+    /// to the preceding header, with headers hashed in parallel lanes and
+    /// checks divided among the specified number of threads (including the
+    /// calling thread). Index is set to the first failing header, or to the
+    /// number of headers on success.
+    code check(size_t& index, size_t threads=1) const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -25,6 +25,7 @@
 #include <string>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/merkle_tree.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
@@ -49,6 +50,11 @@ public:
     merkle_block(const chain::header& header, const hash_list& hashes,
         const data_chunk& flags);
     merkle_block(chain::header&& header, hash_list&& hashes, data_chunk&& flags);
+
+    /// The partial tree of the matched leaf positions of the block's tree.
+    merkle_block(const chain::header& header, const chain::merkle_tree& tree,
+        const chain::merkle_tree::indexes& positions);
+
     merkle_block(const merkle_block& other);
     merkle_block(merkle_block&& other);
 
@@ -67,6 +73,11 @@ public:
     void set_flags(const data_chunk& value);
     void set_flags(data_chunk&& value);
 
+    /// Verify the partial tree against the header (merkle root and count),
+    /// setting the matched transaction hashes and their block positions.
+    bool extract(hash_list& matches,
+        chain::merkle_tree::indexes& positions) const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -91,9 +102,6 @@ public:
 private:
     chain::header header_;
     hash_list hashes_;
-
-    // TODO: provide utility to compute this from the list of hashes based on
-    // the assumption that the hash list represents that of a complete block.
     data_chunk flags_;
 };
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_PARTIAL_BLOCK_HPP
+#define LIBBITCOIN_MESSAGE_PARTIAL_BLOCK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
+#include <bitcoin/bitcoin/message/transaction_message.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// This class is not thread safe.
+/// A bip152 compact block under reconstruction. Transactions are resolved by
+/// short id from a candidate pool, misses are requested by get_block_transactions
+/// and filled from the block_transactions reply. If the reconstructed block
+/// does not match its merkle root (an undetected short id collision) the full
+/// block must be requested instead.
+class BC_API partial_block
+{
+public:
+    typedef std::shared_ptr<const chain::transaction> transaction_ptr;
+
+    /// Decodes the differential prefill indexes and short ids of the block.
+    partial_block(const compact_block& block);
+
+    /// This class is not copyable.
+    partial_block(const partial_block&) = delete;
+    void operator=(const partial_block&) = delete;
+
+    /// False if the compact block is malformed or has duplicate short ids,
+    /// in which case it cannot be reconstructed and must not be filled.
+    bool is_valid() const;
+
+    /// True if all transactions are resolved.
+    bool is_complete() const;
+
+    /// The number of unresolved transactions.
+    size_t missing() const;
+
+    /// Resolve missing transactions by short id from the candidate pool,
+    /// returning the number resolved. A position matched by two distinct
+    /// candidates is left unresolved, so that it is requested.
+    size_t fill(const transaction_message::const_ptr_list& pool);
+
+    /// Resolve all missing transactions from the reply to request(), false
+    /// if the reply is for another block or its size does not match.
+    bool fill(const block_transactions& reply);
+
+    /// The request for all missing transactions, differentially encoded.
+    get_block_transactions request() const;
+
+    /// Populate the block, false if incomplete or the merkle root of the
+    /// resolved transactions does not match the header.
+    bool to_block(chain::block& out) const;
+
+private:
+    static uint64_t to_number(const compact_block::short_id& id);
+
+    bool populate(const compact_block& block);
+
+    bool valid_;
+    size_t missing_;
+    chain::header header_;
+    hash_digest hash_;
+    compact_block::short_id_key key_;
+    std::vector<transaction_ptr> transactions_;
+
+    // Unresolved (or pool resolved) positions by short id.
+    std::unordered_map<uint64_t, size_t> positions_;
+};
+
+} // end message
+} // end libbitcoin
+
+#endif
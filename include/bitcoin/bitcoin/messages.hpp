@@ -32,6 +32,7 @@
 #include <bitcoin/bitcoin/message/filter_add.hpp>
 #include <bitcoin/bitcoin/message/filter_clear.hpp>
 #include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/message/framer.hpp>
 #include <bitcoin/bitcoin/message/get_address.hpp>
 #include <bitcoin/bitcoin/message/get_block_transactions.hpp>
 #include <bitcoin/bitcoin/message/get_blocks.hpp>
@@ -54,6 +55,7 @@
 #include <bitcoin/bitcoin/message/verack.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 // Minimum conditional protocol version: 31800
 
@@ -123,6 +125,16 @@ data_chunk serialize(uint32_t version, const Message& packet,
     return message;
 }
 
+/**
+* Deserialize a message object from a framed payload, in place.
+*/
+template <typename Message>
+bool deserialize(Message& packet, uint32_t version, const data_slice payload)
+{
+    slice_reader source(payload);
+    return packet.from_data(version, source);
+}
+
 } // namespace message
 } // namespace libbitcoin
 
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_HPP
+#define LIBBITCOIN_PARALLEL_HPP
+
+#include <cstddef>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Invoke handler(begin, end) over contiguous ranges that partition
+ * [0, count), one range for each thread of the pool and one for the calling
+ * thread. Ranges are of (nearly) equal size and the handler is not invoked
+ * when count is zero. This blocks until all ranges are handled, so it must
+ * not be called from a thread of the pool. An exception thrown by the handler
+ * is rethrown to the caller once all ranges have completed.
+ * @param[in]  pool     The pool of threads on which to handle ranges.
+ * @param[in]  count    The number of elements to partition.
+ * @param[in]  handler  The range handler, invoked concurrently.
+ */
+template <typename Handler>
+void parallel_for(threadpool& pool, size_t count, Handler handler);
+
+/**
+ * Invoke handler(begin, end) over at most the specified number of ranges,
+ * using a pool of threads that exists for the duration of the call. The
+ * calling thread handles one of the ranges, so one thread (or zero) implies
+ * that the handler is invoked once on the calling thread.
+ * @param[in]  threads  The maximum number of concurrent ranges.
+ * @param[in]  count    The number of elements to partition.
+ * @param[in]  handler  The range handler, invoked concurrently.
+ */
+template <typename Handler>
+void parallel_for(size_t threads, size_t count, Handler handler);
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/parallel.ipp>
+
+#endif
@@ -21,6 +21,7 @@
 #define LIBBITCOIN_ENCRYPTED_KEYS_HPP
 
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
@@ -68,6 +69,7 @@ typedef byte_array<encrypted_token_decoded_size> encrypted_token;
 static BC_CONSTEXPR size_t ek_private_encoded_size = 58;
 static BC_CONSTEXPR size_t ek_private_decoded_size = 43;
 typedef byte_array<ek_private_decoded_size> encrypted_private;
+typedef std::vector<encrypted_private> encrypted_private_list;
 
 /**
  * DEPRECATED
@@ -165,6 +167,23 @@ BC_API bool create_key_pair(encrypted_private& out_private,
 BC_API bool encrypt(encrypted_private& out_private, const ec_secret& secret,
     const std::string& passphrase, uint8_t version, bool compressed=true);
 
+/**
+ * Encrypt each ec secret to an encrypted private key using the passphrase.
+ * The secrets are divided among the threads, each of which reuses its scrypt
+ * working space (of 16MB) across its keys.
+ * @param[out] out_privates  The new encrypted private keys, in secret order.
+ * @param[in]  secrets       The ec secrets to encrypt.
+ * @param[in]  passphrase    A passphrase for use in the encryption.
+ * @param[in]  version       The coin address version byte.
+ * @param[in]  compressed    Set true to associate ec public key compression.
+ * @param[in]  threads       The number of threads to use.
+ * @return false if any secret could not be converted to a public key, in
+ * which case its encrypted private key is all zeros.
+ */
+BC_API bool encrypt(encrypted_private_list& out_privates,
+    const secret_list& secrets, const std::string& passphrase,
+    uint8_t version, bool compressed=true, size_t threads=1);
+
 /**
  * Decrypt the ec secret associated with the encrypted private key.
  * @param[out] out_secret      The decrypted ec secret.
@@ -178,6 +197,23 @@ BC_API bool decrypt(ec_secret& out_secret, uint8_t& out_version,
     bool& out_compressed, const encrypted_private& key,
     const std::string& passphrase);
 
+/**
+ * Decrypt the ec secrets associated with the encrypted private keys.
+ * The keys are divided among the threads, each of which reuses its scrypt
+ * working space (of 16MB) across its keys.
+ * @param[out] out_secrets     The decrypted ec secrets, in key order.
+ * @param[out] out_versions    The coin address version of each key.
+ * @param[out] out_compressed  The compression of each ec public key.
+ * @param[in]  keys            The encrypted private keys.
+ * @param[in]  passphrase      The passphrase from the encryption or token.
+ * @param[in]  threads         The number of threads to use.
+ * @return false if any key checksum or the passphrase is not valid for any
+ * key, in which case its secret is null.
+ */
+BC_API bool decrypt(secret_list& out_secrets, data_chunk& out_versions,
+    std::vector<bool>& out_compressed, const encrypted_private_list& keys,
+    const std::string& passphrase, size_t threads=1);
+
 /**
  * DEPRECATED
  * Decrypt the ec point associated with the encrypted public key.
@@ -20,12 +20,17 @@
 #ifndef LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
 
 namespace libbitcoin {
 namespace wallet {
@@ -59,6 +64,8 @@ class hd_private;
 class BC_API hd_public
 {
 public:
+    typedef std::vector<hd_public> list;
+
     static const uint32_t mainnet;
 
     static inline uint32_t to_prefix(uint64_t prefixes)
@@ -99,6 +106,34 @@ public:
     hd_key to_hd_key() const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Range derivation, for address lookahead windows.
+    /// Derive the non-hardened children [first, first + count) in order. The
+    /// parent's hmac key schedule and point are prepared once and the range
+    /// is divided once among the threads of the pool and the calling thread,
+    /// which must not be a thread of the pool. The result is empty if the
+    /// range is not fully non-hardened. A child that cannot be derived
+    /// (vanishingly unlikely) is left invalid.
+    list derive_public_range(uint32_t first, size_t count,
+        threadpool& pool) const;
+
+    /// As above, emitting the hash160 of each child point (null if invalid).
+    short_hash_list derive_hash_range(uint32_t first, size_t count,
+        threadpool& pool) const;
+
+    /// As above, emitting the p2kh address of each child (invalid if invalid).
+    payment_address::list derive_address_range(uint32_t first, size_t count,
+        uint8_t version, threadpool& pool) const;
+
+    /// As above, on the specified number of threads (including the calling
+    /// thread), which exist for the duration of the call.
+    list derive_public_range(uint32_t first, size_t count,
+        size_t threads=1) const;
+    short_hash_list derive_hash_range(uint32_t first, size_t count,
+        size_t threads=1) const;
+    payment_address::list derive_address_range(uint32_t first, size_t count,
+        uint8_t version=payment_address::mainnet_p2kh,
+        size_t threads=1) const;
+
 protected:
     /// Factories.
     static hd_public from_secret(const ec_secret& secret,
@@ -106,6 +141,9 @@ protected:
 
     /// Helpers.
     uint32_t fingerprint() const;
+    bool derive_points(point_list& out, std::vector<hd_chain_code>* chains,
+        short_hash_list* hashes, uint32_t first, size_t count,
+        threadpool& pool) const;
 
     /// Members.
     /// These should be const, apart from the need to implement assignment.
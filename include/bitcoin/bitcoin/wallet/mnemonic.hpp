@@ -49,6 +49,11 @@ static BC_CONSTEXPR size_t mnemonic_seed_multiple = 4;
  */
 typedef string_list word_list;
 
+/**
+ * Represents a list of mnemonic word lists.
+ */
+typedef std::vector<word_list> word_lists;
+
 /**
  * Create a new mnenomic (list of words) from provided entropy and a dictionary
  * selection. The mnemonic can later be converted to a seed for use in wallet
@@ -76,6 +81,13 @@ BC_API bool validate_mnemonic(const word_list& mnemonic,
  */
 BC_API long_hash decode_mnemonic(const word_list& mnemonic);
 
+/**
+ * Convert each mnemonic with no passphrase to a wallet-generation seed.
+ * The seeds are derived in parallel, divided among the threads.
+ */
+BC_API long_hash_list decode_mnemonics(const word_lists& mnemonics,
+    size_t threads=1);
+
 #ifdef WITH_ICU
 
 /**
@@ -85,6 +97,14 @@ BC_API long_hash decode_mnemonic(const word_list& mnemonic);
 BC_API long_hash decode_mnemonic(const word_list& mnemonic,
     const std::string& passphrase);
 
+/**
+ * Convert a mnemonic with each of the passphrases to a wallet-generation
+ * seed, such as to recover a forgotten passphrase. The seeds are derived in
+ * parallel, divided among the threads.
+ */
+BC_API long_hash_list decode_mnemonics(const word_list& mnemonic,
+    const string_list& passphrases, size_t threads=1);
+
 #endif
 
 } // namespace wallet
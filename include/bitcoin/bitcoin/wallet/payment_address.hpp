@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/chain/script/script.hpp>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -43,6 +44,8 @@ typedef byte_array<payment_size> payment;
 class BC_API payment_address
 {
 public:
+    typedef std::vector<payment_address> list;
+
     static const uint8_t mainnet_p2kh;
     static const uint8_t mainnet_p2sh;
 
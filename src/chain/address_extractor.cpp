@@ -0,0 +1,326 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/address_extractor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/history.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/script/opcode.hpp>
+#include <bitcoin/bitcoin/chain/script/operation.hpp>
+#include <bitcoin/bitcoin/chain/script/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+static constexpr uint8_t direct_push_maximum = 75;
+
+static BC_CONSTFUNC uint8_t to_byte(opcode code)
+{
+    return static_cast<uint8_t>(code);
+}
+
+// op_1 through op_16 as a number, or zero.
+static size_t to_count(uint8_t byte)
+{
+    const auto first = to_byte(opcode::op_1);
+    const auto last = to_byte(opcode::op_16);
+    return byte >= first && byte <= last ? byte - first + 1 : 0;
+}
+
+// Read the push at position, setting its data. Returns false for any other
+// opcode or a truncated push. Push opcodes with no data set empty data.
+static bool read_push(data_slice& out, const data_chunk& script,
+    size_t& position)
+{
+    const auto size = script.size();
+    const auto byte = script[position++];
+    size_t prefix = 0;
+    size_t length = 0;
+
+    if (byte <= direct_push_maximum)
+        length = byte;
+    else if (byte == to_byte(opcode::pushdata1))
+        prefix = 1;
+    else if (byte == to_byte(opcode::pushdata2))
+        prefix = 2;
+    else if (byte == to_byte(opcode::pushdata4))
+        prefix = 4;
+    else if (byte != to_byte(opcode::negative_1) && to_count(byte) == 0)
+        return false;
+
+    if (prefix > size - position)
+        return false;
+
+    for (size_t index = 0; index < prefix; ++index)
+        length |= static_cast<size_t>(script[position++]) << (8 * index);
+
+    if (length > size - position)
+        return false;
+
+    const auto data = script.data() + position;
+    out = data_slice(data, data + length);
+    position += length;
+    return true;
+}
+
+script_pattern address_extractor::classify(payloads& out, data_slice script)
+{
+    out.clear();
+    const auto size = script.size();
+    const auto data = script.data();
+
+    // dup hash160 [20 bytes] equalverify checksig
+    if (size == 25 &&
+        data[0] == to_byte(opcode::dup) &&
+        data[1] == to_byte(opcode::hash160) &&
+        data[2] == short_hash_size &&
+        data[23] == to_byte(opcode::equalverify) &&
+        data[24] == to_byte(opcode::checksig))
+    {
+        out.emplace_back(data + 3, data + 23);
+        return script_pattern::pay_key_hash;
+    }
+
+    // hash160 [20 bytes] equal
+    if (size == 23 &&
+        data[0] == to_byte(opcode::hash160) &&
+        data[1] == short_hash_size &&
+        data[22] == to_byte(opcode::equal))
+    {
+        out.emplace_back(data + 2, data + 22);
+        return script_pattern::pay_script_hash;
+    }
+
+    if (size < 2)
+        return script_pattern::non_standard;
+
+    // return [0-80 bytes], as a direct push or pushdata1.
+    if (data[0] == to_byte(opcode::return_))
+    {
+        size_t length = data[1];
+        size_t begin = 2;
+
+        if (length == to_byte(opcode::pushdata1) && size > 2)
+            length = data[begin++];
+        else if (length > direct_push_maximum)
+            return script_pattern::non_standard;
+
+        return length <= operation::max_null_data_size &&
+            size == begin + length ? script_pattern::null_data :
+                script_pattern::non_standard;
+    }
+
+    // [public key] checksig
+    if (data[size - 1] == to_byte(opcode::checksig))
+    {
+        const data_slice key(data + 1, data + size - 1);
+        if (data[0] != key.size() || !is_public_key(key))
+            return script_pattern::non_standard;
+
+        out.push_back(key);
+        return script_pattern::pay_public_key;
+    }
+
+    // m [public key]... n checkmultisig
+    if (data[size - 1] == to_byte(opcode::checkmultisig) && size > 3)
+    {
+        const auto m = to_count(data[0]);
+        const auto n = to_count(data[size - 2]);
+        if (m == 0 || n < m)
+            return script_pattern::non_standard;
+
+        size_t position = 1;
+        while (position < size - 2)
+        {
+            const size_t length = data[position++];
+            if (length > size - 2 - position)
+                break;
+
+            const data_slice key(data + position, data + position + length);
+            if (!is_public_key(key))
+                break;
+
+            out.push_back(key);
+            position += length;
+        }
+
+        if (position == size - 2 && out.size() == n)
+            return script_pattern::pay_multisig;
+    }
+
+    out.clear();
+    return script_pattern::non_standard;
+}
+
+address_extractor::address_extractor()
+{
+}
+
+void address_extractor::extract(address_row::list& out, const block& block,
+    uint32_t height)
+{
+    for (const auto& tx: block.transactions())
+    {
+        const auto hash = tx.hash();
+        const auto& outputs = tx.outputs();
+
+        for (uint32_t index = 0; index < outputs.size(); ++index)
+        {
+            const auto& output = outputs[index];
+            const auto first = out.size();
+            extract_output(out, serialized(output.script()));
+
+            for (auto row = first; row < out.size(); ++row)
+            {
+                out[row].kind = point_kind::output;
+                out[row].point = point{ hash, index };
+                out[row].height = height;
+                out[row].value = output.value();
+            }
+        }
+
+        if (tx.is_coinbase())
+            continue;
+
+        const auto& inputs = tx.inputs();
+
+        for (uint32_t index = 0; index < inputs.size(); ++index)
+        {
+            const auto& input = inputs[index];
+            const auto first = out.size();
+            extract_input(out, serialized(input.script()));
+
+            for (auto row = first; row < out.size(); ++row)
+            {
+                out[row].kind = point_kind::spend;
+                out[row].point = point{ hash, index };
+                out[row].height = height;
+                out[row].previous_checksum =
+                    input.previous_output().checksum();
+            }
+        }
+    }
+
+    hash_preimages(out);
+}
+
+// Scripts that were read retain their serialization, others are serialized.
+const data_chunk& address_extractor::serialized(const script& script)
+{
+    const auto& retained = script.retained_data();
+    if (!retained.empty() || script.operations().empty())
+        return retained;
+
+    script_ = script.to_data(false);
+    return script_;
+}
+
+void address_extractor::extract_output(address_row::list& out,
+    const data_chunk& script)
+{
+    switch (classify(payloads_, script))
+    {
+        case script_pattern::pay_key_hash:
+        case script_pattern::pay_script_hash:
+            add_hash(out, payloads_.front());
+            break;
+        case script_pattern::pay_public_key:
+        case script_pattern::pay_multisig:
+            for (const auto key: payloads_)
+                add_preimage(out, key);
+            break;
+        default:
+            break;
+    }
+}
+
+// An input spends a key hash with [signature] [public key], and a script hash
+// with [pushes]... [redeem script], where the redeem script is standard.
+void address_extractor::extract_input(address_row::list& out,
+    const data_chunk& script)
+{
+    pushes_.clear();
+
+    for (size_t position = 0; position < script.size();)
+    {
+        data_slice push(script.data(), script.data());
+        if (!read_push(push, script, position))
+            return;
+
+        pushes_.push_back(push);
+    }
+
+    if (pushes_.size() < 2)
+        return;
+
+    const auto& last = pushes_.back();
+
+    if (pushes_.size() == 2 && is_public_key(last))
+        add_preimage(out, last);
+    else if (!last.empty() &&
+        classify(payloads_, last) != script_pattern::non_standard)
+        add_preimage(out, last);
+}
+
+void address_extractor::add_hash(address_row::list& out, data_slice hash)
+{
+    out.emplace_back();
+    std::copy(hash.begin(), hash.end(), out.back().hash.begin());
+}
+
+// The hash is set once all preimages of the block are collected.
+void address_extractor::add_preimage(address_row::list& out,
+    data_slice preimage)
+{
+    preimage_rows_.push_back(out.size());
+    preimage_offsets_.push_back(preimages_.size());
+    preimages_.insert(preimages_.end(), preimage.begin(), preimage.end());
+    out.emplace_back();
+}
+
+void address_extractor::hash_preimages(address_row::list& out)
+{
+    const auto count = preimage_rows_.size();
+    const auto data = preimages_.data();
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto begin = preimage_offsets_[index];
+        const auto end = index + 1 < count ? preimage_offsets_[index + 1] :
+            preimages_.size();
+
+        out[preimage_rows_[index]].hash =
+            bitcoin_short_hash(data_slice(data + begin, data + end));
+    }
+
+    preimages_.clear();
+    preimage_rows_.clear();
+    preimage_offsets_.clear();
+}
+
+} // namespace chain
+} // namespace libbitcoin
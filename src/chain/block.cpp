@@ -20,14 +20,18 @@
 #include <bitcoin/bitcoin/chain/block.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <limits>
 #include <cfenv>
 #include <cmath>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/script/opcode.hpp>
@@ -42,9 +46,11 @@
 #include <bitcoin/bitcoin/math/script_number.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -140,51 +146,30 @@ chain::block block::genesis_testnet()
     return genesis;
 }
 
+// The hash list is consumed.
 hash_digest block::build_merkle_tree(hash_list& merkle)
 {
-    // Stop if hash list is empty.
     if (merkle.empty())
         return null_hash;
 
-    // While there is more than 1 hash in the list, keep looping...
+    hash_list update;
+
+    // Initial capacity is half of the original list (resize doesn't shrink).
+    update.reserve((merkle.size() + 1) / 2);
+
     while (merkle.size() > 1)
     {
         // If number of hashes is odd, duplicate last hash in the list.
         if (merkle.size() % 2 != 0)
             merkle.push_back(merkle.back());
 
-        // List size is now even.
-        BITCOIN_ASSERT(merkle.size() % 2 == 0);
-
-        // New hash list.
-        hash_list new_merkle;
-
-        // Loop through hashes 2 at a time.
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-        {
-            // Join both current hashes together (concatenate).
-            data_chunk concat_data;
-            data_sink concat_stream(concat_data);
-            ostream_writer concat_sink(concat_stream);
-            concat_sink.write_hash(*it);
-            concat_sink.write_hash(*(it + 1));
-            concat_stream.flush();
-
-            BITCOIN_ASSERT(concat_data.size() == (2 * hash_size));
-
-            // Hash both of the hashes.
-            const auto new_root = bitcoin_hash(concat_data);
-
-            // Add this to the new list.
-            new_merkle.push_back(new_root);
-        }
-
-        // This is the new list.
-        merkle = new_merkle;
+        // Hash each pair of the level, in parallel lanes where supported.
+        bitcoin_hash_pairs(update, merkle);
+        std::swap(merkle, update);
     }
 
-    // Finally we end up with a single item.
-    return merkle[0];
+    // There is now only one item in the list.
+    return merkle.front();
 }
 
 size_t block::locator_size(size_t top)
@@ -239,6 +224,29 @@ hash_number block::difficulty(uint32_t bits)
     return (~target / (target + 1)) + 1;
 }
 
+hash_number block::difficulty(const header::list& headers)
+{
+    hash_number work;
+
+    // The target changes only at retarget (or testnet minimum) heights, so
+    // the work of each run of equal bits is computed once and multiplied.
+    for (auto header = headers.begin(); header != headers.end();)
+    {
+        const auto bits = header->bits();
+        const auto start = header;
+
+        while (header != headers.end() && header->bits() == bits &&
+            static_cast<size_t>(header - start) < max_uint32)
+            ++header;
+
+        auto run = difficulty(bits);
+        run *= static_cast<uint32_t>(header - start);
+        work += run;
+    }
+
+    return work;
+}
+
 uint64_t block::subsidy(size_t height)
 {
     auto subsidy = bitcoin_to_satoshi(initial_block_reward);
@@ -256,6 +264,13 @@ inline hash_list to_hashes(const transaction::list& transactions)
     return out;
 }
 
+// The hashes are copied for sorting.
+inline bool is_distinct(hash_list hashes)
+{
+    std::sort(hashes.begin(), hashes.end());
+    return std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end();
+}
+
 block::block()
   : header_(), transactions_()
 {
@@ -355,8 +370,8 @@ void block::reset()
 
 bool block::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool block::from_data(std::istream& stream)
@@ -411,28 +426,21 @@ void block::to_data(writer& sink) const
     std::for_each(transactions_.begin(), transactions_.end(), to);
 }
 
-// TODO: provide optimization option to balance total sigops across buckets.
-// Disperse the inputs of the block evenly to the specified number of buckets.
+// Disperse the inputs of the block to the specified number of buckets,
+// balancing the estimated verification cost (sigops) of each bucket.
 transaction::sets_const_ptr block::to_input_sets(size_t fanout,
     bool with_coinbase_transaction) const
 {
-    const auto total = total_inputs(with_coinbase_transaction);
-    const auto buckets = transaction::reserve_buckets(total, fanout);
+    transaction::set elements;
+    elements.reserve(total_inputs(with_coinbase_transaction));
+    const auto& txs = transactions_;
+    const auto start = with_coinbase_transaction || txs.empty() ? 0 : 1;
 
-    // Guard against division by zero.
-    if (!buckets->empty())
-    {
-        size_t count = 0;
-        const auto& txs = transactions_;
-        const auto start = with_coinbase_transaction ? 0 : 1;
-
-        // Populate each bucket with full (or full-1) input references.
-        for (auto tx = txs.begin() + start; tx != txs.end(); ++tx)
-            for (size_t index = 0; index < tx->inputs().size(); ++index)
-                (*buckets)[count++ % fanout].push_back({ *tx, index });
-    }
+    for (auto tx = txs.begin() + start; tx != txs.end(); ++tx)
+        for (size_t index = 0; index < tx->inputs().size(); ++index)
+            elements.push_back({ *tx, index });
 
-    return std::const_pointer_cast<const transaction::sets>(buckets);
+    return transaction::balance_buckets(elements, fanout);
 }
 
 // Convenience property.
@@ -523,42 +531,13 @@ bool block::is_final(size_t height) const
 // Distinctness is defined by transaction hash.
 bool block::is_distinct_transaction_set() const
 {
-    const auto hasher = [](const transaction& tx) { return tx.hash(); };
-    const auto& txs = transactions_;
-    hash_list hashes(txs.size());
-    std::transform(txs.begin(), txs.end(), hashes.begin(), hasher);
-    std::sort(hashes.begin(), hashes.end());
-    const auto distinct_end = std::unique(hashes.begin(), hashes.end());
-    return distinct_end == hashes.end();
+    return is_distinct(to_hashes(transactions_));
 }
 
 hash_digest block::generate_merkle_root() const
 {
     auto merkle = to_hashes(transactions_);
-
-    if (merkle.empty())
-        return null_hash;
-
-    hash_list update;
-
-    // Initial capacity is half of the original list (clear doesn't reset).
-    update.reserve((merkle.size() + 1) / 2);
-
-    while (merkle.size() > 1)
-    {
-        // If number of hashes is odd, duplicate last hash in the list.
-        if (merkle.size() % 2 != 0)
-            merkle.push_back(merkle.back());
-
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-            update.push_back(bitcoin_hash(build_chunk({ it[0], it[1] })));
-
-        std::swap(merkle, update);
-        update.clear();
-    }
-
-    // There is now only one item in the list.
-    return merkle.front();
+    return build_merkle_tree(merkle);
 }
 
 bool block::is_valid_merkle_root() const
@@ -650,7 +629,99 @@ code block::connect_transactions(const chain_state& state) const
     return error::success;
 }
 
+// Connect the inputs of the block concurrently on the threadpool, with input
+// sets balanced by estimated cost. The result is that of the serial connect,
+// the code of the first failing input in block order. Each set is connected
+// in order and stops at any input following a known failure. This blocks
+// until complete and so must not be called from a thread of the pool.
+code block::connect_transactions(const chain_state& state,
+    threadpool& pool) const
+{
+    if (pool.empty() || transactions_.empty())
+        return connect_transactions(state);
+
+    // The ordinal of the first input of each transaction, in block order.
+    std::vector<size_t> offsets;
+    offsets.reserve(transactions_.size());
+    size_t inputs = 0;
+
+    for (const auto& tx: transactions_)
+    {
+        offsets.push_back(inputs);
+        inputs += tx.inputs().size();
+    }
+
+    // The coinbase is included, as it is in serial connect (no-op).
+    const auto sets = to_input_sets(pool.size(), true);
+    const auto buckets = sets->size();
+
+    if (buckets == 0)
+        return error::success;
+
+    const auto& first = transactions_.front();
+    std::atomic<size_t> failure(max_size_t);
+    std::vector<size_t> failures(buckets, max_size_t);
+    std::vector<code> results(buckets, error::success);
+
+    unique_mutex mutex;
+    boost::condition_variable completed;
+    auto remaining = buckets;
+
+    const auto connect = [&](size_t bucket)
+    {
+        for (const auto& element: (*sets)[bucket])
+        {
+            const auto position = static_cast<size_t>(&element.tx - &first);
+            const auto ordinal = offsets[position] + element.input_index;
+
+            // This and all subsequent inputs of the set follow a failure.
+            if (ordinal > failure.load())
+                break;
+
+            const auto ec = element.tx.connect_input(state,
+                element.input_index);
+
+            if (ec)
+            {
+                results[bucket] = ec;
+                failures[bucket] = ordinal;
+                auto current = failure.load();
+
+                while (ordinal < current &&
+                    !failure.compare_exchange_weak(current, ordinal));
+
+                break;
+            }
+        }
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        boost::lock_guard<unique_mutex> lock(mutex);
+
+        if (--remaining == 0)
+            completed.notify_one();
+        ///////////////////////////////////////////////////////////////////////
+    };
+
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+        pool.service().post(std::bind(connect, bucket));
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    boost::unique_lock<unique_mutex> lock(mutex);
+
+    while (remaining != 0)
+        completed.wait(lock);
+    ///////////////////////////////////////////////////////////////////////////
+
+    const auto earliest = std::min_element(failures.begin(), failures.end());
+    return results[std::distance(failures.begin(), earliest)];
+}
+
 // These checks are self-contained; blockchain (and so version) independent.
+// The transactions are walked once, the results are then tested in the order
+// of the individual checks (is_extra_coinbases, etc.), so precedence holds.
+// Transactions are not checked once a block error is certain to precede.
 code block::check() const
 {
     code ec;
@@ -658,33 +729,61 @@ code block::check() const
     if ((ec = header_.check()))
         return ec;
 
-    else if (serialized_size() > max_block_size)
-        return error::size_limits;
+    const auto& txs = transactions_;
+    auto size = header_.serialized_size(true);
+    auto extra_coinbases = false;
+    size_t sigops = 0;
+    code transactions_ec(error::success);
+    hash_list hashes;
+    hashes.reserve(txs.size());
+
+    for (auto tx = txs.begin(); tx != txs.end(); ++tx)
+    {
+        // Overflow saturates, which exceeds the limit. The size only grows
+        // and its error precedes all others, so it is reported immediately.
+        size = ceiling_add(size, tx->serialized_size());
+        if (size > max_block_size)
+            return error::size_limits;
+
+        extra_coinbases |= (tx != txs.begin() && tx->is_coinbase());
+        hashes.push_back(tx->hash());
+
+        // We cannot know if bip16 is enabled at this point so we disable it.
+        // This will not make a difference unless prevouts are populated, in
+        // which case they are ignored. This means that p2sh sigops are not
+        // counted here. This is a preliminary check, the final count must
+        // come from connect().
+        sigops = ceiling_add(sigops, tx->signature_operations(false));
+
+        const auto block_failed = !txs.front().is_coinbase() ||
+            extra_coinbases || sigops > max_block_sigops;
+
+        // Only the first failure is reported, so stop checking on failure.
+        if (!block_failed && !transactions_ec)
+            transactions_ec = tx->check(false);
+    }
 
-    else if (transactions_.empty())
+    if (txs.empty())
         return error::empty_block;
 
-    else if (!transactions_.front().is_coinbase())
+    else if (!txs.front().is_coinbase())
         return error::first_not_coinbase;
 
-    else if (is_extra_coinbases())
+    else if (extra_coinbases)
         return error::extra_coinbases;
 
-    else if (!is_distinct_transaction_set())
+    else if (!is_distinct(hashes))
         return error::duplicate;
 
-    // We cannot know if bip16 is enabled at this point so we disable it.
-    // This will not make a difference unless prevouts are populated, in which
-    // case they are ignored. This means that p2sh sigops are not counted here.
-    // This is a preliminary check, the final count must come from connect().
-    else if (signature_operations(false) > max_block_sigops)
+    else if (sigops > max_block_sigops)
         return error::too_many_sigs;
 
-    else if (!is_valid_merkle_root())
+    // This consumes the hash list.
+    else if (build_merkle_tree(hashes) != header_.merkle())
         return error::merkle_mismatch;
 
     else
-        return check_transactions();
+        return transactions_ec;
 }
 
 code block::accept() const
@@ -694,9 +793,11 @@ code block::accept() const
 }
 
 // Deprecated (?)
-// TODO: implement sigops and total input/output value caching.
 // These checks assume that prevout caching is completed on all tx.inputs.
 // Flags should be based on connecting at the specified blockchain height.
+// The transactions are walked once, the results are then tested in the order
+// of the individual checks (is_final, etc.), so precedence holds.
+// Transactions are not accepted once a block error is certain to precede.
 code block::accept(const chain_state& state) const
 {
     code ec;
@@ -706,22 +807,44 @@ code block::accept(const chain_state& state) const
     if ((ec = header_.accept(state)))
         return ec;
 
-    // This recurses txs but is not applied to mempool (timestamp required).
-    else if (!is_final(state.height()))
-        return error::non_final_transaction;
+    const auto height = state.height();
+    const auto timestamp = header_.timestamp();
+    const auto coinbase_mismatch = bip34 &&
+        !is_valid_coinbase_script(height);
+    size_t sigops = 0;
+    uint64_t fees = 0;
+    code transactions_ec(error::success);
+
+    for (const auto& tx: transactions_)
+    {
+        // This is not applied to mempool (timestamp required).
+        // Finality precedes all other checks, so it is reported immediately.
+        if (!tx.is_final(height, timestamp))
+            return error::non_final_transaction;
+
+        // This recomputes sigops to include p2sh from prevouts.
+        sigops = ceiling_add(sigops, tx.signature_operations(bip16));
+        fees = ceiling_add(fees, tx.fees());
+
+        const auto block_failed = coinbase_mismatch ||
+            sigops > max_block_sigops;
+
+        // Only the first failure is reported, so stop accepting on failure.
+        if (!block_failed && !transactions_ec)
+            transactions_ec = tx.accept(state, false);
+    }
 
-    else if (bip34 && !is_valid_coinbase_script(state.height()))
+    if (coinbase_mismatch)
         return error::coinbase_height_mismatch;
 
-    // This recomputes sigops to include p2sh from prevouts.
-    else if (signature_operations(bip16) > max_block_sigops)
+    else if (sigops > max_block_sigops)
         return error::too_many_sigs;
 
-    else if (!is_valid_coinbase_claim(state.height()))
+    else if (claim() > ceiling_add(fees, subsidy(height)))
         return error::coinbase_too_large;
 
     else
-        return accept_transactions(state);
+        return transactions_ec;
 }
 
 code block::connect() const
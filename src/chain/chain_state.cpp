@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/chain/script/opcode.hpp>
@@ -111,21 +112,68 @@ uint32_t chain_state::retarget_timespan(const chain_state::data& values)
     return range_constrain(timespan, min_timespan, max_timespan);
 }
 
+// Compute version summaries in a single pass.
+chain_state::version_counts chain_state::count_versions(
+    const versions& history)
+{
+    version_counts counts{ 0, 0, 0 };
+
+    for (const auto version: history)
+    {
+        counts.count_4 += (version >= bip65_version ? 1 : 0);
+        counts.count_3 += (version >= bip66_version ? 1 : 0);
+        counts.count_2 += (version >= bip34_version ? 1 : 0);
+    }
+
+    return counts;
+}
+
+// The history is the parent history with one version appended and the lowest
+// heights removed, so only the difference is counted.
+chain_state::version_counts chain_state::promote_counts(
+    const version_counts& parent, const versions& parent_history,
+    const versions& history)
+{
+    BITCOIN_ASSERT(!history.empty());
+    BITCOIN_ASSERT(history.size() <= parent_history.size() + 1);
+
+    auto counts = parent;
+    const auto removed = parent_history.size() + 1 - history.size();
+
+    const auto add = [&counts](uint32_t version)
+    {
+        counts.count_4 += (version >= bip65_version ? 1 : 0);
+        counts.count_3 += (version >= bip66_version ? 1 : 0);
+        counts.count_2 += (version >= bip34_version ? 1 : 0);
+    };
+
+    const auto subtract = [&counts](uint32_t version)
+    {
+        counts.count_4 -= (version >= bip65_version ? 1 : 0);
+        counts.count_3 -= (version >= bip66_version ? 1 : 0);
+        counts.count_2 -= (version >= bip34_version ? 1 : 0);
+    };
+
+    for (size_t index = 0; index < removed; ++index)
+        subtract(parent_history[index]);
+
+    add(history.back());
+    return counts;
+}
+
 chain_state::activations chain_state::activation(const data& values)
+{
+    return activation(values, count_versions(values.version.unordered));
+}
+
+chain_state::activations chain_state::activation(const data& values,
+    const version_counts& counts)
 {
     const auto height = values.height;
     const auto testnet = values.testnet;
-    const auto& history = values.version.unordered;
-
-    // Declare version predicates.
-    const auto ge_4 = [](uint32_t version) { return version >= bip65_version; };
-    const auto ge_3 = [](uint32_t version) { return version >= bip66_version; };
-    const auto ge_2 = [](uint32_t version) { return version >= bip34_version; };
-
-    // Compute version summaries.
-    const auto count_4 = std::count_if(history.begin(), history.end(), ge_4);
-    const auto count_3 = std::count_if(history.begin(), history.end(), ge_3);
-    const auto count_2 = std::count_if(history.begin(), history.end(), ge_2);
+    const auto count_4 = counts.count_4;
+    const auto count_3 = counts.count_3;
+    const auto count_2 = counts.count_2;
 
     // Initialize activation results with genesis values.
     activations result{ rule_fork::no_rules, first_version };
@@ -164,13 +212,43 @@ chain_state::activations chain_state::activation(const data& values)
     return result;
 }
 
-uint32_t chain_state::median_time_past(const data& values)
+chain_state::timestamps chain_state::sort_timestamps(
+    const timestamps& ordered)
 {
     // Create a copy for the in-place sort.
-    auto times = values.timestamp.ordered;
+    auto times = ordered;
 
     // Sort the times by value to obtain the median.
     std::sort(times.begin(), times.end());
+    return times;
+}
+
+// The window is the parent window with one time appended and the lowest
+// heights removed, so the sorted parent window is updated in place.
+chain_state::timestamps chain_state::promote_sorted(
+    const timestamps& parent_sorted, const timestamps& parent_ordered,
+    const timestamps& ordered)
+{
+    BITCOIN_ASSERT(!ordered.empty());
+    BITCOIN_ASSERT(ordered.size() <= parent_ordered.size() + 1);
+
+    auto times = parent_sorted;
+    const auto removed = parent_ordered.size() + 1 - ordered.size();
+
+    for (size_t index = 0; index < removed; ++index)
+    {
+        const auto time = parent_ordered[index];
+        times.erase(std::lower_bound(times.begin(), times.end(), time));
+    }
+
+    const auto time = ordered.back();
+    times.insert(std::upper_bound(times.begin(), times.end(), time), time);
+    return times;
+}
+
+uint32_t chain_state::median_time_past(const data& values)
+{
+    const auto times = sort_timestamps(values.timestamp.ordered);
 
     // Consensus defines median time using modulo 2 element selection.
     // This differs from arithmetic median which averages two middle values.
@@ -302,13 +380,76 @@ chain_state::map chain_state::get_map(size_t height, bool enabled,
     return map;
 }
 
-// Constructor.
+// Copy the parent sample less its lowest heights beyond the sample size and
+// append the value, copying each retained value once.
+static std::vector<uint32_t> slide(const std::vector<uint32_t>& parent,
+    uint32_t value, size_t size)
+{
+    BITCOIN_ASSERT(size != 0);
+    const auto retained = std::min(parent.size(), size - 1);
+
+    std::vector<uint32_t> values;
+    values.reserve(retained + 1);
+    values.insert(values.end(), parent.end() - retained, parent.end());
+    values.push_back(value);
+    return values;
+}
+
+// Samples are those of the height map, as for full construction, so the
+// version sample is reduced to the top version when not enabled.
+chain_state::data chain_state::to_promoted(const data& parent, bool enabled,
+    const header& top, uint32_t timestamp_self, uint32_t timestamp_retarget)
+{
+    const auto height = parent.height + 1;
+    const auto testnet = parent.testnet;
+    const auto map = get_map(height, enabled, testnet);
+
+    data values;
+    values.testnet = testnet;
+    values.enabled = enabled;
+    values.height = height;
+
+    values.bits.ordered = slide(parent.bits.ordered, top.bits(),
+        map.bits.high - map.bits.low + 1);
+    values.version.unordered = slide(parent.version.unordered, top.version(),
+        map.version.high - map.version.low + 1);
+    values.timestamp.ordered = slide(parent.timestamp.ordered,
+        top.timestamp(), map.timestamp.high - map.timestamp.low + 1);
+
+    values.timestamp.self = testnet ? timestamp_self : top.timestamp();
+    values.timestamp.retarget = is_retarget_height(height) ?
+        timestamp_retarget : top.timestamp();
+
+    return values;
+}
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
 chain_state::chain_state(data&& values, const checkpoints& checkpoints)
   : data_(std::move(values)),
-    checkpoints_(checkpoints),
-    active_(activation(data_)),
+    version_counts_(count_versions(data_.version.unordered)),
+    sorted_timestamps_(sort_timestamps(data_.timestamp.ordered)),
+    active_(activation(data_, version_counts_)),
+    median_time_past_(sorted_timestamps_.empty() ? 0 :
+        sorted_timestamps_[sorted_timestamps_.size() / 2]),
+    work_required_(work_required(data_)),
+    checkpoints_(checkpoints)
+{
+}
+
+chain_state::chain_state(const chain_state& parent, const header& top,
+    uint32_t timestamp_self, uint32_t timestamp_retarget)
+  : data_(to_promoted(parent.data_, parent.is_enabled(), top, timestamp_self,
+        timestamp_retarget)),
+    version_counts_(promote_counts(parent.version_counts_,
+        parent.data_.version.unordered, data_.version.unordered)),
+    sorted_timestamps_(promote_sorted(parent.sorted_timestamps_,
+        parent.data_.timestamp.ordered, data_.timestamp.ordered)),
+    active_(activation(data_, version_counts_)),
+    median_time_past_(sorted_timestamps_[sorted_timestamps_.size() / 2]),
     work_required_(work_required(data_)),
-    median_time_past_(median_time_past(data_))
+    checkpoints_(parent.checkpoints_)
 {
 }
 
@@ -19,6 +19,7 @@
  */
 #include <bitcoin/bitcoin/chain/header.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <utility>
 #include <boost/iostreams/stream.hpp>
@@ -27,13 +28,32 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash_number.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include "../math/bitcoin_hash_buffer.hpp"
 
 namespace libbitcoin {
 namespace chain {
 
+// States of the cached header hash.
+enum hash_state : uint8_t
+{
+    hash_empty,
+    hash_pending,
+    hash_published
+};
+
+static hash_number to_target(uint32_t bits)
+{
+    hash_number target;
+    target.set_compact(bits);
+    return target;
+}
+
+// The proof of work limit, as a target.
+static const hash_number maximum_target = to_target(max_work_bits);
+
 header header::factory_from_data(const data_chunk& data,
     bool with_transaction_count)
 {
@@ -73,7 +93,7 @@ header::header(uint32_t version, const hash_digest& previous_block_hash,
     uint32_t nonce, uint64_t transaction_count)
   : version_(version), previous_block_hash_(previous_block_hash),
     merkle_(merkle), timestamp_(timestamp), bits_(bits), nonce_(nonce),
-    transaction_count_(transaction_count), hash_(nullptr)
+    transaction_count_(transaction_count), hash_state_(hash_empty)
 {
 }
 
@@ -82,7 +102,8 @@ header::header(uint32_t version, hash_digest&& previous_block_hash,
     uint64_t transaction_count)
   : version_(version), previous_block_hash_(std::move(previous_block_hash)),
     merkle_(std::move(merkle)), timestamp_(timestamp), bits_(bits),
-    nonce_(nonce), transaction_count_(transaction_count), hash_(nullptr)
+    nonce_(nonce), transaction_count_(transaction_count),
+    hash_state_(hash_empty)
 {
 }
 
@@ -119,16 +140,14 @@ void header::reset()
     nonce_ = 0;
     transaction_count_ = 0;
 
-    mutex_.lock();
-    hash_.reset();
-    mutex_.unlock();
+    invalidate_hash();
 }
 
 bool header::from_data(const data_chunk& data,
     bool with_transaction_count)
 {
-    data_source istream(data);
-    return from_data(istream, with_transaction_count);
+    slice_reader source(data);
+    return from_data(source, with_transaction_count);
 }
 
 bool header::from_data(std::istream& stream, bool with_transaction_count)
@@ -206,10 +225,13 @@ uint32_t header::version() const
 void header::set_version(uint32_t value)
 {
     version_ = value;
+    invalidate_hash();
 }
 
+// The hash is invalidated as the previous block hash may be modified.
 hash_digest& header::previous_block_hash()
 {
+    invalidate_hash();
     return previous_block_hash_;
 }
 
@@ -221,15 +243,19 @@ const hash_digest& header::previous_block_hash() const
 void header::set_previous_block_hash(const hash_digest& value)
 {
     previous_block_hash_ = value;
+    invalidate_hash();
 }
 
 void header::set_previous_block_hash(hash_digest&& value)
 {
     previous_block_hash_ = std::move(value);
+    invalidate_hash();
 }
 
+// The hash is invalidated as the merkle root may be modified.
 hash_digest& header::merkle()
 {
+    invalidate_hash();
     return merkle_;
 }
 
@@ -241,11 +267,13 @@ const hash_digest& header::merkle() const
 void header::set_merkle(const hash_digest& value)
 {
     merkle_ = value;
+    invalidate_hash();
 }
 
 void header::set_merkle(hash_digest&& value)
 {
     merkle_ = std::move(value);
+    invalidate_hash();
 }
 
 uint32_t header::timestamp() const
@@ -256,6 +284,7 @@ uint32_t header::timestamp() const
 void header::set_timestamp(uint32_t value)
 {
     timestamp_ = value;
+    invalidate_hash();
 }
 
 uint32_t header::bits() const
@@ -266,6 +295,7 @@ uint32_t header::bits() const
 void header::set_bits(uint32_t value)
 {
     bits_ = value;
+    invalidate_hash();
 }
 
 uint32_t header::nonce() const
@@ -276,6 +306,7 @@ uint32_t header::nonce() const
 void header::set_nonce(uint32_t value)
 {
     nonce_ = value;
+    invalidate_hash();
 }
 
 uint64_t header::transaction_count() const
@@ -288,28 +319,36 @@ void header::set_transaction_count(uint64_t value)
     transaction_count_ = value;
 }
 
+// The hash is computed by streaming the serialization through the hasher.
+// Concurrent first readers may each compute it, but only one publishes it.
 hash_digest header::hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
+    if (hash_state_.load(std::memory_order_acquire) == hash_published)
+        return hash_;
+
+    bitcoin_hash_buffer buffer;
+    std::ostream stream(&buffer);
+    to_data(stream, false);
+    const auto hash = buffer.digest();
 
-    if (!hash_)
+    uint8_t expected = hash_empty;
+
+    if (hash_state_.compare_exchange_strong(expected, hash_pending,
+        std::memory_order_acquire))
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-        hash_.reset(new hash_digest(bitcoin_hash(to_data(false))));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
+        hash_ = hash;
+        hash_state_.store(hash_published, std::memory_order_release);
     }
 
-    const auto hash = *hash_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
     return hash;
 }
 
+// Mutation is not thread safe, so there is no concurrent publication here.
+void header::invalidate_hash() const
+{
+    hash_state_.store(hash_empty, std::memory_order_release);
+}
+
 bool header::is_valid_time_stamp() const
 {
     // Use system clock because we require accurate time of day.
@@ -322,17 +361,16 @@ bool header::is_valid_time_stamp() const
 
 bool header::is_valid_proof_of_work() const
 {
-    // TODO: This should be statically-initialized.
-    hash_number maximum;
-    if (!maximum.set_compact(max_work_bits))
-        return false;
+    return is_valid_proof_of_work(hash());
+}
 
+bool header::is_valid_proof_of_work(const hash_digest& hash) const
+{
     hash_number target;
-    if (!target.set_compact(bits_) || target > maximum)
+    if (!target.set_compact(bits_) || target > maximum_target)
         return false;
 
-    hash_number value(hash());
-    return value <= target;
+    return target.is_met_by(hash);
 }
 
 code header::check() const
@@ -374,6 +412,7 @@ header& header::operator=(header&& other)
     bits_ = other.bits_;
     nonce_ = other.nonce_;
     transaction_count_ = other.transaction_count_;
+    invalidate_hash();
     return *this;
 }
 
@@ -387,6 +426,7 @@ header& header::operator=(const header& other)
     bits_ = other.bits_;
     nonce_ = other.nonce_;
     transaction_count_ = other.transaction_count_;
+    invalidate_hash();
     return *this;
 }
 
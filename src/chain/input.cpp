@@ -23,9 +23,9 @@
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -96,8 +96,8 @@ void input::reset()
 
 bool input::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool input::from_data(std::istream& stream)
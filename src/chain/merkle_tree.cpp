@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/merkle_tree.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+// A block cannot contain more transactions than this (minimum size 60).
+static constexpr size_t max_leaves = max_block_size / 60;
+
+// The number of nodes at the height (zero at the leaves).
+static size_t width(size_t leaves, size_t height)
+{
+    return (leaves + (size_t(1) << height) - 1) >> height;
+}
+
+static size_t tree_height(size_t leaves)
+{
+    size_t height = 0;
+
+    while (width(leaves, height) > 1)
+        ++height;
+
+    return height;
+}
+
+static hash_digest hash_pair(const hash_digest& left,
+    const hash_digest& right)
+{
+    return bitcoin_hash(build_chunk({ left, right }));
+}
+
+// Decoding state, shared over the traversal.
+struct extraction
+{
+    const size_t leaves;
+    const hash_list& hashes;
+    const data_chunk& flags;
+    hash_list& matches;
+    merkle_tree::indexes& positions;
+    size_t bits_used;
+    size_t hashes_used;
+    bool bad;
+};
+
+static hash_digest traverse_extract(extraction& state, size_t height,
+    size_t position)
+{
+    if (state.bits_used >= state.flags.size() * 8)
+    {
+        state.bad = true;
+        return null_hash;
+    }
+
+    const auto bit = state.bits_used++;
+    const auto parent = ((state.flags[bit / 8] >> (bit % 8)) & 1) != 0;
+
+    if (height == 0 || !parent)
+    {
+        if (state.hashes_used >= state.hashes.size())
+        {
+            state.bad = true;
+            return null_hash;
+        }
+
+        const auto& hash = state.hashes[state.hashes_used++];
+
+        if (height == 0 && parent)
+        {
+            state.matches.push_back(hash);
+            state.positions.push_back(position);
+        }
+
+        return hash;
+    }
+
+    const auto left = traverse_extract(state, height - 1, position * 2);
+
+    if (position * 2 + 1 >= width(state.leaves, height - 1))
+        return hash_pair(left, left);
+
+    const auto right = traverse_extract(state, height - 1, position * 2 + 1);
+
+    // An identical right branch would allow a second tree of the same root.
+    if (right == left)
+        state.bad = true;
+
+    return hash_pair(left, right);
+}
+
+hash_digest merkle_tree::extract(hash_list& matches, indexes& positions,
+    size_t leaves, const hash_list& hashes, const data_chunk& flags)
+{
+    matches.clear();
+    positions.clear();
+
+    if (leaves == 0 || leaves > max_leaves || hashes.size() > leaves ||
+        flags.size() * 8 < hashes.size())
+        return null_hash;
+
+    extraction state{ leaves, hashes, flags, matches, positions, 0, 0, false };
+    const auto root = traverse_extract(state, tree_height(leaves), 0);
+
+    // All hashes and all but the padding bits of the flags must be consumed.
+    if (state.bad || state.hashes_used != hashes.size() ||
+        (state.bits_used + 7) / 8 != flags.size())
+    {
+        matches.clear();
+        positions.clear();
+        return null_hash;
+    }
+
+    return root;
+}
+
+merkle_tree::merkle_tree(const hash_list& leaves)
+  : levels_{ leaves }
+{
+    build();
+}
+
+merkle_tree::merkle_tree(hash_list&& leaves)
+  : levels_{}
+{
+    levels_.push_back(std::move(leaves));
+    build();
+}
+
+// Each level is hashed once, in parallel lanes where supported.
+void merkle_tree::build()
+{
+    if (levels_.front().empty())
+        return;
+
+    while (levels_.back().size() > 1)
+    {
+        hash_list next;
+        auto& level = levels_.back();
+        const auto odd = (level.size() % 2) != 0;
+
+        // If number of hashes is odd, duplicate last hash for the pairing.
+        if (odd)
+            level.push_back(level.back());
+
+        bitcoin_hash_pairs(next, level);
+
+        if (odd)
+            level.pop_back();
+
+        levels_.push_back(std::move(next));
+    }
+}
+
+hash_digest merkle_tree::root() const
+{
+    return levels_.back().empty() ? null_hash : levels_.back().front();
+}
+
+size_t merkle_tree::size() const
+{
+    return levels_.front().size();
+}
+
+const hash_list& merkle_tree::leaves() const
+{
+    return levels_.front();
+}
+
+void merkle_tree::partial(hash_list& hashes, data_chunk& flags,
+    const indexes& positions) const
+{
+    BITCOIN_ASSERT(std::is_sorted(positions.begin(), positions.end()));
+    hashes.clear();
+    flags.clear();
+
+    if (size() == 0)
+        return;
+
+    std::vector<bool> bits;
+    traverse(hashes, bits, positions, levels_.size() - 1, 0);
+    flags.resize((bits.size() + 7) / 8, 0x00);
+
+    for (size_t bit = 0; bit < bits.size(); ++bit)
+        flags[bit / 8] |= (bits[bit] ? 1 : 0) << (bit % 8);
+}
+
+// Depth first, each node is flagged if it is the parent of a match. The hash
+// of the node is emitted if it is a leaf or not a parent of a match (bip37).
+void merkle_tree::traverse(hash_list& hashes, std::vector<bool>& bits,
+    const indexes& positions, size_t height, size_t position) const
+{
+    const auto begin = position << height;
+    const auto end = (position + 1) << height;
+    const auto match = std::lower_bound(positions.begin(), positions.end(),
+        begin);
+    const auto parent = match != positions.end() && *match < end;
+
+    bits.push_back(parent);
+
+    if (height == 0 || !parent)
+    {
+        hashes.push_back(levels_[height][position]);
+        return;
+    }
+
+    const auto left = position * 2;
+    traverse(hashes, bits, positions, height - 1, left);
+
+    if (left + 1 < levels_[height - 1].size())
+        traverse(hashes, bits, positions, height - 1, left + 1);
+}
+
+} // namespace chain
+} // namespace libbitcoin
@@ -24,9 +24,9 @@
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -93,8 +93,8 @@ void output::reset()
 
 bool output::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool output::from_data(std::istream& stream)
@@ -26,10 +26,10 @@
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/formats/base_16.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -107,8 +107,8 @@ void point::reset()
 
 bool point::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool point::from_data(std::istream& stream)
@@ -19,6 +19,7 @@
  */
 #include "evaluation_context.hpp"
 
+#include <utility>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
@@ -36,7 +37,7 @@ evaluation_context::evaluation_context(uint32_t flags, const data_stack& stack)
 
 data_chunk evaluation_context::pop_stack()
 {
-    const auto value = stack.back();
+    auto value = std::move(stack.back());
     stack.pop_back();
     return value;
 }
@@ -26,9 +26,9 @@
 #include <bitcoin/bitcoin/formats/base_16.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -124,8 +124,8 @@ void operation::reset()
 
 bool operation::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool operation::from_data(std::istream& stream)
@@ -321,7 +321,9 @@ bool operation::is_null_data_pattern(const operation::stack& ops)
 {
     return ops.size() == 2
         && ops[0].code() == opcode::return_
-        && ops[1].code() == opcode::special
+        && (ops[1].code() == opcode::zero
+            || ops[1].code() == opcode::special
+            || ops[1].code() == opcode::pushdata1)
         && ops[1].data().size() <= max_null_data_size;
 }
 
@@ -341,7 +343,7 @@ bool operation::is_pay_multisig_pattern(const operation::stack& ops)
     if (op_m < op_1 || op_m > op_n || op_n < op_1 || op_n > op_16)
         return false;
 
-    const auto n = op_n - op_1;
+    const auto n = op_n - op_1 + 1u;
     const auto points = op_count - 3u;
 
     if (n != points)
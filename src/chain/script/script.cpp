@@ -19,10 +19,12 @@
  */
 #include <bitcoin/bitcoin/chain/script/script.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <sstream>
+#include <thread>
 #include <boost/algorithm/string.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
@@ -33,12 +35,14 @@
 #include <bitcoin/bitcoin/formats/base_16.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/math/script_number.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
 #include <bitcoin/bitcoin/utility/variable_uint_size.hpp>
 #include "conditional_stack.hpp"
@@ -59,6 +63,9 @@ static constexpr size_t max_data_script_size = 520;
 static constexpr size_t max_script_public_key_count = 20;
 static constexpr size_t multisig_default_signature_ops = 20;
 
+// Shared by all verifications, see verified_signatures.
+static signature_cache signature_verifications;
+
 // bit.ly/2cPazSa
 static const hash_digest one_hash
 {
@@ -75,6 +82,78 @@ enum class signature_parse_result
     lax_encoding
 };
 
+// States of the operations parsed from a retained serialized script.
+enum parse_state : uint8_t
+{
+    unparsed,
+    parsing,
+    parsed
+};
+
+// Visit the opcode of each operation of a serialized script without copying
+// its data. Returns false if a push is truncated, which is a parse failure.
+template <typename Visitor>
+static bool visit_operations(const data_chunk& raw_script, Visitor visitor)
+{
+    size_t position = 0;
+    const auto size = raw_script.size();
+
+    while (position < size)
+    {
+        const auto byte = raw_script[position++];
+        auto code = static_cast<opcode>(byte);
+        size_t prefix = 0;
+        size_t length = 0;
+
+        if (byte > 0 && byte <= 75)
+        {
+            code = opcode::special;
+            length = byte;
+        }
+        else if (code == opcode::pushdata1)
+            prefix = 1;
+        else if (code == opcode::pushdata2)
+            prefix = 2;
+        else if (code == opcode::pushdata4)
+            prefix = 4;
+
+        if (prefix > size - position)
+            return false;
+
+        for (size_t index = 0; index < prefix; ++index)
+            length |= static_cast<size_t>(raw_script[position++]) <<
+                (8 * index);
+
+        if (length > size - position)
+            return false;
+
+        position += length;
+        visitor(code);
+    }
+
+    return true;
+}
+
+// dup hash160 [20 bytes] equalverify checksig
+static bool is_pay_key_hash_script(const data_chunk& raw_script)
+{
+    return raw_script.size() == 25
+        && raw_script[0] == static_cast<uint8_t>(opcode::dup)
+        && raw_script[1] == static_cast<uint8_t>(opcode::hash160)
+        && raw_script[2] == short_hash_size
+        && raw_script[23] == static_cast<uint8_t>(opcode::equalverify)
+        && raw_script[24] == static_cast<uint8_t>(opcode::checksig);
+}
+
+// hash160 [20 bytes] equal
+static bool is_pay_script_hash_script(const data_chunk& raw_script)
+{
+    return raw_script.size() == 23
+        && raw_script[0] == static_cast<uint8_t>(opcode::hash160)
+        && raw_script[1] == short_hash_size
+        && raw_script[22] == static_cast<uint8_t>(opcode::equal);
+}
+
 script script::factory_from_data(const data_chunk& data, bool prefix,
     parse_mode mode)
 {
@@ -99,58 +178,80 @@ script script::factory_from_data(reader& source, bool prefix, parse_mode mode)
 }
 
 script::script()
-  : operations_(), is_raw_(false)
+  : bytes_(), has_bytes_(false), is_raw_(false), parse_state_(parsed),
+    operations_()
 {
 }
 
 script::script(const operation::stack& operations)
-  : operations_(operations), is_raw_(false)
+  : bytes_(), has_bytes_(false), is_raw_(false), parse_state_(parsed),
+    operations_(operations)
 {
 }
 
 script::script(operation::stack&& operations)
-  : operations_(std::move(operations)), is_raw_(false)
+  : bytes_(), has_bytes_(false), is_raw_(false), parse_state_(parsed),
+    operations_(std::move(operations))
 {
 }
 
+// Only the serialized form of a read script is copied, operations are parsed
+// again on demand.
 script::script(const script& other)
-  : operations_(other.operations_), is_raw_(other.is_raw_)
+  : bytes_(other.bytes_), has_bytes_(other.has_bytes_),
+    is_raw_(other.is_raw_),
+    parse_state_(other.has_bytes_ ? unparsed : parsed),
+    operations_(other.has_bytes_ ? operation::stack{} : other.operations_)
 {
 }
 
 script::script(script&& other)
-  : operations_(std::move(other.operations_)),
-    is_raw_(other.is_raw_)
+  : bytes_(std::move(other.bytes_)), has_bytes_(other.has_bytes_),
+    is_raw_(other.is_raw_),
+    parse_state_(other.parse_state_.load(std::memory_order_acquire)),
+    operations_(std::move(other.operations_))
 {
 }
 
 script_pattern script::pattern() const
 {
-    if (operation::is_null_data_pattern(operations_))
+    // The common output patterns are matched on the serialized form.
+    if (has_bytes_ && !is_raw_)
+    {
+        if (is_pay_key_hash_script(bytes_))
+            return script_pattern::pay_key_hash;
+
+        if (is_pay_script_hash_script(bytes_))
+            return script_pattern::pay_script_hash;
+    }
+
+    const auto& ops = operations();
+
+    if (operation::is_null_data_pattern(ops))
         return script_pattern::null_data;
 
-    if (operation::is_pay_multisig_pattern(operations_))
+    if (operation::is_pay_multisig_pattern(ops))
         return script_pattern::pay_multisig;
 
-    if (operation::is_pay_public_key_pattern(operations_))
+    if (operation::is_pay_public_key_pattern(ops))
         return script_pattern::pay_public_key;
 
-    if (operation::is_pay_key_hash_pattern(operations_))
+    if (operation::is_pay_key_hash_pattern(ops))
         return script_pattern::pay_key_hash;
 
-    if (operation::is_pay_script_hash_pattern(operations_))
+    if (operation::is_pay_script_hash_pattern(ops))
         return script_pattern::pay_script_hash;
 
-    if (operation::is_sign_multisig_pattern(operations_))
+    if (operation::is_sign_multisig_pattern(ops))
         return script_pattern::sign_multisig;
 
-    if (operation::is_sign_public_key_pattern(operations_))
+    if (operation::is_sign_public_key_pattern(ops))
         return script_pattern::sign_public_key;
 
-    if (operation::is_sign_key_hash_pattern(operations_))
+    if (operation::is_sign_key_hash_pattern(ops))
         return script_pattern::sign_key_hash;
 
-    if (operation::is_sign_script_hash_pattern(operations_))
+    if (operation::is_sign_script_hash_pattern(ops))
         return script_pattern::sign_script_hash;
 
     return script_pattern::non_standard;
@@ -158,35 +259,57 @@ script_pattern script::pattern() const
 
 bool script::is_raw_data() const
 {
+    // Raw data is read as a single operation.
+    if (has_bytes_)
+        return is_raw_;
+
     return (operations_.size() == 1) && is_raw_;
 }
 
+const data_chunk& script::retained_data() const
+{
+    return bytes_;
+}
+
 // BUGBUG: An empty script is valid.
 bool script::is_valid() const
 {
+    // Each serialized byte is at least part of one operation.
+    if (has_bytes_)
+        return is_raw_ || !bytes_.empty();
+
     return !operations_.empty();
 }
 
 void script::reset()
 {
+    clear_bytes();
     operations_.clear();
     operations_.shrink_to_fit();
     is_raw_ = false;
 }
 
+void script::clear_bytes()
+{
+    bytes_.clear();
+    bytes_.shrink_to_fit();
+    has_bytes_ = false;
+    parse_state_.store(parsed, std::memory_order_release);
+}
+
 bool script::from_data(const data_chunk& data, bool prefix, parse_mode mode)
 {
     auto result = true;
 
     if (prefix)
     {
-        data_source istream(data);
-        result = from_data(istream, true, mode);
+        slice_reader source(data);
+        result = from_data(source, true, mode);
     }
     else
     {
         reset();
-        result = deserialize(data, mode);
+        result = deserialize(data_chunk(data), mode);
 
         if (!result)
             reset();
@@ -227,7 +350,7 @@ bool script::from_data(reader& source, bool prefix, parse_mode mode)
     }
 
     if (result)
-        result = deserialize(raw_script, mode);
+        result = deserialize(std::move(raw_script), mode);
 
     if (!result)
         reset();
@@ -256,7 +379,10 @@ void script::to_data(writer& sink, bool prefix) const
     if (prefix)
         sink.write_variable_uint_little_endian(satoshi_content_size());
 
-    if (is_raw_data())
+    // A read script is written from its serialized form, without parsing.
+    if (has_bytes_)
+        sink.write_data(bytes_);
+    else if (is_raw_data())
         sink.write_data(operations_[0].data());
     else
         for (const auto& op: operations_)
@@ -265,6 +391,9 @@ void script::to_data(writer& sink, bool prefix) const
 
 uint64_t script::satoshi_content_size() const
 {
+    if (has_bytes_)
+        return bytes_.size();
+
     if (is_raw_data())
         return operations_[0].data().size();
 
@@ -290,7 +419,7 @@ uint64_t script::serialized_size(bool prefix) const
 bool script::from_string(const std::string& human_readable)
 {
     // clear current contents
-    operations_.clear();
+    reset();
     const auto tokens = split(human_readable);
     auto clear = false;
 
@@ -341,10 +470,11 @@ bool script::from_string(const std::string& human_readable)
 std::string script::to_string(uint32_t flags) const
 {
     std::ostringstream value;
+    const auto& ops = operations();
 
-    for (auto it = operations_.begin(); it != operations_.end(); ++it)
+    for (auto it = ops.begin(); it != ops.end(); ++it)
     {
-        if (it != operations_.begin())
+        if (it != ops.begin())
             value << " ";
 
         value << it->to_string(flags);
@@ -359,24 +489,36 @@ size_t script::sigops(bool serialized_script) const
     size_t total = 0;
     opcode last_opcode = opcode::bad_operation;
 
-    for (const auto& op: operations_)
+    const auto count = [&](opcode code)
     {
-        if (op.code() == opcode::checksig ||
-            op.code() == opcode::checksigverify)
+        if (code == opcode::checksig || code == opcode::checksigverify)
         {
             total++;
         }
         else if (
-            op.code() == opcode::checkmultisig ||
-            op.code() == opcode::checkmultisigverify)
+            code == opcode::checkmultisig ||
+            code == opcode::checkmultisigverify)
         {
             total += serialized_script && within_op_n(last_opcode) ?
                 decode_op_n(last_opcode) : multisig_default_signature_ops;
         }
 
-        last_opcode = op.code();
+        last_opcode = code;
+    };
+
+    // A read script is counted from its serialized form, without parsing.
+    // Raw data is a single operation with no signatures.
+    if (has_bytes_)
+    {
+        if (!is_raw_)
+            visit_operations(bytes_, count);
+
+        return total;
     }
 
+    for (const auto& op: operations_)
+        count(op.code());
+
     return total;
 }
 
@@ -387,72 +529,97 @@ size_t script::pay_script_hash_sigops(const script& prevout) const
     if (prevout.pattern() != script_pattern::pay_script_hash)
         return 0;
 
+    const auto& ops = operations();
+
     // Conditions added by EKV on 2016.09.15 for safety and BIP16 consistency.
     // Only push data operations allowed in script, so no signature increment.
-    if (operations_.empty() || !operation::is_push_only(operations_))
+    if (ops.empty() || !operation::is_push_only(ops))
         return 0;
 
     script eval;
 
     // We can be strict here and treat failure as zero signatures (data).
-    if (!eval.from_data(operations_.back().data(), false, parse_mode::strict))
+    if (!eval.from_data(ops.back().data(), false, parse_mode::strict))
         return 0;
 
     // Count the sigops in the serialized script using BIP16 rules.
     return eval.sigops(true);
 }
 
-bool script::deserialize(const data_chunk& raw_script, parse_mode mode)
+// The serialized form is validated without allocation and retained.
+bool script::deserialize(data_chunk&& raw_script, parse_mode mode)
 {
-    auto result = false;
+    const auto none = [](opcode) {};
+    const auto valid = (mode != parse_mode::raw_data) &&
+        visit_operations(raw_script, none);
 
-    if (mode != parse_mode::raw_data)
-        result = parse(raw_script);
+    if (!valid && (mode == parse_mode::strict))
+        return false;
 
-    if (!result && (mode != parse_mode::strict))
-    {
-        result = true;
+    bytes_ = std::move(raw_script);
+    has_bytes_ = true;
+    is_raw_ = !valid;
+    operations_.clear();
+    parse_state_.store(unparsed, std::memory_order_release);
+    return true;
+}
+
+// The operations of a validated serialized script, allocated once.
+static operation::stack to_operations(const data_chunk& bytes, bool raw)
+{
+    operation::stack operations;
 
+    if (raw)
+    {
         // opcode ignored thanks to is_raw_ in this script
-        const auto op = operation
-        {
-            opcode::raw_data,
-            to_chunk(raw_script)
-        };
+        operations.emplace_back(opcode::raw_data, bytes);
+        return operations;
+    }
 
-        operations_.clear();
-        operations_.push_back(std::move(op));
-        is_raw_ = true;
+    // Count the operations first, so that the stack is allocated once.
+    size_t count = 0;
+    visit_operations(bytes, [&count](opcode) { ++count; });
+    operations.reserve(count);
+    slice_reader source(bytes);
+
+    while (!source.is_exhausted())
+    {
+        operations.emplace_back();
+        operations.back().from_data(source);
     }
 
-    return result;
+    return operations;
 }
 
-bool script::parse(const data_chunk& raw_script)
+// Operations are parsed once, on first use, from the validated serialized
+// form. Readers that lose the race to parse wait for its publication. If the
+// parse throws the script is restored to unparsed, so that a reader may retry.
+void script::parse() const
 {
-    auto result = true;
+    auto state = parse_state_.load(std::memory_order_acquire);
 
-    if (raw_script.begin() != raw_script.end())
+    while (state != parsed)
     {
-        data_source istream(raw_script);
-
-        while (result && istream &&
-            (istream.peek() != std::istream::traits_type::eof()))
+        if (state == unparsed && parse_state_.compare_exchange_strong(state,
+            parsing, std::memory_order_acquire))
         {
-            operations_.emplace_back();
-            result = operations_.back().from_data(istream);
-        }
-    }
+            try
+            {
+                operations_ = to_operations(bytes_, is_raw_);
+            }
+            catch (...)
+            {
+                parse_state_.store(unparsed, std::memory_order_release);
+                throw;
+            }
 
-    return result;
-}
+            parse_state_.store(parsed, std::memory_order_release);
+            return;
+        }
 
-inline void zeroize_input_sequences(input::list& inputs,
-    uint32_t except_input)
-{
-    for (size_t in = 0; in < inputs.size(); ++in)
-        if (in != except_input)
-            inputs[in].set_sequence(0);
+        std::this_thread::yield();
+        state = parse_state_.load(std::memory_order_acquire);
+    }
 }
 
 inline uint8_t is_sighash_enum(uint8_t sighash_type,
@@ -461,12 +628,6 @@ inline uint8_t is_sighash_enum(uint8_t sighash_type,
     return (sighash_type & signature_hash_algorithm::mask) == value;
 }
 
-inline uint8_t is_sighash_flag(uint8_t sighash_type,
-    signature_hash_algorithm value)
-{
-    return (sighash_type & value) != 0;
-}
-
 ////inline hash_digest hash(const transaction& tx, uint8_t sighash_type)
 ////{
 ////    auto serialized = tx.to_data();
@@ -477,66 +638,26 @@ inline uint8_t is_sighash_flag(uint8_t sighash_type,
 hash_digest script::generate_signature_hash(const transaction& tx,
     uint32_t input_index, const script& script_code, uint8_t sighash_type)
 {
-    // Copy the parent transaction.
-    transaction parent(tx);
-
     // This is NOT considered an error result and callers should not test
     // for one_hash. This is a bitcoind behavior we necessarily perpetuate.
     if (input_index >= tx.inputs().size())
         return one_hash;
 
-    // FindAndDelete(OP_CODESEPARATOR) done in op_checksigverify(...)
-
-    // Blank all other inputs' signatures
-    for (auto& input: parent.inputs())
-        input.script().reset();
+    // This is NOT considered an error result and callers should not test
+    // for one_hash. This is a bitcoind behavior we necessarily perpetuate.
+    if (is_sighash_enum(sighash_type, signature_hash_algorithm::single) &&
+        input_index >= tx.outputs().size())
+        return one_hash;
 
-    parent.inputs()[input_index].set_script(script_code);
+    // FindAndDelete(OP_CODESEPARATOR) done in op_checksigverify(...)
 
     // The default sighash::all signs all outputs, and the current input.
-    // Transaction cannot be updated without resigning the input.
-    // (note the lack of zeroize_input_sequences() call)
-
-    if (is_sighash_enum(sighash_type, signature_hash_algorithm::none))
-    {
-        // Sign no outputs, so they can be changed.
-        parent.outputs().clear();
-        zeroize_input_sequences(parent.inputs(), input_index);
-    }
-    else if (is_sighash_enum(sighash_type, signature_hash_algorithm::single))
-    {
-
-        // Sign the single output corresponding to our index.
-        // We don't care about additional inputs or outputs to the tx.
-        auto& outputs = parent.outputs();
-        uint32_t output_index = input_index;
-
-        // This is NOT considered an error result and callers should not test
-        // for one_hash. This is a bitcoind behavior we necessarily perpetuate.
-        if (output_index >= outputs.size())
-            return one_hash;
-
-        outputs.resize(output_index + 1);
-
-        // Loop through outputs except the last one.
-        for (auto it = outputs.begin(); it != outputs.end() - 1; ++it)
-        {
-            it->set_value(std::numeric_limits<uint64_t>::max());
-            it->script().reset();
-        }
-
-        zeroize_input_sequences(parent.inputs(), input_index);
-    }
-
-    // Flag to ignore the other inputs except our own.
-    if (is_sighash_flag(sighash_type,
-        signature_hash_algorithm::anyone_can_pay))
-    {
-        parent.inputs()[0] = parent.inputs()[input_index];
-        parent.inputs().resize(1);
-    }
-
-    return parent.hash(sighash_type);
+    // Other input scripts are blanked, and under sighash::none and
+    // sighash::single the sequences of other inputs are zeroized. Under
+    // sighash::single only the output corresponding to our index is signed,
+    // and under anyone_can_pay only our own input is signed. The tx is
+    // streamed into the hash in these forms rather than copied and modified.
+    return tx.signature_hash(input_index, script_code, sighash_type);
 }
 
 inline bool cast_to_bool(const data_chunk& values)
@@ -570,7 +691,7 @@ void stack_swap(DataStack& stack, size_t index_a, size_t index_b)
 template <typename DataStack>
 data_chunk pop_item(DataStack& stack)
 {
-    const auto value = stack.back();
+    auto value = std::move(stack.back());
     stack.pop_back();
     return value;
 }
@@ -1312,8 +1433,22 @@ bool script::check_signature(const ec_signature& signature,
     const auto sighash = script::generate_signature_hash(tx, input_index,
         script_code, sighash_type);
 
+    auto& cache = verified_signatures();
+
+    if (cache.contains(public_key, sighash, signature))
+        return true;
+
     // Validate the EC signature.
-    return verify_signature(public_key, sighash, signature);
+    if (!verify_signature(public_key, sighash, signature))
+        return false;
+
+    cache.store(public_key, sighash, signature);
+    return true;
+}
+
+signature_cache& script::verified_signatures()
+{
+    return signature_verifications;
 }
 
 static signature_parse_result op_checksigverify(evaluation_context& context,
@@ -1970,6 +2105,96 @@ static bool evaluate(const transaction& tx, uint32_t input_index,
     return context.conditional.closed();
 }
 
+// Standard output scripts are evaluated directly against the stack left by
+// the input script, without per-operation dispatch or intermediate copies.
+// The result is that of evaluate, including the stack size limit.
+static bool evaluate_output(const transaction& tx, uint32_t input_index,
+    const script& prevout_script, evaluation_context& context, uint32_t flags)
+{
+    const auto strict = script::is_enabled(flags, rule_fork::bip66_rule);
+    const auto& ops = prevout_script.operations();
+    auto& stack = context.stack;
+    context.operation_counter = 0;
+    context.code_begin = ops.begin();
+
+    switch (prevout_script.pattern())
+    {
+        // [public key] checksig
+        case script_pattern::pay_public_key:
+        {
+            if (stack.size() + 1 > max_stack_size)
+                return false;
+
+            stack.push_back(ops[0].data());
+            return op_checksig(context, prevout_script, tx, input_index,
+                strict);
+        }
+
+        // dup hash160 [short hash] equalverify checksig
+        case script_pattern::pay_key_hash:
+        {
+            if (stack.empty() || stack.size() + 2 > max_stack_size)
+                return false;
+
+            const auto hash = bitcoin_short_hash(stack.back());
+            const auto& expected = ops[2].data();
+
+            if (!std::equal(hash.begin(), hash.end(), expected.begin()))
+                return false;
+
+            return op_checksig(context, prevout_script, tx, input_index,
+                strict);
+        }
+
+        // hash160 [short hash] equal
+        case script_pattern::pay_script_hash:
+        {
+            if (stack.empty() || stack.size() + 1 > max_stack_size)
+                return false;
+
+            const auto hash = bitcoin_short_hash(stack.back());
+            const auto& expected = ops[1].data();
+            stack.back() = std::equal(hash.begin(), hash.end(),
+                expected.begin()) ? stack_true_value : stack_false_value;
+            return true;
+        }
+
+        // [m] [public key]... [n] checkmultisig
+        case script_pattern::pay_multisig:
+        {
+            const auto is_push = [](const operation& op)
+            {
+                return opcode_is_empty_pusher(op.code());
+            };
+
+            const auto keys_begin = ops.begin() + 1;
+            const auto keys_end = ops.end() - 2;
+
+            // Programmatic scripts may carry key-sized data on other codes.
+            if (!std::all_of(keys_begin, keys_end, is_push))
+                break;
+
+            if (stack.size() + ops.size() - 1 > max_stack_size)
+                return false;
+
+            op_x(context, ops.front().code());
+
+            for (auto it = keys_begin; it != keys_end; ++it)
+                stack.push_back(it->data());
+
+            op_x(context, keys_end->code());
+            context.operation_counter = 1;
+            return op_checkmultisig(context, prevout_script, tx, input_index,
+                strict);
+        }
+
+        default:
+            break;
+    }
+
+    return evaluate(tx, input_index, prevout_script, context, flags);
+}
+
 // TODO: return detailed result code indicating failure condition.
 code script::verify(const transaction& tx, uint32_t input_index,
     uint32_t flags)
@@ -2004,7 +2229,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
     evaluation_context out_context(flags, in_context.stack);
 
     // Evaluate the output script.
-    if (!evaluate(tx, input_index, prevout_script, out_context, flags))
+    if (!evaluate_output(tx, input_index, prevout_script, out_context, flags))
         return error::validate_inputs_failed;
 
     // Return if stack is false.
@@ -2044,46 +2269,80 @@ code script::verify(const transaction& tx, uint32_t input_index,
     return error::success;
 }
 
+// The operations may be modified, so they become authoritative.
 operation::stack& script::operations()
 {
+    parse();
+    clear_bytes();
     return operations_;
 }
 
 const operation::stack& script::operations() const
 {
+    parse();
     return operations_;
 }
 
 void script::set_operations(const operation::stack& value)
 {
+    clear_bytes();
     operations_ = value;
 }
 
 void script::set_operations(operation::stack&& value)
 {
+    clear_bytes();
     operations_ = std::move(value);
 }
 
 script& script::operator=(script&& other)
 {
-    operations_ = std::move(other.operations_);
+    bytes_ = std::move(other.bytes_);
+    has_bytes_ = other.has_bytes_;
     is_raw_ = other.is_raw_;
+    operations_ = std::move(other.operations_);
+    parse_state_.store(other.parse_state_.load(std::memory_order_acquire),
+        std::memory_order_release);
     return *this;
 }
 
+// Only the serialized form of a read script is copied, operations are parsed
+// again on demand.
 script& script::operator=(const script& other)
 {
-    operations_ = other.operations_;
+    if (this == &other)
+        return *this;
+
+    bytes_ = other.bytes_;
+    has_bytes_ = other.has_bytes_;
     is_raw_ = other.is_raw_;
+
+    if (has_bytes_)
+    {
+        operations_.clear();
+        parse_state_.store(unparsed, std::memory_order_release);
+    }
+    else
+    {
+        operations_ = other.operations_;
+        parse_state_.store(parsed, std::memory_order_release);
+    }
+
     return *this;
 }
 
 bool script::operator==(const script& other) const
 {
-    bool result = (operations_.size() == other.operations_.size());
+    // Parsing is deterministic, so serialized forms may be compared directly.
+    if (has_bytes_ && other.has_bytes_ && (is_raw_ == other.is_raw_))
+        return bytes_ == other.bytes_;
+
+    const auto& left = operations();
+    const auto& right = other.operations();
+    bool result = (left.size() == right.size());
 
-    for (operation::stack::size_type i = 0; (i < operations_.size()) && result; ++i)
-        result = (operations_[i] == other.operations_[i]);
+    for (operation::stack::size_type i = 0; (i < left.size()) && result; ++i)
+        result = (left[i] == right[i]);
 
     return result;
 }
@@ -20,10 +20,13 @@
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <functional>
 #include <numeric>
+#include <queue>
 #include <type_traits>
 #include <sstream>
 #include <utility>
@@ -39,15 +42,116 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include "../math/bitcoin_hash_buffer.hpp"
+#include "../math/external/sha256.h"
 
 namespace libbitcoin {
 namespace chain {
 
 const size_t transaction::validation::unspecified_height = 0;
 
+// Inputs between signature hash midstates, bounds per-input rehashing.
+static constexpr size_t sighash_midstate_interval = 16;
+
+// States of the cached transaction hash.
+enum hash_state : uint8_t
+{
+    hash_empty,
+    hash_pending,
+    hash_published
+};
+
+// An aggregate is unset when it matches its sentinel. A computed value that
+// matches the sentinel (overflow) is valid but is recomputed on each call.
+static constexpr uint64_t unset_value = max_uint64;
+static constexpr size_t unset_sigops = max_size_t;
+
+// The serialized size of an input with an empty script (point, 0x00, seq).
+static constexpr size_t blank_input_size = 32 + 4 + 1 + 4;
+
+// The signature hash preimage state common to all inputs of the tx.
+// Midstates are sha256 contexts over the sighash::all preimage prefix, taken
+// before every interval of blank inputs, so that hashing an input resumes from
+// the nearest preceding checkpoint rather than from the start of the tx.
+struct transaction::sighash_cache
+{
+    // Each input serialized with an empty script, in input order.
+    data_chunk blank_inputs;
+
+    // The outputs serialized with count prefix, as under sighash::all.
+    data_chunk outputs;
+
+    // Contexts after version, input count and n * interval blank inputs.
+    std::vector<SHA256CTX> midstates;
+};
+
+inline void update(SHA256CTX& context, const uint8_t* data, size_t size)
+{
+    SHA256Update(&context, data, size);
+}
+
+inline void update(SHA256CTX& context, data_slice data)
+{
+    update(context, data.data(), data.size());
+}
+
+inline void update(SHA256CTX& context, uint32_t value)
+{
+    update(context, to_little_endian(value));
+}
+
+inline void update_variable_uint(SHA256CTX& context, uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        const auto byte = static_cast<uint8_t>(value);
+        update(context, &byte, 1);
+    }
+    else if (value <= max_uint16)
+    {
+        const uint8_t prefix = 0xfd;
+        update(context, &prefix, 1);
+        update(context, to_little_endian(static_cast<uint16_t>(value)));
+    }
+    else if (value <= max_uint32)
+    {
+        const uint8_t prefix = 0xfe;
+        update(context, &prefix, 1);
+        update(context, to_little_endian(static_cast<uint32_t>(value)));
+    }
+    else
+    {
+        const uint8_t prefix = 0xff;
+        update(context, &prefix, 1);
+        update(context, to_little_endian(value));
+    }
+}
+
+// Write the input's point, the given script and the given sequence.
+inline void update_input(SHA256CTX& context, const input& input,
+    const data_chunk& script, uint32_t sequence)
+{
+    const auto& prevout = input.previous_output();
+    update(context, prevout.hash());
+    update(context, prevout.index());
+    update(context, script);
+    update(context, sequence);
+}
+
+// Finalize the preimage and return the double sha256 of it.
+inline hash_digest finalize(SHA256CTX& context, uint32_t locktime,
+    uint32_t sighash_type)
+{
+    hash_digest digest;
+    update(context, locktime);
+    update(context, sighash_type);
+    SHA256Final(&context, digest.data());
+    return sha256_hash(digest);
+}
+
 // Read a length-prefixed collection of inputs or outputs from the source.
 template<class Source, class Put>
 bool read(Source& source, std::vector<Put>& puts)
@@ -119,25 +223,108 @@ transaction::sets_ptr transaction::reserve_buckets(size_t total, size_t fanout)
     return buckets;
 }
 
+// Estimate the relative cost of verifying the input, dominated by sigops.
+// Every input incurs script evaluation, so the cost is at least one.
+static size_t verification_cost(const transaction::element& element)
+{
+    const auto& input = element.tx.inputs()[element.input_index];
+    const auto& prevout = input.previous_output().validation.cache;
+    const auto sigops = ceiling_add(input.signature_operations(true),
+        prevout.signature_operations());
+
+    return ceiling_add(sigops, size_t(1));
+}
+
+// Disperse the elements to the specified number of buckets, balancing the
+// total estimated verification cost of each bucket. Elements are assigned in
+// order of decreasing cost, each to the least loaded bucket. The relative
+// order of elements is preserved within each bucket.
+transaction::sets_const_ptr transaction::balance_buckets(const set& elements,
+    size_t fanout)
+{
+    typedef std::pair<size_t, size_t> load;
+    typedef std::priority_queue<load, std::vector<load>, std::greater<load>>
+        loads;
+
+    const auto buckets = reserve_buckets(elements.size(), fanout);
+
+    // Guard against division by zero.
+    if (buckets->empty())
+        return std::const_pointer_cast<const sets>(buckets);
+
+    std::vector<size_t> costs;
+    costs.reserve(elements.size());
+
+    for (const auto& element: elements)
+        costs.push_back(verification_cost(element));
+
+    std::vector<size_t> order(elements.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+
+    const auto costlier = [&costs](size_t left, size_t right)
+    {
+        return costs[left] > costs[right];
+    };
+
+    std::stable_sort(order.begin(), order.end(), costlier);
+
+    // Buckets ordered by least total cost, then by least bucket index.
+    loads least;
+    std::vector<std::vector<size_t>> assigned(buckets->size());
+
+    for (size_t bucket = 0; bucket < buckets->size(); ++bucket)
+        least.push({ 0, bucket });
+
+    for (const auto index: order)
+    {
+        auto next = least.top();
+        least.pop();
+        assigned[next.second].push_back(index);
+        next.first = ceiling_add(next.first, costs[index]);
+        least.push(next);
+    }
+
+    for (size_t bucket = 0; bucket < buckets->size(); ++bucket)
+    {
+        auto& indexes = assigned[bucket];
+        std::sort(indexes.begin(), indexes.end());
+
+        for (const auto index: indexes)
+            (*buckets)[bucket].push_back(elements[index]);
+    }
+
+    return std::const_pointer_cast<const sets>(buckets);
+}
+
 // default constructors
 
 transaction::transaction()
-  : version_(0), locktime_(0), inputs_(), outputs_(), hash_(nullptr),
-    validation()
+  : validation(), version_(0), locktime_(0), inputs_(), outputs_(),
+    hash_state_(hash_empty), serialized_size_(unset_value),
+    total_input_value_(unset_value), total_output_value_(unset_value),
+    signature_operations_(unset_sigops),
+    signature_operations_bip16_(unset_sigops), sighash_cache_(nullptr)
 {
 }
 
 transaction::transaction(uint32_t version, uint32_t locktime,
     const input::list& inputs, const output::list& outputs)
-  : version_(version), locktime_(locktime), inputs_(inputs), outputs_(outputs),
-    hash_(nullptr), validation()
+  : validation(), version_(version), locktime_(locktime), inputs_(inputs),
+    outputs_(outputs), hash_state_(hash_empty), serialized_size_(unset_value),
+    total_input_value_(unset_value), total_output_value_(unset_value),
+    signature_operations_(unset_sigops),
+    signature_operations_bip16_(unset_sigops), sighash_cache_(nullptr)
 {
 }
 
 transaction::transaction(uint32_t version, uint32_t locktime,
     input::list&& inputs, output::list&& outputs)
-  : version_(version), locktime_(locktime), inputs_(std::move(inputs)),
-    outputs_(std::move(outputs)), hash_(nullptr), validation()
+  : validation(), version_(version), locktime_(locktime),
+    inputs_(std::move(inputs)), outputs_(std::move(outputs)),
+    hash_state_(hash_empty), serialized_size_(unset_value),
+    total_input_value_(unset_value), total_output_value_(unset_value),
+    signature_operations_(unset_sigops),
+    signature_operations_bip16_(unset_sigops), sighash_cache_(nullptr)
 {
 }
 
@@ -155,14 +342,16 @@ transaction::transaction(transaction&& other)
 transaction::transaction(const transaction& other, const hash_digest& hash)
   : transaction(other.version_, other.locktime_, other.inputs_, other.outputs_)
 {
-    hash_.reset(new hash_digest(hash));
+    hash_ = hash;
+    hash_state_.store(hash_published, std::memory_order_release);
 }
 
 transaction::transaction(transaction&& other, const hash_digest& hash)
   : transaction(other.version_, other.locktime_, std::move(other.inputs_),
     std::move(other.outputs_))
 {
-    hash_.reset(new hash_digest(hash));
+    hash_ = hash;
+    hash_state_.store(hash_published, std::memory_order_release);
 }
 
 uint32_t transaction::version() const
@@ -173,6 +362,8 @@ uint32_t transaction::version() const
 void transaction::set_version(uint32_t value)
 {
     version_ = value;
+    invalidate_cache();
+    invalidate_signature_hash_cache();
 }
 
 uint32_t transaction::locktime() const
@@ -183,10 +374,14 @@ uint32_t transaction::locktime() const
 void transaction::set_locktime(uint32_t value)
 {
     locktime_ = value;
+    invalidate_cache();
 }
 
+// The hash and signature hash cache are invalidated as inputs may change.
 input::list& transaction::inputs()
 {
+    invalidate_cache();
+    invalidate_signature_hash_cache();
     return inputs_;
 }
 
@@ -198,15 +393,22 @@ const input::list& transaction::inputs() const
 void transaction::set_inputs(const input::list& value)
 {
     inputs_ = value;
+    invalidate_cache();
+    invalidate_signature_hash_cache();
 }
 
 void transaction::set_inputs(input::list&& value)
 {
     inputs_ = std::move(value);
+    invalidate_cache();
+    invalidate_signature_hash_cache();
 }
 
+// The hash and signature hash cache are invalidated as outputs may change.
 output::list& transaction::outputs()
 {
+    invalidate_cache();
+    invalidate_signature_hash_cache();
     return outputs_;
 }
 
@@ -218,11 +420,15 @@ const output::list& transaction::outputs() const
 void transaction::set_outputs(const output::list& value)
 {
     outputs_ = value;
+    invalidate_cache();
+    invalidate_signature_hash_cache();
 }
 
 void transaction::set_outputs(output::list&& value)
 {
     outputs_ = std::move(value);
+    invalidate_cache();
+    invalidate_signature_hash_cache();
 }
 
 transaction& transaction::operator=(transaction&& other)
@@ -231,6 +437,8 @@ transaction& transaction::operator=(transaction&& other)
     locktime_ = other.locktime_;
     inputs_ = std::move(other.inputs_);
     outputs_ = std::move(other.outputs_);
+    invalidate_cache();
+    invalidate_signature_hash_cache();
     return *this;
 }
 
@@ -241,6 +449,8 @@ transaction& transaction::operator=(const transaction& other)
     locktime_ = other.locktime_;
     inputs_ = other.inputs_;
     outputs_ = other.outputs_;
+    invalidate_cache();
+    invalidate_signature_hash_cache();
     return *this;
 }
 
@@ -257,8 +467,8 @@ bool transaction::operator!=(const transaction& other) const
 
 bool transaction::from_data(const data_chunk& data, bool satoshi)
 {
-    data_source istream(data);
-    return from_data(istream, satoshi);
+    slice_reader source(data);
+    return from_data(source, satoshi);
 }
 
 bool transaction::from_data(std::istream& stream, bool satoshi)
@@ -348,13 +558,17 @@ void transaction::reset()
     outputs_.clear();
     outputs_.shrink_to_fit();
 
-    hash_mutex_.lock();
-    hash_.reset();
-    hash_mutex_.unlock();
+    invalidate_cache();
+    invalidate_signature_hash_cache();
 }
 
 uint64_t transaction::serialized_size() const
 {
+    const auto cached = serialized_size_.load(std::memory_order_relaxed);
+
+    if (cached != unset_value)
+        return cached;
+
     uint64_t tx_size = 8;
     tx_size += variable_uint_size(inputs_.size());
     for (const auto& input : inputs_)
@@ -364,27 +578,21 @@ uint64_t transaction::serialized_size() const
     for (const auto& output : outputs_)
         tx_size += output.serialized_size();
 
+    serialized_size_.store(tx_size, std::memory_order_relaxed);
     return tx_size;
 }
 
-// TODO: provide optimization option to balance total sigops across buckets.
-// Disperse the inputs of the tx evenly to the specified number of buckets.
+// Disperse the inputs of the tx to the specified number of buckets, balancing
+// the estimated verification cost (sigops) of each bucket.
 transaction::sets_const_ptr transaction::to_input_sets(size_t fanout) const
 {
-    const auto total = inputs_.size();
-    const auto buckets = reserve_buckets(total, fanout);
-
-    // Guard against division by zero.
-    if (!buckets->empty())
-    {
-        size_t count = 0;
+    set elements;
+    elements.reserve(inputs_.size());
 
-        // Populate each bucket with either full (or full-1) input references.
-        for (size_t index = 0; index < inputs_.size(); ++index)
-            (*buckets)[count++ % fanout].push_back({ *this, index });
-    }
+    for (size_t index = 0; index < inputs_.size(); ++index)
+        elements.push_back({ *this, index });
 
-    return std::const_pointer_cast<const sets>(buckets);
+    return balance_buckets(elements, fanout);
 }
 
 std::string transaction::to_string(uint32_t flags) const
@@ -406,33 +614,196 @@ std::string transaction::to_string(uint32_t flags) const
     return value.str();
 }
 
+// The hash is computed by streaming the serialization through the hasher.
+// Concurrent first readers may each compute it, but only one publishes it.
 hash_digest transaction::hash() const
+{
+    if (hash_state_.load(std::memory_order_acquire) == hash_published)
+        return hash_;
+
+    bitcoin_hash_buffer buffer;
+    std::ostream stream(&buffer);
+    to_data(stream);
+    const auto hash = buffer.digest();
+
+    uint8_t expected = hash_empty;
+
+    if (hash_state_.compare_exchange_strong(expected, hash_pending,
+        std::memory_order_acquire))
+    {
+        hash_ = hash;
+        hash_state_.store(hash_published, std::memory_order_release);
+    }
+
+    return hash;
+}
+
+// Mutation is not thread safe, so there is no concurrent publication here.
+void transaction::invalidate_cache() const
+{
+    hash_state_.store(hash_empty, std::memory_order_release);
+    serialized_size_.store(unset_value, std::memory_order_relaxed);
+    total_input_value_.store(unset_value, std::memory_order_relaxed);
+    total_output_value_.store(unset_value, std::memory_order_relaxed);
+    signature_operations_.store(unset_sigops, std::memory_order_relaxed);
+    signature_operations_bip16_.store(unset_sigops, std::memory_order_relaxed);
+}
+
+hash_digest transaction::hash(uint32_t sighash_type) const
+{
+    auto serialized = to_data();
+    extend_data(serialized, to_little_endian(sighash_type));
+    return bitcoin_hash(serialized);
+}
+
+void transaction::invalidate_signature_hash_cache() const
+{
+    sighash_mutex_.lock();
+    sighash_cache_.reset();
+    sighash_mutex_.unlock();
+}
+
+transaction::sighash_cache_ptr transaction::signature_hash_cache() const
 {
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
-    hash_mutex_.lock_upgrade();
+    sighash_mutex_.lock_upgrade();
 
-    if (!hash_)
+    if (!sighash_cache_)
     {
         //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        hash_.reset(new hash_digest(bitcoin_hash(to_data())));
-        hash_mutex_.unlock_and_lock_upgrade();
+        sighash_mutex_.unlock_upgrade_and_lock();
+        const auto cache = std::make_shared<sighash_cache>();
+        auto& blanks = cache->blank_inputs;
+        blanks.reserve(inputs_.size() * blank_input_size);
+        const data_chunk empty_script(1, 0x00);
+
+        for (const auto& input: inputs_)
+        {
+            const auto& prevout = input.previous_output();
+            extend_data(blanks, prevout.hash());
+            extend_data(blanks, to_little_endian(prevout.index()));
+            extend_data(blanks, empty_script);
+            extend_data(blanks, to_little_endian(input.sequence()));
+        }
+
+        data_sink ostream(cache->outputs);
+        ostream_writer sink(ostream);
+        write(sink, outputs_);
+        ostream.flush();
+
+        SHA256CTX context;
+        SHA256Init(&context);
+        update(context, version_);
+        update_variable_uint(context, inputs_.size());
+
+        const auto intervals = inputs_.size() / sighash_midstate_interval;
+        const auto stride = sighash_midstate_interval * blank_input_size;
+        cache->midstates.reserve(intervals + 1);
+        cache->midstates.push_back(context);
+
+        for (size_t interval = 0; interval < intervals; ++interval)
+        {
+            update(context, &blanks[interval * stride], stride);
+            cache->midstates.push_back(context);
+        }
+
+        sighash_cache_ = cache;
+        sighash_mutex_.unlock_and_lock_upgrade();
         //---------------------------------------------------------------------
     }
 
-    const auto hash = *hash_;
-    hash_mutex_.unlock_upgrade();
+    const auto cache = sighash_cache_;
+    sighash_mutex_.unlock_upgrade();
     ///////////////////////////////////////////////////////////////////////////
 
-    return hash;
+    return cache;
 }
 
-hash_digest transaction::hash(uint32_t sighash_type) const
+// This is equivalent to hashing a copy of the tx modified for the sighash
+// type (see script::generate_signature_hash), without the copy.
+hash_digest transaction::signature_hash(uint32_t input_index,
+    const script& script_code, uint8_t sighash_type) const
 {
-    auto serialized = to_data();
-    extend_data(serialized, to_little_endian(sighash_type));
-    return bitcoin_hash(serialized);
+    BITCOIN_ASSERT(input_index < inputs_.size());
+    const auto type = sighash_type & signature_hash_algorithm::mask;
+    const auto none = type == signature_hash_algorithm::none;
+    const auto single = type == signature_hash_algorithm::single;
+    const auto anyone = (sighash_type &
+        signature_hash_algorithm::anyone_can_pay) != 0;
+
+    BITCOIN_ASSERT(!single || input_index < outputs_.size());
+    const auto& self = inputs_[input_index];
+    const auto script = script_code.to_data(true);
+    const auto cache = signature_hash_cache();
+
+    SHA256CTX context;
+
+    if (anyone)
+    {
+        // Only this input is signed, retaining its own sequence.
+        SHA256Init(&context);
+        update(context, version_);
+        update_variable_uint(context, 1);
+        update_input(context, self, script, self.sequence());
+    }
+    else if (none || single)
+    {
+        // All inputs are signed, with the sequences of the others zeroed.
+        static const data_chunk empty_script(1, 0x00);
+        context = cache->midstates.front();
+
+        for (uint32_t index = 0; index < inputs_.size(); ++index)
+        {
+            const auto& input = inputs_[index];
+            const auto own = index == input_index;
+            update_input(context, input, own ? script : empty_script,
+                own ? input.sequence() : 0);
+        }
+    }
+    else
+    {
+        // Resume from the nearest midstate preceding this input.
+        const auto& blanks = cache->blank_inputs;
+        const auto interval = input_index / sighash_midstate_interval;
+        const auto start = interval * sighash_midstate_interval;
+        context = cache->midstates[interval];
+
+        const auto begin = start * blank_input_size;
+        const auto self_begin = input_index * blank_input_size;
+        const auto self_end = self_begin + blank_input_size;
+        update(context, &blanks[begin], self_begin - begin);
+        update_input(context, self, script, self.sequence());
+        update(context, blanks.data() + self_end, blanks.size() - self_end);
+    }
+
+    if (none)
+    {
+        // No outputs are signed.
+        update_variable_uint(context, 0);
+    }
+    else if (single)
+    {
+        // Only the output corresponding to this input is signed, preceded by
+        // blank outputs (max value and empty script) for each lower index.
+        static const data_chunk blank_output
+        {
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00
+        };
+
+        update_variable_uint(context, input_index + 1);
+
+        for (uint32_t index = 0; index < input_index; ++index)
+            update(context, blank_output);
+
+        update(context, outputs_[input_index].to_data());
+    }
+    else
+    {
+        update(context, cache->outputs);
+    }
+
+    return finalize(context, locktime_, sighash_type);
 }
 
 bool transaction::is_coinbase() const
@@ -498,31 +869,53 @@ bool transaction::is_locktime_conflict() const
 }
 
 // Returns max_uint64 in case of overflow.
+// The value is retained only once all previous outputs are populated.
 uint64_t transaction::total_input_value() const
 {
     ////static_assert(max_money() < max_uint64, "overflow sentinel invalid");
-    const auto value = [](uint64_t total, const input& input)
+    const auto cached = total_input_value_.load(std::memory_order_relaxed);
+
+    if (cached != unset_value)
+        return cached;
+
+    uint64_t total = 0;
+    auto missing = false;
+
+    for (const auto& input: inputs_)
     {
-        const auto& prevout = input.previous_output().validation.cache;
-        const auto missing = !prevout.is_valid();
+        const auto& prevout = input.previous_output();
+        const auto& cache = prevout.validation.cache;
+        const auto valid = cache.is_valid();
+        missing |= !valid && !prevout.is_null();
 
         // Treat missing previous outputs as zero-valued, no math on sentinel.
-        return ceiling_add(total, missing ? 0 : prevout.value());
-    };
+        total = ceiling_add(total, valid ? cache.value() : 0);
+    }
+
+    if (!missing)
+        total_input_value_.store(total, std::memory_order_relaxed);
 
-    return std::accumulate(inputs_.begin(), inputs_.end(), uint64_t(0), value);
+    return total;
 }
 
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_output_value() const
 {
     ////static_assert(max_money() < max_uint64, "overflow sentinel invalid");
+    const auto cached = total_output_value_.load(std::memory_order_relaxed);
+
+    if (cached != unset_value)
+        return cached;
+
     const auto value = [](uint64_t total, const output& output)
     {
         return ceiling_add(total, output.value());
     };
 
-    return std::accumulate(outputs_.begin(), outputs_.end(), uint64_t(0), value);
+    const auto total = std::accumulate(outputs_.begin(), outputs_.end(),
+        uint64_t(0), value);
+    total_output_value_.store(total, std::memory_order_relaxed);
+    return total;
 }
 
 uint64_t transaction::fees() const
@@ -535,8 +928,16 @@ bool transaction::is_overspent() const
     return !is_coinbase() && total_output_value() > total_input_value();
 }
 
+// The bip16 count is retained only once all previous outputs are populated.
 size_t transaction::signature_operations(bool bip16_active) const
 {
+    auto& retained = bip16_active ? signature_operations_bip16_ :
+        signature_operations_;
+    const auto cached = retained.load(std::memory_order_relaxed);
+
+    if (cached != unset_sigops)
+        return cached;
+
     const auto in = [bip16_active](size_t total, const input& input)
     {
         // This includes BIP16 p2sh additional sigops if prevout is cached.
@@ -551,6 +952,10 @@ size_t transaction::signature_operations(bool bip16_active) const
     size_t sigops = 0;
     sigops += std::accumulate(inputs_.begin(), inputs_.end(), sigops, in);
     sigops += std::accumulate(outputs_.begin(), outputs_.end(), sigops, out);
+
+    if (!bip16_active || !is_missing_inputs())
+        retained.store(sigops, std::memory_order_relaxed);
+
     return sigops;
 }
 
@@ -668,7 +1073,6 @@ code transaction::check(bool transaction_pool) const
         return error::success;
 }
 
-// TODO: implement sigops and total input/output value caching.
 // These checks assume that prevout caching is completed on all tx.inputs.
 // Flags for tx pool calls should be based on the current blockchain height.
 code transaction::accept(const chain_state& state, bool transaction_pool) const
@@ -728,8 +1132,8 @@ code transaction::connect_input(const chain_state& state,
         return error::input_not_found;
 
     const auto flags = state.enabled_forks();
-    const auto valid = script::verify(*this, index32, flags);
-    return valid ? error::success : error::validate_inputs_failed;
+    const auto ec = script::verify(*this, index32, flags);
+    return ec ? error::validate_inputs_failed : error::success;
 }
 
 } // namespace chain
@@ -19,14 +19,25 @@
  */
 #include <bitcoin/bitcoin/formats/base_58.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
 
-const std::string base58_chars =
+// Constant initialized, so that it is safe to use in static initialization.
+static const char base58_digits[] =
     "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
+const std::string base58_chars = base58_digits;
+
 bool is_base58(const char ch)
 {
     // This works because the base58 characters happen to be in sorted order
@@ -43,155 +54,254 @@ bool is_base58(const std::string& text)
     return std::all_of(text.begin(), text.end(), test);
 }
 
-template <typename Data>
-auto search_first_nonzero(const Data& data) -> decltype(data.cbegin())
+// Base58 digits are processed in limbs of 58^5, the largest power of 58 whose
+// product with a 32 bit word fits in 64 bits. Bytes are processed in 32 bit
+// words, so each step of the conversion handles four bytes or five digits.
+static constexpr uint64_t limb_modulus = 656356768;
+static constexpr size_t limb_digits = 5;
+static constexpr size_t word_bytes = 4;
+
+// The base58 digit value of each character, or -1 if not base58.
+static const int8_t base58_values[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8, -1, -1, -1, -1, -1, -1,
+    -1,  9, 10, 11, 12, 13, 14, 15, 16, -1, 17, 18, 19, 20, 21, -1,
+    22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1, -1,
+    -1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46,
+    47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+// Fixed is the input size when known at compile time (otherwise zero), which
+// allows the common sizes to be compiled with constant loop bounds.
+template <size_t Fixed>
+static size_t encode_limbs(char* out, const uint8_t* in, size_t size,
+    uint64_t* limbs)
 {
-    auto first_nonzero = data.cbegin();
-    while (first_nonzero != data.end() && *first_nonzero == 0)
-        ++first_nonzero;
+    if (Fixed != 0)
+        size = Fixed;
 
-    return first_nonzero;
-}
+    // Leading zero bytes are encoded as leading '1's.
+    size_t zeros = 0;
+    while (zeros < size && in[zeros] == 0)
+        ++zeros;
 
-size_t count_leading_zeros(data_slice unencoded)
-{
-    // Skip and count leading '1's.
-    size_t leading_zeros = 0;
-    for (const uint8_t byte: unencoded)
+    // Apply "b58 = b58 * 2^32 + word" over little endian limbs.
+    size_t used = 0;
+    auto it = in + zeros;
+    const auto end = in + size;
+
+    // A leading partial word leaves only whole words to follow.
+    auto bytes = static_cast<size_t>(end - it) % word_bytes;
+    if (bytes == 0)
+        bytes = word_bytes;
+
+    for (; it != end; bytes = word_bytes)
     {
-        if (byte != 0)
-            break;
+        uint64_t carry = 0;
+        for (size_t byte = 0; byte < bytes; ++byte)
+            carry = (carry << 8) | *it++;
+
+        const auto multiplier = uint64_t(1) << (8 * bytes);
+
+        for (size_t limb = 0; limb < used; ++limb)
+        {
+            carry += limbs[limb] * multiplier;
+            limbs[limb] = carry % limb_modulus;
+            carry /= limb_modulus;
+        }
 
-        ++leading_zeros;
+        for (; carry != 0; carry /= limb_modulus)
+            limbs[used++] = carry % limb_modulus;
     }
 
-    return leading_zeros;
-}
+    auto position = std::fill_n(out, zeros, base58_digits[0]);
 
-void pack_value(data_chunk& indexes, size_t carry)
-{
-    // Apply "b58 = b58 * 256 + ch".
-    for (auto it = indexes.rbegin(); it != indexes.rend(); ++it)
+    if (used == 0)
+        return zeros;
+
+    // The most significant limb is written without leading zero digits.
+    char digits[limb_digits];
+    size_t count = 0;
+    for (auto value = limbs[used - 1]; value != 0; value /= 58)
+        digits[count++] = base58_digits[value % 58];
+
+    while (count != 0)
+        *position++ = digits[--count];
+
+    for (auto limb = used - 1; limb-- != 0; position += limb_digits)
     {
-        carry += 256 * (*it);
-        *it = carry % 58;
-        carry /= 58;
+        auto value = limbs[limb];
+        for (auto digit = limb_digits; digit-- != 0; value /= 58)
+            position[digit] = base58_digits[value % 58];
     }
 
-    BITCOIN_ASSERT(carry == 0);
+    return static_cast<size_t>(position - out);
 }
 
-std::string encode_base58(data_slice unencoded)
+// Fixed is the output size when known at compile time (otherwise zero). The
+// limbs must hold out_size / 4 + 1 words, a larger value fails early.
+template <size_t Fixed>
+static bool decode_limbs(uint8_t* out, size_t& out_size, const char* in,
+    size_t size, uint32_t* limbs)
 {
-    size_t leading_zeros = count_leading_zeros(unencoded);
+    if (Fixed != 0)
+        out_size = Fixed;
 
-    // size = log(256) / log(58), rounded up.
-    const size_t number_nonzero = unencoded.size() - leading_zeros;
-    const size_t indexes_size = number_nonzero * 138 / 100 + 1;
+    const auto capacity = out_size / word_bytes + 1;
 
-    // Allocate enough space in big-endian base58 representation.
-    data_chunk indexes(indexes_size);
+    // Leading '1's are decoded as leading zero bytes.
+    size_t zeros = 0;
+    while (zeros < size && in[zeros] == base58_digits[0])
+        ++zeros;
 
-    // Process the bytes.
-    for (auto it = unencoded.begin() + leading_zeros;
-        it != unencoded.end(); ++it)
+    // Apply "b256 = b256 * 58^5 + limb" over little endian words.
+    size_t used = 0;
+    auto it = in + zeros;
+    const auto end = in + size;
+
+    // A leading partial limb leaves only whole limbs to follow.
+    auto digits = static_cast<size_t>(end - it) % limb_digits;
+    if (digits == 0)
+        digits = limb_digits;
+
+    for (; it != end; digits = limb_digits)
     {
-        pack_value(indexes, *it);
+        uint64_t carry = 0;
+        uint64_t multiplier = 1;
+
+        for (size_t digit = 0; digit < digits; ++digit, multiplier *= 58)
+        {
+            const auto value = base58_values[static_cast<uint8_t>(*it++)];
+            if (value < 0)
+                return false;
+
+            carry = carry * 58 + value;
+        }
+
+        for (size_t word = 0; word < used; ++word)
+        {
+            carry += limbs[word] * multiplier;
+            limbs[word] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+
+        for (; carry != 0; carry >>= 32)
+        {
+            if (used == capacity)
+                return false;
+
+            limbs[used++] = static_cast<uint32_t>(carry);
+        }
     }
 
-    // Skip leading zeroes in base58 result.
-    auto first_nonzero = search_first_nonzero(indexes);
+    // Skip leading zero bytes of the most significant word.
+    auto bytes = used * word_bytes;
+    if (used != 0)
+        for (auto top = limbs[used - 1]; (top & 0xff000000) == 0; top <<= 8)
+            --bytes;
 
-    // Translate the result into a string.
-    std::string encoded;
-    const size_t estimated_size = leading_zeros + 
-        (indexes.end() - first_nonzero);
-    encoded.reserve(estimated_size);
-    encoded.assign(leading_zeros, '1');
+    if (zeros + bytes > out_size)
+        return false;
 
-    // Set actual main bytes.
-    for (auto it = first_nonzero; it != indexes.end(); ++it)
-    {
-        const size_t index = *it;
-        encoded += base58_chars[index];
-    }
+    auto position = std::fill_n(out, zeros, 0x00);
+    for (auto byte = bytes; byte-- != 0;)
+        *position++ = static_cast<uint8_t>(
+            limbs[byte / word_bytes] >> (8 * (byte % word_bytes)));
+
+    out_size = zeros + bytes;
+    return true;
+}
 
+std::string encode_base58(data_slice unencoded)
+{
+    const auto size = unencoded.size();
+    std::vector<uint64_t> limbs(size * 138 / 500 + 2);
+    std::string encoded(size * 138 / 100 + 1, 0x00);
+    encoded.resize(encode_base58_private(&encoded[0], unencoded.data(), size,
+        limbs.data()));
     return encoded;
 }
 
-size_t count_leading_zeros(const std::string& encoded)
+bool decode_base58(data_chunk& out, const std::string& in)
 {
-    // Skip and count leading '1's.
-    size_t leading_zeros = 0;
-    for (const uint8_t digit: encoded)
-    {
-        if (digit != base58_chars[0])
-            break;
+    // Each leading '1' is a byte, and other digits are less than a byte.
+    auto size = in.size();
+    std::vector<uint32_t> limbs(size / word_bytes + 1);
+    data_chunk decoded(size);
 
-        ++leading_zeros;
-    }
+    if (!decode_limbs<0>(decoded.data(), size, in.data(), in.size(),
+        limbs.data()))
+        return false;
 
-    return leading_zeros;
+    decoded.resize(size);
+    out = std::move(decoded);
+    return true;
 }
 
-void unpack_char(data_chunk& data, size_t carry)
+// For support of template implementation only, do not call directly.
+size_t encode_base58_private(char* out, const uint8_t* in, size_t size,
+    uint64_t* limbs)
 {
-    for (auto it = data.rbegin(); it != data.rend(); it++)
+    // Payment address, uncompressed and compressed wif, and hd key sizes.
+    switch (size)
     {
-        carry += 58 * (*it);
-        *it = carry % 256;
-        carry /= 256;
+        case 25:
+            return encode_limbs<25>(out, in, size, limbs);
+        case 37:
+            return encode_limbs<37>(out, in, size, limbs);
+        case 38:
+            return encode_limbs<38>(out, in, size, limbs);
+        case 82:
+            return encode_limbs<82>(out, in, size, limbs);
+        default:
+            return encode_limbs<0>(out, in, size, limbs);
     }
-
-    BITCOIN_ASSERT(carry == 0);
 }
 
-bool decode_base58(data_chunk& out, const std::string& in)
+// For support of template implementation only, do not call directly.
+bool decode_base58_private(uint8_t* out, size_t out_size, const char* in,
+    size_t in_size, uint32_t* limbs)
 {
-    // Trim spaces and newlines around the string.
-    const auto leading_zeros = count_leading_zeros(in);
+    auto size = out_size;
 
-    // log(58) / log(256), rounded up.
-    const size_t data_size = in.size() * 733 / 1000 + 1;
-
-    // Allocate enough space in big-endian base256 representation.
-    data_chunk data(data_size);
-
-    // Process the characters.
-    for (auto it = in.begin() + leading_zeros; it != in.end(); ++it)
+    // Payment address, uncompressed and compressed wif, and hd key sizes.
+    switch (out_size)
     {
-        const auto carry = base58_chars.find(*it);
-        if (carry == std::string::npos)
-            return false;
-
-        unpack_char(data, carry);
+        case 25:
+            return decode_limbs<25>(out, size, in, in_size, limbs) &&
+                size == out_size;
+        case 37:
+            return decode_limbs<37>(out, size, in, in_size, limbs) &&
+                size == out_size;
+        case 38:
+            return decode_limbs<38>(out, size, in, in_size, limbs) &&
+                size == out_size;
+        case 82:
+            return decode_limbs<82>(out, size, in, in_size, limbs) &&
+                size == out_size;
+        default:
+            return decode_limbs<0>(out, size, in, in_size, limbs) &&
+                size == out_size;
     }
-
-    // Skip leading zeroes in data.
-    auto first_nonzero = search_first_nonzero(data);
-
-    // Copy result into output vector.
-    data_chunk decoded;
-    const size_t estimated_size = leading_zeros + (data.end() - first_nonzero);
-    decoded.reserve(estimated_size);
-    decoded.assign(leading_zeros, 0x00);
-    decoded.insert(decoded.end(), first_nonzero, data.cend());
-
-    out = decoded;
-    return true;
 }
 
 // For support of template implementation only, do not call directly.
 bool decode_base58_private(uint8_t* out, size_t out_size, const char* in)
 {
-    data_chunk buffer;
-    if (!decode_base58(buffer, in) || buffer.size() != out_size)
-        return false;
-
-    for (size_t i = 0; i < out_size; ++i)
-        out[i] = buffer[i];
-
-    return true;
+    std::vector<uint32_t> limbs(out_size / word_bytes + 1);
+    return decode_base58_private(out, out_size, in, std::strlen(in),
+        limbs.data());
 }
 
 } // namespace libbitcoin
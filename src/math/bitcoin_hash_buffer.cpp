@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bitcoin_hash_buffer.hpp"
+
+#include <cstdint>
+#include <streambuf>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include "external/sha256.h"
+
+namespace libbitcoin {
+
+bitcoin_hash_buffer::bitcoin_hash_buffer()
+{
+    SHA256Init(&context_);
+}
+
+hash_digest bitcoin_hash_buffer::digest()
+{
+    hash_digest first;
+    SHA256Final(&context_, first.data());
+
+    hash_digest second;
+    SHA256_(first.data(), first.size(), second.data());
+    return second;
+}
+
+void bitcoin_hash_buffer::reset()
+{
+    SHA256Init(&context_);
+}
+
+// There is no put area, so each single character write overflows.
+bitcoin_hash_buffer::int_type bitcoin_hash_buffer::overflow(int_type value)
+{
+    if (traits_type::eq_int_type(value, traits_type::eof()))
+        return traits_type::not_eof(value);
+
+    const auto byte = static_cast<uint8_t>(traits_type::to_char_type(value));
+    SHA256Update(&context_, &byte, 1);
+    return value;
+}
+
+std::streamsize bitcoin_hash_buffer::xsputn(const char_type* data,
+    std::streamsize size)
+{
+    SHA256Update(&context_, reinterpret_cast<const uint8_t*>(data),
+        static_cast<size_t>(size));
+    return size;
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BITCOIN_HASH_BUFFER_HPP
+#define LIBBITCOIN_BITCOIN_HASH_BUFFER_HPP
+
+#include <streambuf>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include "external/sha256.h"
+
+namespace libbitcoin {
+
+/// Output stream buffer that hashes written data as it is streamed, so that
+/// a serializable object can be hashed without materializing its data.
+class bitcoin_hash_buffer
+  : public std::streambuf
+{
+public:
+    bitcoin_hash_buffer();
+
+    /// The bitcoin hash (sha256(sha256(data))) of all data written.
+    /// The buffer must not be written after the digest is obtained.
+    hash_digest digest();
+
+    /// Discard all data written, allowing the buffer to be reused.
+    void reset();
+
+protected:
+    int_type overflow(int_type value);
+    std::streamsize xsputn(const char_type* data, std::streamsize size);
+
+private:
+    SHA256CTX context_;
+};
+
+} // namespace libbitcoin
+
+#endif
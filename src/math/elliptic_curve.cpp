@@ -20,12 +20,16 @@
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <map>
+#include <vector>
 #include <secp256k1.h>
 #include <secp256k1_recovery.h>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include "../math/external/lax_der_parsing.h"
 #include "secp256k1_initializer.hpp"
 
@@ -134,6 +138,40 @@ bool ec_add(ec_uncompressed& point, const ec_secret& secret)
     return ec_add(context, point, secret);
 }
 
+bool ec_add(point_list& out, const ec_compressed& point,
+    const secret_list& secrets, size_t threads)
+{
+    const auto size = secrets.size();
+    const auto context = verification.context();
+    out.assign(size, null_compressed_point);
+
+    secp256k1_pubkey parent;
+    if (!parse(context, parent, point))
+        return false;
+
+    // Results are bytes so that threads may set distinct elements.
+    std::vector<uint8_t> results(size, 0);
+
+    const auto add = [&](size_t begin, size_t end)
+    {
+        for (auto index = begin; index < end; ++index)
+        {
+            auto pubkey = parent;
+            results[index] = secp256k1_ec_pubkey_tweak_add(context, &pubkey,
+                secrets[index].data()) == 1 &&
+                serialize(context, out[index], pubkey);
+
+            if (!results[index])
+                out[index] = null_compressed_point;
+        }
+    };
+
+    parallel_for(threads, size, add);
+
+    return std::all_of(results.begin(), results.end(),
+        [](uint8_t result) { return result != 0; });
+}
+
 bool ec_add(ec_secret& left, const ec_secret& right)
 {
     const auto context = verification.context();
@@ -340,6 +378,57 @@ bool verify_signature(data_slice point, const hash_digest& hash,
         secp256k1_ecdsa_verify(context, &normal, hash.data(), &pubkey) == 1;
 }
 
+bool verify_signatures(std::vector<bool>& out,
+    const signature_verification::list& batch, size_t threads)
+{
+    const auto size = batch.size();
+    const auto context = verification.context();
+
+    // Parse each distinct point once, and map each item to its parsed point.
+    std::map<data_chunk, size_t> indexes;
+    std::vector<secp256k1_pubkey> points;
+    std::vector<uint8_t> parsed;
+    std::vector<size_t> items;
+    items.reserve(size);
+
+    for (const auto& item: batch)
+    {
+        const auto next = points.size();
+        const auto entry = indexes.emplace(item.point, next);
+
+        if (entry.second)
+        {
+            secp256k1_pubkey pubkey;
+            const auto& point = item.point;
+            parsed.push_back(secp256k1_ec_pubkey_parse(context, &pubkey,
+                point.data(), point.size()) == 1);
+            points.push_back(pubkey);
+        }
+
+        items.push_back(entry.first->second);
+    }
+
+    // Results are bytes so that threads may set distinct elements.
+    std::vector<uint8_t> results(size, 0);
+
+    const auto verify = [&](size_t begin, size_t end)
+    {
+        for (auto index = begin; index < end; ++index)
+        {
+            const auto point = items[index];
+            const auto& item = batch[index];
+            results[index] = parsed[point] &&
+                verify_signature(context, points[point], item.hash,
+                    item.signature);
+        }
+    };
+
+    parallel_for(threads, size, verify);
+    out.assign(results.begin(), results.end());
+    return std::all_of(results.begin(), results.end(),
+        [](uint8_t result) { return result != 0; });
+}
+
 // Recoverable sign/recover
 // ----------------------------------------------------------------------------
 
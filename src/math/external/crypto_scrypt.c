@@ -35,12 +35,23 @@
 #include <bitcoin/bitcoin/compat.h>
 #include "pbkdf2_sha256.h"
 
-static void blkcpy(uint8_t*, uint8_t*, size_t);
-static void blkxor(uint8_t*, uint8_t*, size_t);
-static void salsa20_8(uint8_t[64]);
-static void blockmix_salsa8(uint8_t*, uint8_t*, size_t);
-static uint64_t integerify(uint8_t*, size_t);
-static void smix(uint8_t* , size_t, uint64_t, uint8_t*, uint8_t*);
+/* Blocks are mixed as 32 bit words. With sse2 (always present on x64) the
+ * words of each 64 byte block are stored in the diagonal order of the vector
+ * salsa20/8 core, where position i holds word 5i mod 16, so that no shuffling
+ * is required within the mix. */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SCRYPT_SSE2
+    #include <emmintrin.h>
+    #define SCRYPT_WORD(i) (((i) * 5) % 16)
+#else
+    #define SCRYPT_WORD(i) (i)
+#endif
+
+static void blkcpy(uint32_t*, const uint32_t*, size_t);
+static void blkxor(uint32_t*, const uint32_t*, size_t);
+static void blockmix_salsa8(const uint32_t*, uint32_t*, uint32_t*, size_t);
+static uint64_t integerify(const uint32_t*, size_t);
 
 static BC_C_INLINE uint32_t le32dec(const void* pp)
 {
@@ -58,30 +69,127 @@ static BC_C_INLINE void le32enc(void* pp, uint32_t x)
     p[3] = (x >> 24) & 0xff;
 }
 
-static BC_C_INLINE uint64_t le64dec(const void* pp)
+static void blkcpy(uint32_t* dest, const uint32_t* src, size_t len)
 {
-    const uint8_t* p = (uint8_t const* )pp;
-
-    return ((uint64_t)(p[0]) + ((uint64_t)(p[1]) << 8) +
-            ((uint64_t)(p[2]) << 16) + ((uint64_t)(p[3]) << 24) +
-            ((uint64_t)(p[4]) << 32) + ((uint64_t)(p[5]) << 40) +
-            ((uint64_t)(p[6]) << 48) + ((uint64_t)(p[7]) << 56));
+    memcpy(dest, src, len);
 }
 
+#ifdef SCRYPT_SSE2
 
-static void blkcpy(uint8_t* dest, uint8_t* src, size_t len)
+static void blkxor(uint32_t* dest, const uint32_t* src, size_t len)
 {
     size_t i;
+    __m128i* D = (__m128i*)dest;
+    const __m128i* S = (const __m128i*)src;
+
+    for (i = 0; i < len / 16; i++)
+        _mm_storeu_si128(&D[i], _mm_xor_si128(_mm_loadu_si128(&D[i]),
+            _mm_loadu_si128(&S[i])));
+}
+
+/**
+ * salsa20_8(B):
+ * Apply the salsa20/8 core to the provided block, held as four vectors of
+ * the diagonals of the 4x4 word matrix.
+ */
+static BC_C_INLINE void salsa20_8(__m128i B[4])
+{
+    __m128i X0, X1, X2, X3;
+    __m128i T;
+    size_t i;
+
+    X0 = B[0];
+    X1 = B[1];
+    X2 = B[2];
+    X3 = B[3];
+
+    for (i = 0; i < 8; i += 2) {
+#define R(x, t, a) \
+        x = _mm_xor_si128(x, _mm_slli_epi32(t, a)); \
+        x = _mm_xor_si128(x, _mm_srli_epi32(t, 32 - a))
+        /* Operate on columns. */
+        T = _mm_add_epi32(X0, X3); R(X1, T, 7);
+        T = _mm_add_epi32(X1, X0); R(X2, T, 9);
+        T = _mm_add_epi32(X2, X1); R(X3, T, 13);
+        T = _mm_add_epi32(X3, X2); R(X0, T, 18);
+
+        /* Rearrange data. */
+        X1 = _mm_shuffle_epi32(X1, 0x93);
+        X2 = _mm_shuffle_epi32(X2, 0x4E);
+        X3 = _mm_shuffle_epi32(X3, 0x39);
+
+        /* Operate on rows. */
+        T = _mm_add_epi32(X0, X1); R(X3, T, 7);
+        T = _mm_add_epi32(X3, X0); R(X2, T, 9);
+        T = _mm_add_epi32(X2, X3); R(X1, T, 13);
+        T = _mm_add_epi32(X1, X2); R(X0, T, 18);
+
+        /* Rearrange data. */
+        X1 = _mm_shuffle_epi32(X1, 0x39);
+        X2 = _mm_shuffle_epi32(X2, 0x4E);
+        X3 = _mm_shuffle_epi32(X3, 0x93);
+#undef R
+    }
+
+    B[0] = _mm_add_epi32(B[0], X0);
+    B[1] = _mm_add_epi32(B[1], X1);
+    B[2] = _mm_add_epi32(B[2], X2);
+    B[3] = _mm_add_epi32(B[3], X3);
+}
+
+/**
+ * blockmix_salsa8(Bin, Bout, Z, r):
+ * Compute Bout = BlockMix_{salsa20/8, r}(Bin).  The input Bin must be 128r
+ * bytes in length; the output Bout must also be the same size.  The
+ * temporary space Z is not used by the vector implementation.
+ */
+static void blockmix_salsa8(const uint32_t* Bin, uint32_t* Bout,
+    uint32_t* Z, size_t r)
+{
+    __m128i X[4];
+    const __m128i* in = (const __m128i*)Bin;
+    __m128i* out;
+    size_t i, k;
+    (void)Z;
+
+    /* 1: X <-- B_{2r - 1} */
+    for (k = 0; k < 4; k++)
+        X[k] = _mm_loadu_si128(&in[(2 * r - 1) * 4 + k]);
+
+    /* 2: for i = 0 to 2r - 1 do */
+    for (i = 0; i < 2 * r; i++) {
+        /* 3: X <-- H(X \xor B_i) */
+        for (k = 0; k < 4; k++)
+            X[k] = _mm_xor_si128(X[k], _mm_loadu_si128(&in[i * 4 + k]));
+        salsa20_8(X);
+
+        /* 4: Y_i <-- X */
+        /* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
+        out = (__m128i*)&Bout[((i / 2) + (i & 1) * r) * 16];
+        for (k = 0; k < 4; k++)
+            _mm_storeu_si128(&out[k], X[k]);
+    }
+}
+
+/**
+ * integerify(B, r):
+ * Return the result of parsing B_{2r-1} as a little-endian integer, where
+ * its second word is stored at the diagonal position of word 1.
+ */
+static uint64_t integerify(const uint32_t* B, size_t r)
+{
+    const uint32_t* X = &B[(2 * r - 1) * 16];
 
-    for (i = 0; i < len; i++)
-        dest[i] = src[i];
+    return (((uint64_t)(X[13]) << 32) + X[0]);
 }
 
-static void blkxor(uint8_t* dest, uint8_t* src, size_t len)
+#else
+
+static void blkxor(uint32_t* dest, const uint32_t* src, size_t len)
 {
     size_t i;
 
-    for (i = 0; i < len; i++)
+    for (i = 0; i < len / 4; i++)
         dest[i] ^= src[i];
 }
 
@@ -89,19 +197,14 @@ static void blkxor(uint8_t* dest, uint8_t* src, size_t len)
  * salsa20_8(B):
  * Apply the salsa20/8 core to the provided block.
  */
-static void salsa20_8(uint8_t B[64])
+static void salsa20_8(uint32_t B[16])
 {
-    uint32_t B32[16];
     uint32_t x[16];
     size_t i;
 
-    /* Convert little-endian values in. */
-    for (i = 0; i < 16; i++)
-        B32[i] = le32dec(&B[i * 4]);
-
-    /* Compute x = doubleround^4(B32). */
+    /* Compute x = doubleround^4(B). */
     for (i = 0; i < 16; i++)
-        x[i] = B32[i];
+        x[i] = B[i];
     for (i = 0; i < 8; i += 2) {
 #define R(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
         /* Operate on columns. */
@@ -132,94 +235,133 @@ static void salsa20_8(uint8_t B[64])
 #undef R
     }
 
-    /* Compute B32 = B32 + x. */
+    /* Compute B = B + x. */
     for (i = 0; i < 16; i++)
-        B32[i] += x[i];
-
-    /* Convert little-endian values out. */
-    for (i = 0; i < 16; i++)
-        le32enc(&B[4 * i], B32[i]);
+        B[i] += x[i];
 }
 
 /**
- * blockmix_salsa8(B, Y, r):
- * Compute B = BlockMix_{salsa20/8, r}(B).  The input B must be 128r bytes in
- * length; the temporary space Y must also be the same size.
+ * blockmix_salsa8(Bin, Bout, Z, r):
+ * Compute Bout = BlockMix_{salsa20/8, r}(Bin).  The input Bin must be 128r
+ * bytes in length; the output Bout must also be the same size.  The
+ * temporary space Z must be 64 bytes.
  */
-static void blockmix_salsa8(uint8_t* B, uint8_t* Y, size_t r)
+static void blockmix_salsa8(const uint32_t* Bin, uint32_t* Bout,
+    uint32_t* Z, size_t r)
 {
-    uint8_t X[64];
     size_t i;
 
     /* 1: X <-- B_{2r - 1} */
-    blkcpy(X, &B[(2 * r - 1) * 64], 64);
+    blkcpy(Z, &Bin[(2 * r - 1) * 16], 64);
 
     /* 2: for i = 0 to 2r - 1 do */
     for (i = 0; i < 2 * r; i++) {
         /* 3: X <-- H(X \xor B_i) */
-        blkxor(X, &B[i * 64], 64);
-        salsa20_8(X);
+        blkxor(Z, &Bin[i * 16], 64);
+        salsa20_8(Z);
 
         /* 4: Y_i <-- X */
-        blkcpy(&Y[i * 64], X, 64);
+        /* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
+        blkcpy(&Bout[((i / 2) + (i & 1) * r) * 16], Z, 64);
     }
-
-    /* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
-    for (i = 0; i < r; i++)
-        blkcpy(&B[i * 64], &Y[(i * 2) * 64], 64);
-    for (i = 0; i < r; i++)
-        blkcpy(&B[(i + r) * 64], &Y[(i * 2 + 1) * 64], 64);
 }
 
 /**
  * integerify(B, r):
  * Return the result of parsing B_{2r-1} as a little-endian integer.
  */
-static uint64_t integerify(uint8_t* B, size_t r)
+static uint64_t integerify(const uint32_t* B, size_t r)
 {
-    uint8_t* X = &B[(2 * r - 1) * 64];
+    const uint32_t* X = &B[(2 * r - 1) * 16];
 
-    return (le64dec(X));
+    return (((uint64_t)(X[1]) << 32) + X[0]);
 }
 
-/**
- * smix(B, r, N, V, XY):
- * Compute B = SMix_r(B, N).  The input B must be 128r bytes in length; the
- * temporary storage V must be 128rN bytes in length; the temporary storage
- * XY must be 256r bytes in length.  The value N must be a power of 2.
- */
-static void smix(uint8_t* B, size_t r,
-    uint64_t N, uint8_t* V, uint8_t* XY)
+#endif
+
+size_t crypto_scrypt_scratch_size(uint64_t N, uint32_t r)
 {
-    uint8_t* X = XY;
-    uint8_t* Y = &XY[128 * r];
+    return (128 * r * (size_t)N + 256 * r + 64);
+}
+
+void crypto_scrypt_smix(uint8_t* B, uint32_t r, uint64_t N, void* scratch)
+{
+    uint32_t* V = (uint32_t*)scratch;
+    uint32_t* X = &V[32 * r * (size_t)N];
+    uint32_t* Y = &X[32 * r];
+    uint32_t* Z = &Y[32 * r];
     uint64_t i;
     uint64_t j;
+    size_t k;
 
     /* 1: X <-- B */
-    blkcpy(X, B, 128 * r);
+    for (k = 0; k < 32 * r; k++)
+        X[k] = le32dec(&B[4 * ((k & ~(size_t)15) + SCRYPT_WORD(k & 15))]);
 
     /* 2: for i = 0 to N - 1 do */
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += 2) {
         /* 3: V_i <-- X */
-        blkcpy(&V[i * (128 * r)], X, 128 * r);
+        blkcpy(&V[i * (32 * r)], X, 128 * r);
 
         /* 4: X <-- H(X) */
-        blockmix_salsa8(X, Y, r);
+        blockmix_salsa8(X, Y, Z, r);
+
+        /* 3: V_i <-- X */
+        blkcpy(&V[(i + 1) * (32 * r)], Y, 128 * r);
+
+        /* 4: X <-- H(X) */
+        blockmix_salsa8(Y, X, Z, r);
     }
 
     /* 6: for i = 0 to N - 1 do */
-    for (i = 0; i < N; i++) {
+    for (i = 0; i < N; i += 2) {
         /* 7: j <-- Integerify(X) mod N */
         j = integerify(X, r) & (N - 1);
 
         /* 8: X <-- H(X \xor V_j) */
-        blkxor(X, &V[j * (128 * r)], 128 * r);
-        blockmix_salsa8(X, Y, r);
+        blkxor(X, &V[j * (32 * r)], 128 * r);
+        blockmix_salsa8(X, Y, Z, r);
+
+        /* 7: j <-- Integerify(X) mod N */
+        j = integerify(Y, r) & (N - 1);
+
+        /* 8: X <-- H(X \xor V_j) */
+        blkxor(Y, &V[j * (32 * r)], 128 * r);
+        blockmix_salsa8(Y, X, Z, r);
     }
 
     /* 10: B' <-- X */
-    blkcpy(B, X, 128 * r);
+    for (k = 0; k < 32 * r; k++)
+        le32enc(&B[4 * ((k & ~(size_t)15) + SCRYPT_WORD(k & 15))], X[k]);
+}
+
+int crypto_scrypt_check(uint64_t N, uint32_t r, uint32_t p,
+    size_t buf_length)
+{
+#if SIZE_MAX > UINT32_MAX
+    if (buf_length > (((uint64_t)(1) << 32) - 1) * 32) {
+        errno = EFBIG;
+        return (-1);
+    }
+#endif
+    if ((uint64_t)(r) * (uint64_t)(p) >= (1 << 30)) {
+        errno = EFBIG;
+        return (-1);
+    }
+    if (((N & (N - 1)) != 0) || (N < 2) || (r == 0) || (p == 0)) {
+        errno = EINVAL;
+        return (-1);
+    }
+    if ((r > SIZE_MAX / 128 / p) ||
+#if SIZE_MAX / 256 <= UINT32_MAX
+        (r > (SIZE_MAX - 64) / 256) ||
+#endif
+        (N > (SIZE_MAX - 256 * (uint64_t)r - 64) / 128 / r)) {
+        errno = ENOMEM;
+        return (-1);
+    }
+
+    return (0);
 }
 
 /**
@@ -236,41 +378,18 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     uint32_t r, uint32_t p, uint8_t* buf, size_t buf_length)
 {
     uint8_t* B;
-    uint8_t* V;
-    uint8_t* XY;
+    void* scratch;
     uint32_t i;
 
     /* Sanity-check parameters. */
-#if SIZE_MAX > UINT32_MAX
-    if (buf_length > (((uint64_t)(1) << 32) - 1) * 32) {
-        errno = EFBIG;
+    if (crypto_scrypt_check(N, r, p, buf_length) != 0)
         goto err0;
-    }
-#endif
-    if ((uint64_t)(r) * (uint64_t)(p) >= (1 << 30)) {
-        errno = EFBIG;
-        goto err0;
-    }
-    if (((N & (N - 1)) != 0) || (N == 0)) {
-        errno = EINVAL;
-        goto err0;
-    }
-    if ((r > SIZE_MAX / 128 / p) ||
-#if SIZE_MAX / 256 <= UINT32_MAX
-        (r > SIZE_MAX / 256) ||
-#endif
-        (N > SIZE_MAX / 128 / r)) {
-        errno = ENOMEM;
-        goto err0;
-    }
 
     /* Allocate memory. */
     if ((B = malloc(128 * r * p)) == NULL)
         goto err0;
-    if ((XY = malloc(256 * r)) == NULL)
+    if ((scratch = malloc(crypto_scrypt_scratch_size(N, r))) == NULL)
         goto err1;
-    if ((V = malloc(128 * r * (size_t)N)) == NULL)
-        goto err2;
 
     /* 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen) */
     pbkdf2_sha256(passphrase, passphrase_length,
@@ -279,7 +398,7 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     /* 2: for i = 0 to p - 1 do */
     for (i = 0; i < p; i++) {
         /* 3: B_i <-- MF(B_i, N) */
-        smix(&B[i * 128 * r], r, N, V, XY);
+        crypto_scrypt_smix(&B[i * 128 * r], r, N, scratch);
     }
 
     /* 5: DK <-- PBKDF2(P, B, 1, dkLen) */
@@ -287,15 +406,12 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
         B, p * 128 * r, 1, buf, buf_length);
 
     /* Free memory. */
-    free(V);
-    free(XY);
+    free(scratch);
     free(B);
 
     /* Success! */
     return (0);
 
-  err2:
-    free(XY);
   err1:
     free(B);
   err0:
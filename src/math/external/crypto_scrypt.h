@@ -50,6 +50,31 @@ int crypto_scrypt(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint64_t N, uint32_t r,
     uint32_t p, uint8_t* buf, size_t buf_length);
 
+/**
+ * crypto_scrypt_check(N, r, p, buflen):
+ * Validate the parameters of crypto_scrypt, setting errno on failure.
+ *
+ * Return 0 on success; or -1 on error.
+ */
+int crypto_scrypt_check(uint64_t N, uint32_t r, uint32_t p,
+    size_t buf_length);
+
+/**
+ * crypto_scrypt_scratch_size(N, r):
+ * Return the size in bytes of the scratch space of crypto_scrypt_smix, for
+ * parameters accepted by crypto_scrypt_check.
+ */
+size_t crypto_scrypt_scratch_size(uint64_t N, uint32_t r);
+
+/**
+ * crypto_scrypt_smix(B, r, N, scratch):
+ * Compute B = SMix_r(B, N) for one of the p independent 128r byte lanes of
+ * crypto_scrypt.  The scratch space must be of crypto_scrypt_scratch_size
+ * and aligned as by malloc.  Lanes with distinct scratch may run in parallel
+ * and scratch may be reused across calls.
+ */
+void crypto_scrypt_smix(uint8_t* B, uint32_t r, uint64_t N, void* scratch);
+
 #ifdef __cplusplus
 }
 #endif
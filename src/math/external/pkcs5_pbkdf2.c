@@ -18,63 +18,243 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include <string.h>
 #include "hmac_sha512.h"
+#include "sha512.h"
+#include "sha512_simd.h"
 #include "zeroize.h"
 
+/* The passphrase is keyed into the hmac inner and outer midstates once, after
+ * which each hmac of an iteration compresses a single block from each. */
+
+#define PBKDF2_WORDS (SHA512_DIGEST_LENGTH / 8)
+
+static uint64_t be64dec(const uint8_t* p)
+{
+    return ((uint64_t)(p[7]) + ((uint64_t)(p[6]) << 8) +
+        ((uint64_t)(p[5]) << 16) + ((uint64_t)(p[4]) << 24) +
+        ((uint64_t)(p[3]) << 32) + ((uint64_t)(p[2]) << 40) +
+        ((uint64_t)(p[1]) << 48) + ((uint64_t)(p[0]) << 56));
+}
+
+static void be64enc(uint8_t* p, uint64_t x)
+{
+    p[7] = x & 0xff;
+    p[6] = (x >> 8) & 0xff;
+    p[5] = (x >> 16) & 0xff;
+    p[4] = (x >> 24) & 0xff;
+    p[3] = (x >> 32) & 0xff;
+    p[2] = (x >> 40) & 0xff;
+    p[1] = (x >> 48) & 0xff;
+    p[0] = (x >> 56) & 0xff;
+}
+
+/* Write up to a digest of the words to the key, returning the length. */
+static size_t pbkdf2_output(uint8_t* key, size_t key_length,
+    const uint64_t words[PBKDF2_WORDS], size_t stride)
+{
+    size_t index;
+    uint8_t buffer[SHA512_DIGEST_LENGTH];
+    const size_t length = (key_length < sizeof(buffer) ? key_length :
+        sizeof(buffer));
+
+    for (index = 0; index < PBKDF2_WORDS; index++)
+        be64enc(buffer + index * 8, words[index * stride]);
+
+    memcpy(key, buffer, length);
+    zeroize(buffer, sizeof(buffer));
+    return length;
+}
+
+/* The first hmac of the salt and block count, and the midstates of the key. */
+static void pbkdf2_start(uint64_t* digest, uint64_t* inner, uint64_t* outer,
+    size_t stride, const HMACSHA512CTX* keyed, const uint8_t* salt,
+    size_t salt_length, size_t count)
+{
+    size_t index;
+    HMACSHA512CTX context;
+    uint8_t hash[HMACSHA512_DIGEST_LENGTH];
+    uint8_t number[4];
+
+    number[0] = (count >> 24) & 0xff;
+    number[1] = (count >> 16) & 0xff;
+    number[2] = (count >> 8) & 0xff;
+    number[3] = (count >> 0) & 0xff;
+
+    context = *keyed;
+    HMACSHA512Update(&context, salt, salt_length);
+    HMACSHA512Update(&context, number, sizeof(number));
+    HMACSHA512Final(&context, hash);
+
+    for (index = 0; index < PBKDF2_WORDS; index++)
+    {
+        digest[index * stride] = be64dec(hash + index * 8);
+        inner[index * stride] = keyed->ictx.state[index];
+        outer[index * stride] = keyed->octx.state[index];
+    }
+
+    zeroize(hash, sizeof(hash));
+    zeroize(&context, sizeof(context));
+}
+
+/* The hmac of a 64 byte digest from the midstate, a single block of a 192
+ * byte message (the 128 byte key pad and the digest). */
+static void pbkdf2_hmac(uint64_t state[PBKDF2_WORDS],
+    const uint64_t digest[PBKDF2_WORDS], const uint64_t midstate[PBKDF2_WORDS],
+    uint8_t block[SHA512_BLOCK_LENGTH])
+{
+    size_t index;
+
+    for (index = 0; index < PBKDF2_WORDS; index++)
+        be64enc(block + index * 8, digest[index]);
+
+    memcpy(state, midstate, SHA512_DIGEST_LENGTH);
+    SHA512Transform(state, block);
+}
+
+static void pbkdf2_iterate(uint64_t result[PBKDF2_WORDS],
+    uint64_t digest[PBKDF2_WORDS], const uint64_t inner[PBKDF2_WORDS],
+    const uint64_t outer[PBKDF2_WORDS], size_t iterations)
+{
+    size_t index, iteration;
+    uint64_t state[PBKDF2_WORDS];
+    uint8_t block[SHA512_BLOCK_LENGTH];
+
+    /* The padding of a 192 byte message follows the digest. */
+    memset(block, 0, sizeof(block));
+    block[SHA512_DIGEST_LENGTH] = 0x80;
+    be64enc(block + SHA512_BLOCK_LENGTH - 8, 1536);
+
+    for (iteration = 1; iteration < iterations; iteration++)
+    {
+        pbkdf2_hmac(state, digest, inner, block);
+        pbkdf2_hmac(digest, state, outer, block);
+
+        for (index = 0; index < PBKDF2_WORDS; index++)
+            result[index] ^= digest[index];
+    }
+
+    zeroize(state, sizeof(state));
+    zeroize(block, sizeof(block));
+}
+
 int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint8_t* key, size_t key_length,
     size_t iterations)
 {
-    uint8_t* asalt;
-    size_t asalt_size;
-    size_t count, index, iteration, length;
-    uint8_t buffer[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest1[HMACSHA512_DIGEST_LENGTH];
-    uint8_t digest2[HMACSHA512_DIGEST_LENGTH];
+    size_t count, length;
+    HMACSHA512CTX keyed;
+    uint64_t digest[PBKDF2_WORDS];
+    uint64_t inner[PBKDF2_WORDS];
+    uint64_t outer[PBKDF2_WORDS];
+    uint64_t result[PBKDF2_WORDS];
 
     /* An iteration count of 0 is equivalent to a count of 1. */
     /* A key_length of 0 is a no-op. */
     /* A salt_length of 0 is perfectly valid. */
 
-    if (salt_length > SIZE_MAX - 4)
-        return -1;
-    asalt_size = salt_length + 4;
-    asalt = malloc(asalt_size);
-    if (asalt == NULL)
-        return -1;
+    HMACSHA512Init(&keyed, passphrase, passphrase_length);
 
-    memcpy(asalt, salt, salt_length);
     for (count = 1; key_length > 0; count++)
     {
-        asalt[salt_length + 0] = (count >> 24) & 0xff;
-        asalt[salt_length + 1] = (count >> 16) & 0xff;
-        asalt[salt_length + 2] = (count >> 8) & 0xff;
-        asalt[salt_length + 3] = (count >> 0) & 0xff;
-        HMACSHA512(asalt, asalt_size, passphrase, passphrase_length, digest1);
-        memcpy(buffer, digest1, sizeof(buffer));
-
-        for (iteration = 1; iteration < iterations; iteration++)
-        {
-            HMACSHA512(digest1, sizeof(digest1), passphrase, passphrase_length,
-                digest2);
-            memcpy(digest1, digest2, sizeof(digest1));
-            for (index = 0; index < sizeof(buffer); index++)
-                buffer[index] ^= digest1[index];
-        }
+        pbkdf2_start(digest, inner, outer, 1, &keyed, salt, salt_length,
+            count);
+        memcpy(result, digest, sizeof(result));
+        pbkdf2_iterate(result, digest, inner, outer, iterations);
 
-        length = (key_length < sizeof(buffer) ? key_length : sizeof(buffer));
-        memcpy(key, buffer, length);
+        length = pbkdf2_output(key, key_length, result, 1);
         key += length;
         key_length -= length;
-    };
+    }
 
-    zeroize(digest1, sizeof(digest1));
-    zeroize(digest2, sizeof(digest2));
-    zeroize(buffer, sizeof(buffer));
-    zeroize(asalt, asalt_size);
-    free(asalt);
+    zeroize(&keyed, sizeof(keyed));
+    zeroize(digest, sizeof(digest));
+    zeroize(inner, sizeof(inner));
+    zeroize(outer, sizeof(outer));
+    zeroize(result, sizeof(result));
 
     return 0;
 }
+
+#ifdef SHA256_X86
+
+/* Derive the keys of up to four candidates in the lanes of one kernel. Unused
+ * lanes repeat the last candidate and are discarded. */
+static void pbkdf2_lanes(const uint8_t* const* passphrases,
+    const size_t* passphrase_lengths, const uint8_t* const* salts,
+    const size_t* salt_lengths, uint8_t* keys, size_t key_length,
+    size_t iterations, size_t lanes)
+{
+    size_t lane, source, count, offset, length;
+    HMACSHA512CTX keyed[SHA512_LANES];
+    uint64_t digest[PBKDF2_WORDS * SHA512_LANES];
+    uint64_t inner[PBKDF2_WORDS * SHA512_LANES];
+    uint64_t outer[PBKDF2_WORDS * SHA512_LANES];
+    uint64_t result[PBKDF2_WORDS * SHA512_LANES];
+
+    for (lane = 0; lane < SHA512_LANES; lane++)
+    {
+        source = (lane < lanes ? lane : lanes - 1);
+        HMACSHA512Init(&keyed[lane], passphrases[source],
+            passphrase_lengths[source]);
+    }
+
+    for (count = 1, offset = 0; offset < key_length; count++)
+    {
+        for (lane = 0; lane < SHA512_LANES; lane++)
+        {
+            source = (lane < lanes ? lane : lanes - 1);
+            pbkdf2_start(digest + lane, inner + lane, outer + lane,
+                SHA512_LANES, &keyed[lane], salts[source],
+                salt_lengths[source], count);
+        }
+
+        memcpy(result, digest, sizeof(result));
+        SHA512PBKDF2AVX2(result, digest, inner, outer, iterations);
+
+        for (lane = 0, length = 0; lane < lanes; lane++)
+            length = pbkdf2_output(keys + lane * key_length + offset,
+                key_length - offset, result + lane, SHA512_LANES);
+
+        offset += length;
+    }
+
+    zeroize(keyed, sizeof(keyed));
+    zeroize(digest, sizeof(digest));
+    zeroize(inner, sizeof(inner));
+    zeroize(outer, sizeof(outer));
+    zeroize(result, sizeof(result));
+}
+
+#endif
+
+void pkcs5_pbkdf2_batch(const uint8_t* const* passphrases,
+    const size_t* passphrase_lengths, const uint8_t* const* salts,
+    const size_t* salt_lengths, uint8_t* keys, size_t key_length,
+    size_t iterations, size_t count)
+{
+    size_t candidate = 0;
+
+#ifdef SHA256_X86
+    size_t lanes;
+
+    /* Two or more candidates fill the lanes faster than the portable code. */
+    if (key_length > 0 && (SHA256Features() & SHA256_AVX2))
+    {
+        for (; count - candidate > 1; candidate += lanes)
+        {
+            lanes = count - candidate;
+            lanes = (lanes < SHA512_LANES ? lanes : SHA512_LANES);
+            pbkdf2_lanes(passphrases + candidate,
+                passphrase_lengths + candidate, salts + candidate,
+                salt_lengths + candidate, keys + candidate * key_length,
+                key_length, iterations, lanes);
+        }
+    }
+#endif
+
+    for (; candidate < count; candidate++)
+        pkcs5_pbkdf2(passphrases[candidate], passphrase_lengths[candidate],
+            salts[candidate], salt_lengths[candidate],
+            keys + candidate * key_length, key_length, iterations);
+}
@@ -33,6 +33,14 @@ int pkcs5_pbkdf2(const uint8_t* passphrase, size_t passphrase_length,
     const uint8_t* salt, size_t salt_length, uint8_t* key, size_t key_length,
     size_t iterations);
 
+/* Derive a key of key_length bytes for each of count passphrases, each with
+ * its own salt, to consecutive keys. Several candidates are derived at once
+ * where the cpu supports it. */
+void pkcs5_pbkdf2_batch(const uint8_t* const* passphrases,
+    const size_t* passphrase_lengths, const uint8_t* const* salts,
+    const size_t* salt_lengths, uint8_t* keys, size_t key_length,
+    size_t iterations, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
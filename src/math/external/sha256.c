@@ -27,8 +27,17 @@
 
 #include <stdint.h>
 #include <string.h>
+#include "sha256_simd.h"
 #include "zeroize.h"
 
+#ifdef SHA256_X86
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
 static uint32_t be32dec(const void* pp)
 {
     const uint8_t* p = (uint8_t const*)pp;
@@ -99,6 +108,120 @@ void SHA256Pad(SHA256CTX* context);
 void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
     const uint8_t block[SHA256_BLOCK_LENGTH]);
 
+#ifdef SHA256_X86
+
+static void cpuid(uint32_t leaf, uint32_t registers[4])
+{
+#ifdef _MSC_VER
+    int values[4];
+    __cpuidex(values, (int)leaf, 0);
+    registers[0] = (uint32_t)values[0];
+    registers[1] = (uint32_t)values[1];
+    registers[2] = (uint32_t)values[2];
+    registers[3] = (uint32_t)values[3];
+#else
+    __cpuid_count(leaf, 0, registers[0], registers[1], registers[2],
+        registers[3]);
+#endif
+}
+
+/* The operating system saves the xmm and ymm registers (avx state). */
+static int ymm_enabled(void)
+{
+#ifdef _MSC_VER
+    const uint64_t features = _xgetbv(0);
+#else
+    uint32_t low, high;
+    __asm__ __volatile__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    const uint64_t features = ((uint64_t)high << 32) | low;
+#endif
+    return (features & 6) == 6;
+}
+
+static int detect_features(void)
+{
+    int features = 0;
+    uint32_t registers[4];
+
+    cpuid(0, registers);
+    const uint32_t maximum = registers[0];
+
+    if (maximum < 1)
+        return features;
+
+    cpuid(1, registers);
+    const int osxsave = (registers[2] >> 27) & 1;
+
+    if ((registers[2] >> 19) & 1)
+        features |= SHA256_SSE41;
+
+    if (maximum < 7)
+        return features;
+
+    cpuid(7, registers);
+
+    if (((registers[1] >> 5) & 1) && osxsave && ymm_enabled())
+        features |= SHA256_AVX2;
+
+    if (((registers[1] >> 29) & 1) && (features & SHA256_SSE41))
+        features |= SHA256_SHANI;
+
+    return features;
+}
+
+/* The mask is shared by all threads, so it is loaded and stored atomically.
+ * Detection is idempotent, so a race to initialize stores the same value. */
+#ifdef _MSC_VER
+    #define FEATURES_LOAD(value) _InterlockedOr(&(value), 0)
+    #define FEATURES_STORE(value, set) _InterlockedExchange(&(value), (set))
+#else
+    #define FEATURES_LOAD(value) __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+    #define FEATURES_STORE(value, set) \
+        __atomic_store_n(&(value), (set), __ATOMIC_RELEASE)
+#endif
+
+static volatile long features = -1;
+
+int SHA256Features(void)
+{
+    long mask = FEATURES_LOAD(features);
+
+    if (mask < 0)
+    {
+        mask = detect_features();
+        FEATURES_STORE(features, mask);
+    }
+
+    return (int)mask;
+}
+
+int SHA256RestrictFeatures(int mask)
+{
+    const long restricted = detect_features() & mask;
+    FEATURES_STORE(features, restricted);
+    return (int)restricted;
+}
+
+#endif
+
+/* Compress consecutive blocks using the fastest available implementation. */
+static void SHA256Blocks(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t* blocks, size_t count)
+{
+#ifdef SHA256_X86
+    if (SHA256Features() & SHA256_SHANI)
+    {
+        SHA256TransformSHANI(state, blocks, count);
+        return;
+    }
+#endif
+
+    for (; count > 0; count--, blocks += SHA256_BLOCK_LENGTH)
+    {
+        SHA256Transform(state, blocks);
+    }
+}
+
 void SHA256_(const uint8_t* input, size_t length,
     uint8_t digest[SHA256_DIGEST_LENGTH])
 {
@@ -144,17 +267,14 @@ void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length)
     }
 
     memcpy(&context->buf[r], input, 64 - r);
-    SHA256Transform(context->state, context->buf);
+    SHA256Blocks(context->state, context->buf, 1);
 
     input += 64 - r;
     length -= 64 - r;
 
-    while (length >= 64)
-    {
-        SHA256Transform(context->state, input);
-        input += 64;
-        length -= 64;
-    }
+    SHA256Blocks(context->state, input, length / 64);
+    input += length & ~(size_t)63;
+    length &= 63;
 
     memcpy(context->buf, input, length);
 }
@@ -166,6 +286,70 @@ void SHA256Final(SHA256CTX* context, uint8_t digest[SHA256_DIGEST_LENGTH])
     zeroize((void*)context, sizeof *context);
 }
 
+void SHA256D64(uint8_t* output, const uint8_t* input, size_t blocks)
+{
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+
+#ifdef SHA256_X86
+    const int features = SHA256Features();
+
+    if (features & SHA256_AVX2)
+    {
+        for (; blocks >= 8; blocks -= 8, input += 8 * 64, output += 8 * 32)
+        {
+            SHA256D64AVX2(output, input);
+        }
+    }
+
+    /* The sha extensions outperform four sse lanes. */
+    if ((features & SHA256_SSE41) && !(features & SHA256_SHANI))
+    {
+        for (; blocks >= 4; blocks -= 4, input += 4 * 64, output += 4 * 32)
+        {
+            SHA256D64SSE41(output, input);
+        }
+    }
+#endif
+
+    for (; blocks > 0; blocks--, input += 64, output += 32)
+    {
+        SHA256_(input, 64, hash);
+        SHA256_(hash, SHA256_DIGEST_LENGTH, output);
+    }
+}
+
+void SHA256D80(uint8_t* output, const uint8_t* input, size_t count)
+{
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+
+#ifdef SHA256_X86
+    const int features = SHA256Features();
+
+    if (features & SHA256_AVX2)
+    {
+        for (; count >= 8; count -= 8, input += 8 * 80, output += 8 * 32)
+        {
+            SHA256D80AVX2(output, input);
+        }
+    }
+
+    /* The sha extensions outperform four sse lanes. */
+    if ((features & SHA256_SSE41) && !(features & SHA256_SHANI))
+    {
+        for (; count >= 4; count -= 4, input += 4 * 80, output += 4 * 32)
+        {
+            SHA256D80SSE41(output, input);
+        }
+    }
+#endif
+
+    for (; count > 0; count--, input += 80, output += 32)
+    {
+        SHA256_(input, 80, hash);
+        SHA256_(hash, SHA256_DIGEST_LENGTH, output);
+    }
+}
+
 /* Local */
 
 void SHA256Pad(SHA256CTX* context)
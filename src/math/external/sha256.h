@@ -53,6 +53,12 @@ void SHA256Init(SHA256CTX* context);
 void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length);
 void SHA256Final(SHA256CTX* context, uint8_t digest[SHA256_DIGEST_LENGTH]);
 
+/* Double sha256 of each of the 64 byte input blocks to 32 byte outputs. */
+void SHA256D64(uint8_t* output, const uint8_t* input, size_t blocks);
+
+/* Double sha256 of each of the 80 byte inputs to 32 byte outputs. */
+void SHA256D80(uint8_t* output, const uint8_t* input, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
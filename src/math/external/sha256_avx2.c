@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256_simd.h"
+
+#ifdef SHA256_X86
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+/* 8 lane sha256 of 64 or 80 byte messages, each lane an independent message. */
+
+#define AVX2 SHA256_TARGET("avx2")
+#define LANES 8
+
+typedef __m256i lane;
+
+static const uint32_t K256[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t IV256[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static uint32_t be32dec(const uint8_t* p)
+{
+    return ((uint32_t)(p[3]) + ((uint32_t)(p[2]) << 8) +
+        ((uint32_t)(p[1]) << 16) + ((uint32_t)(p[0]) << 24));
+}
+
+static void be32enc(uint8_t* p, uint32_t x)
+{
+    p[3] = x & 0xff;
+    p[2] = (x >> 8) & 0xff;
+    p[1] = (x >> 16) & 0xff;
+    p[0] = (x >> 24) & 0xff;
+}
+
+AVX2 static lane set(uint32_t x) { return _mm256_set1_epi32((int)x); }
+AVX2 static lane add(lane x, lane y) { return _mm256_add_epi32(x, y); }
+AVX2 static lane land(lane x, lane y) { return _mm256_and_si256(x, y); }
+AVX2 static lane lor(lane x, lane y) { return _mm256_or_si256(x, y); }
+AVX2 static lane lxor(lane x, lane y) { return _mm256_xor_si256(x, y); }
+AVX2 static lane shr(lane x, int n) { return _mm256_srli_epi32(x, n); }
+AVX2 static lane shl(lane x, int n) { return _mm256_slli_epi32(x, n); }
+
+AVX2 static lane rotr(lane x, int n)
+{
+    return lor(shr(x, n), shl(x, 32 - n));
+}
+
+AVX2 static lane ch(lane x, lane y, lane z)
+{
+    return lxor(z, land(x, lxor(y, z)));
+}
+
+AVX2 static lane maj(lane x, lane y, lane z)
+{
+    return lor(land(x, y), land(z, lor(x, y)));
+}
+
+AVX2 static lane S0(lane x)
+{
+    return lxor(rotr(x, 2), lxor(rotr(x, 13), rotr(x, 22)));
+}
+
+AVX2 static lane S1(lane x)
+{
+    return lxor(rotr(x, 6), lxor(rotr(x, 11), rotr(x, 25)));
+}
+
+AVX2 static lane s0(lane x)
+{
+    return lxor(rotr(x, 7), lxor(rotr(x, 18), shr(x, 3)));
+}
+
+AVX2 static lane s1(lane x)
+{
+    return lxor(rotr(x, 17), lxor(rotr(x, 19), shr(x, 10)));
+}
+
+/* Compress one block per lane into the lane states, consuming the schedule. */
+AVX2 static void transform(lane state[8], lane w[16])
+{
+    int i;
+    lane t1, t2;
+    lane a = state[0], b = state[1], c = state[2], d = state[3];
+    lane e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (i = 0; i < 64; i++)
+    {
+        if (i >= 16)
+        {
+            w[i & 15] = add(add(s1(w[(i - 2) & 15]), w[(i - 7) & 15]),
+                add(s0(w[(i - 15) & 15]), w[i & 15]));
+        }
+
+        t1 = add(add(add(h, S1(e)), add(ch(e, f, g), set(K256[i]))),
+            w[i & 15]);
+        t2 = add(S0(a), maj(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, t2);
+    }
+
+    state[0] = add(state[0], a);
+    state[1] = add(state[1], b);
+    state[2] = add(state[2], c);
+    state[3] = add(state[3], d);
+    state[4] = add(state[4], e);
+    state[5] = add(state[5], f);
+    state[6] = add(state[6], g);
+    state[7] = add(state[7], h);
+}
+
+/* Gather the big endian word at offset of each lane's message, where the
+ * messages are consecutive at the stride. */
+AVX2 static lane load(const uint8_t* input, size_t stride,
+    size_t offset)
+{
+    return _mm256_set_epi32(
+        (int)be32dec(input + 7 * stride + offset),
+        (int)be32dec(input + 6 * stride + offset),
+        (int)be32dec(input + 5 * stride + offset),
+        (int)be32dec(input + 4 * stride + offset),
+        (int)be32dec(input + 3 * stride + offset),
+        (int)be32dec(input + 2 * stride + offset),
+        (int)be32dec(input + 1 * stride + offset),
+        (int)be32dec(input + 0 * stride + offset));
+}
+
+AVX2 static void initialize(lane state[8])
+{
+    int i;
+    for (i = 0; i < 8; i++)
+    {
+        state[i] = set(IV256[i]);
+    }
+}
+
+/* Second hash of each lane's first hash state, stored as consecutive
+ * digests. */
+AVX2 static void finalize(uint8_t* output, const lane state[8])
+{
+    int i, j;
+    lane hash[8];
+    lane w[16];
+    uint32_t words[LANES];
+
+    /* Single block of a 32 byte message. */
+    for (i = 0; i < 8; i++)
+    {
+        w[i] = state[i];
+    }
+
+    w[8] = set(0x80000000);
+    for (i = 9; i < 15; i++)
+    {
+        w[i] = set(0);
+    }
+
+    w[15] = set(256);
+    initialize(hash);
+    transform(hash, w);
+
+    for (i = 0; i < 8; i++)
+    {
+        _mm256_storeu_si256((__m256i*)words, hash[i]);
+
+        for (j = 0; j < LANES; j++)
+        {
+            be32enc(output + j * 32 + i * 4, words[j]);
+        }
+    }
+}
+
+AVX2 void SHA256D64AVX2(uint8_t* output, const uint8_t* input)
+{
+    int i;
+    lane state[8];
+    lane w[16];
+
+    /* First hash, message block. */
+    for (i = 0; i < 16; i++)
+    {
+        w[i] = load(input, 64, (size_t)i * 4);
+    }
+
+    initialize(state);
+    transform(state, w);
+
+    /* First hash, padding block of a 64 byte message. */
+    w[0] = set(0x80000000);
+    for (i = 1; i < 15; i++)
+    {
+        w[i] = set(0);
+    }
+
+    w[15] = set(512);
+    transform(state, w);
+    finalize(output, state);
+}
+
+AVX2 void SHA256D80AVX2(uint8_t* output, const uint8_t* input)
+{
+    int i;
+    lane state[8];
+    lane w[16];
+
+    /* First hash, first message block. */
+    for (i = 0; i < 16; i++)
+    {
+        w[i] = load(input, 80, (size_t)i * 4);
+    }
+
+    initialize(state);
+    transform(state, w);
+
+    /* First hash, last 16 bytes and padding of an 80 byte message. */
+    for (i = 0; i < 4; i++)
+    {
+        w[i] = load(input, 80, 64 + (size_t)i * 4);
+    }
+
+    w[4] = set(0x80000000);
+    for (i = 5; i < 15; i++)
+    {
+        w[i] = set(0);
+    }
+
+    w[15] = set(640);
+    transform(state, w);
+    finalize(output, state);
+}
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha256_simd.h"
+
+#ifdef SHA256_X86
+
+#include <stdint.h>
+#include <immintrin.h>
+
+/* Single message sha256 compression using the x86 sha extensions. */
+
+#define SHANI SHA256_TARGET("sha,sse4.1")
+
+static const uint32_t K256[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+SHANI void SHA256TransformSHANI(uint32_t state[8], const uint8_t* blocks,
+    size_t count)
+{
+    int group;
+    __m128i state0, state1, abef, cdgh, message, temp;
+    __m128i schedule[4];
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+        0x0405060700010203ULL);
+
+    /* Reorder the state words into the ABEF and CDGH form of the rounds. */
+    temp = _mm_loadu_si128((const __m128i*)&state[0]);
+    state1 = _mm_loadu_si128((const __m128i*)&state[4]);
+    temp = _mm_shuffle_epi32(temp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    state0 = _mm_alignr_epi8(temp, state1, 8);
+    state1 = _mm_blend_epi16(state1, temp, 0xf0);
+
+    for (; count > 0; count--, blocks += 64)
+    {
+        abef = state0;
+        cdgh = state1;
+
+        /* Each group is four rounds and four words of the schedule. */
+        for (group = 0; group < 16; group++)
+        {
+            __m128i* const words = &schedule[group & 3];
+
+            if (group < 4)
+            {
+                message = _mm_loadu_si128(
+                    (const __m128i*)(blocks + group * 16));
+                *words = _mm_shuffle_epi8(message, mask);
+            }
+            else
+            {
+                const __m128i last = schedule[(group + 3) & 3];
+                const __m128i prior = schedule[(group + 2) & 3];
+                temp = _mm_sha256msg1_epu32(*words, schedule[(group + 1) & 3]);
+                temp = _mm_add_epi32(temp, _mm_alignr_epi8(last, prior, 4));
+                *words = _mm_sha256msg2_epu32(temp, last);
+            }
+
+            message = _mm_add_epi32(*words,
+                _mm_loadu_si128((const __m128i*)&K256[group * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+            message = _mm_shuffle_epi32(message, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, message);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    /* Restore the state words to ABCD and EFGH order. */
+    temp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(temp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, temp, 8);
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+#endif
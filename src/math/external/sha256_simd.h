@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SHA256_SIMD_H
+#define LIBBITCOIN_SHA256_SIMD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Accelerated sha256 kernels, selected at runtime by cpu feature detection.
+ * These are internal to sha256.c, which falls back to the portable code. The
+ * detected features also select the sha512 kernels of sha512_simd.h. */
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86)
+    #define SHA256_X86
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define SHA256_TARGET(features) __attribute__((target(features)))
+#else
+    #define SHA256_TARGET(features)
+#endif
+
+#define SHA256_SSE41 1
+#define SHA256_AVX2 2
+#define SHA256_SHANI 4
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef SHA256_X86
+
+/* The SHA256_* flags of the features supported by the cpu and os. */
+int SHA256Features(void);
+
+/* Restrict the features to those in the mask, intersected with those that are
+ * supported, returning the result. This allows each kernel to be tested. */
+int SHA256RestrictFeatures(int mask);
+
+/* Compress the number of 64 byte blocks into the state (sha extensions). */
+void SHA256TransformSHANI(uint32_t state[8], const uint8_t* blocks,
+    size_t count);
+
+/* Double sha256 of 4 consecutive 64 byte inputs to 4 consecutive digests. */
+void SHA256D64SSE41(uint8_t* output, const uint8_t* input);
+
+/* Double sha256 of 4 consecutive 80 byte inputs to 4 consecutive digests. */
+void SHA256D80SSE41(uint8_t* output, const uint8_t* input);
+
+/* Double sha256 of 8 consecutive 64 byte inputs to 8 consecutive digests. */
+void SHA256D64AVX2(uint8_t* output, const uint8_t* input);
+
+/* Double sha256 of 8 consecutive 80 byte inputs to 8 consecutive digests. */
+void SHA256D80AVX2(uint8_t* output, const uint8_t* input);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
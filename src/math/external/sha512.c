@@ -106,8 +106,6 @@ static unsigned char PAD[SHA512_BLOCK_LENGTH] =
 };
 
 void SHA512Pad(SHA512CTX* context);
-void SHA512Transform(uint64_t state[SHA512_STATE_LENGTH],
-    const uint8_t block[SHA512_BLOCK_LENGTH]);
 
 void SHA512_(const uint8_t* input, size_t length,
     uint8_t digest[SHA512_DIGEST_LENGTH])
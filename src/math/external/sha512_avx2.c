@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "sha512_simd.h"
+
+#ifdef SHA256_X86
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+/* 4 lane sha512 of hmac blocks, each lane an independent pbkdf2 candidate. */
+
+#define AVX2 SHA256_TARGET("avx2")
+
+typedef __m256i lane;
+
+static const uint64_t K512[80] =
+{
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+AVX2 static lane set(uint64_t x) { return _mm256_set1_epi64x((long long)x); }
+AVX2 static lane add(lane x, lane y) { return _mm256_add_epi64(x, y); }
+AVX2 static lane land(lane x, lane y) { return _mm256_and_si256(x, y); }
+AVX2 static lane lor(lane x, lane y) { return _mm256_or_si256(x, y); }
+AVX2 static lane lxor(lane x, lane y) { return _mm256_xor_si256(x, y); }
+AVX2 static lane shr(lane x, int n) { return _mm256_srli_epi64(x, n); }
+AVX2 static lane shl(lane x, int n) { return _mm256_slli_epi64(x, n); }
+
+AVX2 static lane rotr(lane x, int n)
+{
+    return lor(shr(x, n), shl(x, 64 - n));
+}
+
+AVX2 static lane ch(lane x, lane y, lane z)
+{
+    return lxor(z, land(x, lxor(y, z)));
+}
+
+AVX2 static lane maj(lane x, lane y, lane z)
+{
+    return lor(land(x, y), land(z, lor(x, y)));
+}
+
+AVX2 static lane S0(lane x)
+{
+    return lxor(rotr(x, 28), lxor(rotr(x, 34), rotr(x, 39)));
+}
+
+AVX2 static lane S1(lane x)
+{
+    return lxor(rotr(x, 14), lxor(rotr(x, 18), rotr(x, 41)));
+}
+
+AVX2 static lane s0(lane x)
+{
+    return lxor(rotr(x, 1), lxor(rotr(x, 8), shr(x, 7)));
+}
+
+AVX2 static lane s1(lane x)
+{
+    return lxor(rotr(x, 19), lxor(rotr(x, 61), shr(x, 6)));
+}
+
+/* Compress one block per lane into the lane states, consuming the schedule. */
+AVX2 static void transform(lane state[8], lane w[16])
+{
+    int i;
+    lane t1, t2;
+    lane a = state[0], b = state[1], c = state[2], d = state[3];
+    lane e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (i = 0; i < 80; i++)
+    {
+        if (i >= 16)
+        {
+            w[i & 15] = add(add(s1(w[(i - 2) & 15]), w[(i - 7) & 15]),
+                add(s0(w[(i - 15) & 15]), w[i & 15]));
+        }
+
+        t1 = add(add(add(h, S1(e)), add(ch(e, f, g), set(K512[i]))),
+            w[i & 15]);
+        t2 = add(S0(a), maj(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, t2);
+    }
+
+    state[0] = add(state[0], a);
+    state[1] = add(state[1], b);
+    state[2] = add(state[2], c);
+    state[3] = add(state[3], d);
+    state[4] = add(state[4], e);
+    state[5] = add(state[5], f);
+    state[6] = add(state[6], g);
+    state[7] = add(state[7], h);
+}
+
+AVX2 static void load(lane words[8], const uint64_t* input)
+{
+    int i;
+    for (i = 0; i < 8; i++)
+    {
+        words[i] = _mm256_loadu_si256((const __m256i*)(input + i * 4));
+    }
+}
+
+AVX2 static void store(uint64_t* output, const lane words[8])
+{
+    int i;
+    for (i = 0; i < 8; i++)
+    {
+        _mm256_storeu_si256((__m256i*)(output + i * 4), words[i]);
+    }
+}
+
+/* The hmac of a 64 byte digest from the midstate, a single block of a 192
+ * byte message (the 128 byte key pad and the digest). */
+AVX2 static void hmac(lane state[8], const lane digest[8],
+    const lane midstate[8])
+{
+    int i;
+    lane w[16];
+
+    for (i = 0; i < 8; i++)
+    {
+        w[i] = digest[i];
+        state[i] = midstate[i];
+    }
+
+    w[8] = set(0x8000000000000000ULL);
+    for (i = 9; i < 15; i++)
+    {
+        w[i] = set(0);
+    }
+
+    w[15] = set(1536);
+    transform(state, w);
+}
+
+AVX2 void SHA512PBKDF2AVX2(uint64_t result[32], uint64_t digest[32],
+    const uint64_t inner[32], const uint64_t outer[32], size_t iterations)
+{
+    int i;
+    size_t iteration;
+    lane sum[8], hash[8], state[8], istate[8], ostate[8];
+
+    load(sum, result);
+    load(hash, digest);
+    load(istate, inner);
+    load(ostate, outer);
+
+    for (iteration = 1; iteration < iterations; iteration++)
+    {
+        hmac(state, hash, istate);
+        hmac(hash, state, ostate);
+
+        for (i = 0; i < 8; i++)
+        {
+            sum[i] = lxor(sum[i], hash[i]);
+        }
+    }
+
+    store(result, sum);
+    store(digest, hash);
+}
+
+#endif
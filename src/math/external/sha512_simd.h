@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SHA512_SIMD_H
+#define LIBBITCOIN_SHA512_SIMD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sha256_simd.h"
+
+/* Accelerated sha512 kernels, selected at runtime by the features detected for
+ * sha256. These are internal to pkcs5_pbkdf2.c, which falls back to the
+ * portable code. */
+
+#define SHA512_LANES 4
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef SHA256_X86
+
+/* Continue pbkdf2-hmac-sha512 of 4 independent lanes over the remaining
+ * iterations. Inner and outer are the hmac midstates of each lane, digest is
+ * the previous hmac and result accumulates the xor of all hmacs. All words
+ * interleave the lanes as [word * 4 + lane]. */
+void SHA512PBKDF2AVX2(uint64_t result[32], uint64_t digest[32],
+    const uint64_t inner[32], const uint64_t outer[32], size_t iterations);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,18 +20,24 @@
 #include <bitcoin/bitcoin/math/hash.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <errno.h>
 #include <new>
 #include <stdexcept>
+#include <vector>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include "../math/external/crypto_scrypt.h"
 #include "../math/external/hmac_sha256.h"
 #include "../math/external/hmac_sha512.h"
+#include "../math/external/pbkdf2_sha256.h"
 #include "../math/external/pkcs5_pbkdf2.h"
 #include "../math/external/ripemd160.h"
 #include "../math/external/sha1.h"
 #include "../math/external/sha256.h"
+#include "../math/external/sha256_simd.h"
 #include "../math/external/sha512.h"
 
 namespace libbitcoin {
@@ -102,16 +108,251 @@ long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     return hash;
 }
 
+long_hash_list pkcs5_pbkdf2_hmac_sha512(const data_stack& passphrases,
+    const data_stack& salts, size_t iterations, size_t threads)
+{
+    const auto size = passphrases.size();
+    if (size == 0 || salts.size() != size)
+        return{};
+
+    std::vector<const uint8_t*> passphrase_data(size);
+    std::vector<const uint8_t*> salt_data(size);
+    std::vector<size_t> passphrase_sizes(size);
+    std::vector<size_t> salt_sizes(size);
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        passphrase_data[index] = passphrases[index].data();
+        passphrase_sizes[index] = passphrases[index].size();
+        salt_data[index] = salts[index].data();
+        salt_sizes[index] = salts[index].size();
+    }
+
+    data_chunk keys(size * long_hash_size);
+
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        pkcs5_pbkdf2_batch(&passphrase_data[begin], &passphrase_sizes[begin],
+            &salt_data[begin], &salt_sizes[begin],
+            &keys[begin * long_hash_size], long_hash_size, iterations,
+            end - begin);
+    };
+
+    parallel_for(threads, size, derive);
+
+    long_hash_list hashes(size);
+    for (size_t index = 0; index < size; ++index)
+        std::copy_n(&keys[index * long_hash_size], long_hash_size,
+            hashes[index].begin());
+
+    return hashes;
+}
+
 hash_digest bitcoin_hash(data_slice data)
 {
     return sha256_hash(sha256_hash(data));
 }
 
+uint32_t hash_kernels()
+{
+#ifdef SHA256_X86
+    return static_cast<uint32_t>(SHA256Features());
+#else
+    return portable_kernels;
+#endif
+}
+
+uint32_t restrict_hash_kernels(uint32_t mask)
+{
+#ifdef SHA256_X86
+    static_assert(sse41_kernels == SHA256_SSE41 &&
+        avx2_kernels == SHA256_AVX2 && shani_kernels == SHA256_SHANI,
+        "kernel flags differ");
+
+    return static_cast<uint32_t>(SHA256RestrictFeatures(
+        static_cast<int>(mask & all_kernels)));
+#else
+    return portable_kernels;
+#endif
+}
+
+// Hashes are contiguous in the list, so pairs are contiguous 64 byte blocks.
+void bitcoin_hash_pairs(hash_list& out, const hash_list& hashes)
+{
+    static_assert(sizeof(hash_digest) == hash_size, "unexpected padding");
+    BITCOIN_ASSERT(hashes.size() % 2 == 0);
+
+    const auto pairs = hashes.size() / 2;
+    out.resize(pairs);
+
+    SHA256D64(reinterpret_cast<uint8_t*>(out.data()),
+        reinterpret_cast<const uint8_t*>(hashes.data()), pairs);
+}
+
+void bitcoin_hash_headers(hash_list& out, data_slice headers)
+{
+    static constexpr size_t header_size = 80;
+    BITCOIN_ASSERT(headers.size() % header_size == 0);
+
+    const auto count = headers.size() / header_size;
+    out.resize(count);
+
+    SHA256D80(reinterpret_cast<uint8_t*>(out.data()), headers.data(), count);
+}
+
 short_hash bitcoin_short_hash(data_slice data)
 {
     return ripemd160_hash(sha256_hash(data));
 }
 
+static inline uint32_t rotate_left(uint32_t value, uint8_t bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// MurmurHash3 (x86_32) by Austin Appleby, in the public domain.
+uint32_t murmur3_hash(data_slice data, uint32_t seed)
+{
+    static constexpr uint32_t c1 = 0xcc9e2d51;
+    static constexpr uint32_t c2 = 0x1b873593;
+
+    const auto size = data.size();
+    const auto blocks = size / 4;
+    const auto bytes = data.data();
+    auto hash = seed;
+
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const auto chunk = &bytes[block * 4];
+        auto k1 = static_cast<uint32_t>(chunk[0]) |
+            (static_cast<uint32_t>(chunk[1]) << 8) |
+            (static_cast<uint32_t>(chunk[2]) << 16) |
+            (static_cast<uint32_t>(chunk[3]) << 24);
+
+        k1 *= c1;
+        k1 = rotate_left(k1, 15);
+        k1 *= c2;
+
+        hash ^= k1;
+        hash = rotate_left(hash, 13);
+        hash = hash * 5 + 0xe6546b64;
+    }
+
+    const auto tail = &bytes[blocks * 4];
+    uint32_t k1 = 0;
+
+    switch (size & 3)
+    {
+        case 3:
+            k1 ^= static_cast<uint32_t>(tail[2]) << 16;
+            // fallthrough
+        case 2:
+            k1 ^= static_cast<uint32_t>(tail[1]) << 8;
+            // fallthrough
+        case 1:
+            k1 ^= tail[0];
+            k1 *= c1;
+            k1 = rotate_left(k1, 15);
+            k1 *= c2;
+            hash ^= k1;
+    }
+
+    hash ^= static_cast<uint32_t>(size);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static inline uint64_t rotate_left64(uint64_t value, uint8_t bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t load_little_endian64(const uint8_t* bytes)
+{
+    uint64_t value = 0;
+
+    for (size_t byte = 0; byte < 8; ++byte)
+        value |= static_cast<uint64_t>(bytes[byte]) << (8 * byte);
+
+    return value;
+}
+
+// The siphash state, initialized from the key.
+struct sip_state
+{
+    sip_state(uint64_t k0, uint64_t k1)
+      : v0(0x736f6d6570736575ull ^ k0), v1(0x646f72616e646f6dull ^ k1),
+        v2(0x6c7967656e657261ull ^ k0), v3(0x7465646279746573ull ^ k1)
+    {
+    }
+
+    void round()
+    {
+        v0 += v1; v1 = rotate_left64(v1, 13); v1 ^= v0;
+        v0 = rotate_left64(v0, 32);
+        v2 += v3; v3 = rotate_left64(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotate_left64(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotate_left64(v1, 17); v1 ^= v2;
+        v2 = rotate_left64(v2, 32);
+    }
+
+    void compress(uint64_t word)
+    {
+        v3 ^= word;
+        round();
+        round();
+        v0 ^= word;
+    }
+
+    uint64_t finalize()
+    {
+        v2 ^= 0xff;
+        round();
+        round();
+        round();
+        round();
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+
+    uint64_t v0, v1, v2, v3;
+};
+
+// SipHash-2-4 by Jean-Philippe Aumasson and Daniel J. Bernstein.
+uint64_t siphash(uint64_t k0, uint64_t k1, data_slice data)
+{
+    sip_state state(k0, k1);
+    const auto size = data.size();
+    const auto words = size / 8;
+    const auto bytes = data.data();
+
+    for (size_t word = 0; word < words; ++word)
+        state.compress(load_little_endian64(&bytes[word * 8]));
+
+    // The final word holds the remaining bytes and the size in its top byte.
+    auto last = static_cast<uint64_t>(size) << 56;
+
+    for (size_t byte = 0; byte < size % 8; ++byte)
+        last |= static_cast<uint64_t>(bytes[words * 8 + byte]) << (8 * byte);
+
+    state.compress(last);
+    return state.finalize();
+}
+
+uint64_t siphash(uint64_t k0, uint64_t k1, const hash_digest& hash)
+{
+    sip_state state(k0, k1);
+    state.compress(load_little_endian64(&hash[0]));
+    state.compress(load_little_endian64(&hash[8]));
+    state.compress(load_little_endian64(&hash[16]));
+    state.compress(load_little_endian64(&hash[24]));
+    state.compress(static_cast<uint64_t>(hash_size) << 56);
+    return state.finalize();
+}
+
 static void handle_script_result(int result)
 {
     if (result == 0)
@@ -140,4 +381,63 @@ data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
     return output;
 }
 
+// Mix the lanes in place, divided among the workers, each of which uses its
+// own consecutive scratch space of the given size.
+static void scrypt_mix(uint8_t* lanes, uint64_t N, uint32_t p, uint32_t r,
+    uint8_t* scratch, size_t scratch_size, size_t workers)
+{
+    const auto lane_size = 128 * static_cast<size_t>(r);
+    std::atomic<size_t> next(0);
+
+    // There is at most one range per worker, each claims its working space.
+    const auto mix = [&](size_t begin, size_t end)
+    {
+        const auto space = scratch + next++ * scratch_size;
+
+        for (auto lane = begin; lane < end; ++lane)
+            crypto_scrypt_smix(lanes + lane * lane_size, r, N, space);
+    };
+
+    parallel_for(workers, p, mix);
+}
+
+// The scratch holds the lanes followed by the working space of each worker.
+static data_chunk scrypt_lanes(data_slice data, data_slice salt, uint64_t N,
+    uint32_t p, uint32_t r, size_t length, data_chunk& scratch,
+    size_t workers)
+{
+    handle_script_result(crypto_scrypt_check(N, r, p, length));
+    const auto lanes_size = 128 * static_cast<size_t>(r) * p;
+    const auto scratch_size = crypto_scrypt_scratch_size(N, r);
+    const auto size = lanes_size + workers * scratch_size;
+
+    if (scratch.size() < size)
+        scratch.resize(size);
+
+    const auto lanes = scratch.data();
+    pbkdf2_sha256(data.data(), data.size(), salt.data(), salt.size(), 1,
+        lanes, lanes_size);
+
+    scrypt_mix(lanes, N, p, r, lanes + lanes_size, scratch_size, workers);
+
+    data_chunk output(length);
+    pbkdf2_sha256(data.data(), data.size(), lanes, lanes_size, 1,
+        output.data(), output.size());
+    return output;
+}
+
+data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
+    uint32_t r, size_t length, data_chunk& scratch)
+{
+    return scrypt_lanes(data, salt, N, p, r, length, scratch, 1);
+}
+
+data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
+    uint32_t r, size_t length, size_t threads)
+{
+    const auto workers = std::max(std::min(threads, size_t(p)), size_t(1));
+    data_chunk scratch;
+    return scrypt_lanes(data, salt, N, p, r, length, scratch, workers);
+}
+
 } // namespace libbitcoin
@@ -146,5 +146,10 @@ bool hash_number::operator<=(const hash_number& value) const
     return hash_.CompareTo(value.hash_) <= 0;
 }
 
+bool hash_number::is_met_by(const hash_digest& hash) const
+{
+    return hash_.CompareTo(hash.data()) >= 0;
+}
+
 } // namespace libbitcoin
 
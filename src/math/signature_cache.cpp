@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+// About 3MB of keys, more than the signatures of a full block and its pool.
+const size_t signature_cache::default_capacity = 100000;
+
+signature_cache::signature_cache(size_t capacity)
+  : capacity_(capacity), hits_(0), misses_(0)
+{
+}
+
+// The entry is the hash of its parts, so fixed in size and not forgeable.
+hash_digest signature_cache::key(data_slice point, const hash_digest& hash,
+    const ec_signature& signature)
+{
+    return sha256_hash(build_chunk({ point, hash, signature }));
+}
+
+bool signature_cache::contains(data_slice point, const hash_digest& hash,
+    const ec_signature& signature) const
+{
+    const auto entry = key(point, hash, signature);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    const auto found = entries_.find(entry) != entries_.end();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (found)
+        ++hits_;
+    else
+        ++misses_;
+
+    return found;
+}
+
+void signature_cache::store(data_slice point, const hash_digest& hash,
+    const ec_signature& signature)
+{
+    if (capacity_ == 0)
+        return;
+
+    const auto entry = key(point, hash, signature);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (!entries_.insert(entry).second)
+        return;
+
+    order_.push(entry);
+
+    if (order_.size() > capacity_)
+    {
+        entries_.erase(order_.front());
+        order_.pop();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void signature_cache::clear()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    entries_.clear();
+    order_ = std::queue<hash_digest>();
+    hits_ = 0;
+    misses_ = 0;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t signature_cache::capacity() const
+{
+    return capacity_;
+}
+
+size_t signature_cache::size() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return entries_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+uint64_t signature_cache::hits() const
+{
+    return hits_;
+}
+
+uint64_t signature_cache::misses() const
+{
+    return misses_;
+}
+
+} // namespace libbitcoin
@@ -20,6 +20,32 @@ base_uint<BITS>::base_uint(const std::vector<unsigned char>& vch)
     memcpy(pn, &vch[0], sizeof(pn));
 }
 
+// Return the low 64 bits of a * b + add + carry, setting high to the rest.
+// The result cannot overflow 128 bits.
+static inline uint64_t multiply_add(uint64_t a, uint64_t b, uint64_t add,
+    uint64_t carry, uint64_t& high)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128_t;
+    const uint128_t n = (uint128_t)a * b + add + carry;
+    high = (uint64_t)(n >> 64);
+    return (uint64_t)n;
+#else
+    const uint64_t a0 = a & 0xffffffff, a1 = a >> 32;
+    const uint64_t b0 = b & 0xffffffff, b1 = b >> 32;
+    const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const uint64_t middle = (p00 >> 32) + (p01 & 0xffffffff) +
+        (p10 & 0xffffffff);
+    uint64_t low = (middle << 32) | (p00 & 0xffffffff);
+    high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+    low += add;
+    high += (low < add ? 1 : 0);
+    low += carry;
+    high += (low < carry ? 1 : 0);
+    return low;
+#endif
+}
+
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator<<=(unsigned int shift)
 {
@@ -27,15 +53,14 @@ base_uint<BITS>& base_uint<BITS>::operator<<=(unsigned int shift)
     for (int i = 0; i < WIDTH; i++)
         pn[i] = 0;
 
-    int k = shift / 32;
-    shift = shift % 32;
-    for (int i = 0; i < WIDTH; i++)
+    int k = shift / 64;
+    shift = shift % 64;
+    for (int i = 0; i + k < WIDTH; i++)
     {
         if (i + k + 1 < WIDTH && shift != 0)
-            pn[i + k + 1] |= (a.pn[i] >> (32 - shift));
+            pn[i + k + 1] |= (a.pn[i] >> (64 - shift));
 
-        if (i + k < WIDTH)
-            pn[i + k] |= (a.pn[i] << shift);
+        pn[i + k] |= (a.pn[i] << shift);
     }
 
     return *this;
@@ -48,15 +73,14 @@ base_uint<BITS>& base_uint<BITS>::operator>>=(unsigned int shift)
     for (int i = 0; i < WIDTH; i++)
         pn[i] = 0;
 
-    int k = shift / 32;
-    shift = shift % 32;
-    for (int i = 0; i < WIDTH; i++)
+    int k = shift / 64;
+    shift = shift % 64;
+    for (int i = k; i < WIDTH; i++)
     {
         if (i - k - 1 >= 0 && shift != 0)
-            pn[i - k - 1] |= (a.pn[i] << (32 - shift));
+            pn[i - k - 1] |= (a.pn[i] << (64 - shift));
 
-        if (i - k >= 0)
-            pn[i - k] |= (a.pn[i] >> shift);
+        pn[i - k] |= (a.pn[i] >> shift);
     }
 
     return *this;
@@ -67,11 +91,7 @@ base_uint<BITS>& base_uint<BITS>::operator*=(uint32_t b32)
 {
     uint64_t carry = 0;
     for (int i = 0; i < WIDTH; i++)
-    {
-        uint64_t n = carry + (uint64_t)b32 * pn[i];
-        pn[i] = n & 0xffffffff;
-        carry = n >> 32;
-    }
+        pn[i] = multiply_add(pn[i], b32, 0, carry, carry);
 
     return *this;
 }
@@ -85,11 +105,8 @@ base_uint<BITS>& base_uint<BITS>::operator*=(const base_uint& b)
     {
         uint64_t carry = 0;
         for (int i = 0; i + j < WIDTH; i++)
-        {
-            uint64_t n = carry + pn[i + j] + (uint64_t)a.pn[j] * b.pn[i];
-            pn[i + j] = n & 0xffffffff;
-            carry = n >> 32;
-        }
+            pn[i + j] = multiply_add(a.pn[j], b.pn[i], pn[i + j], carry,
+                carry);
     }
 
     return *this;
@@ -116,6 +133,25 @@ base_uint<BITS>& base_uint<BITS>::operator/=(const base_uint& b)
     if (div_bits > num_bits)
         return *this;
 
+#ifdef __SIZEOF_INT128__
+    // A single limb divisor (such as a retarget timespan) is divided limb by
+    // limb from the top, carrying the remainder.
+    if (div_bits <= 64)
+    {
+        __extension__ typedef unsigned __int128 uint128_t;
+        const uint64_t divisor = div.pn[0];
+        uint64_t remainder = 0;
+        for (int i = WIDTH - 1; i >= 0; i--)
+        {
+            const uint128_t n = ((uint128_t)remainder << 64) | num.pn[i];
+            pn[i] = (uint64_t)(n / divisor);
+            remainder = (uint64_t)(n % divisor);
+        }
+
+        return *this;
+    }
+#endif
+
     int shift = num_bits - div_bits;
 
     // shift so that div and nun align.
@@ -128,7 +164,7 @@ base_uint<BITS>& base_uint<BITS>::operator/=(const base_uint& b)
             num -= div;
 
             // set a bit of the result.
-            pn[shift / 32] |= (1 << (shift & 31));
+            pn[shift / 64] |= ((uint64_t)1 << (shift & 63));
         }
 
         // shift back.
@@ -155,20 +191,34 @@ int base_uint<BITS>::CompareTo(const base_uint<BITS>& b) const
     return 0;
 }
 
+template <unsigned int BITS>
+int base_uint<BITS>::CompareTo(const unsigned char* little_endian) const
+{
+    // Limbs are assembled from bytes, so this is independent of alignment.
+    for (int i = WIDTH - 1; i >= 0; i--)
+    {
+        uint64_t limb = 0;
+        for (int byte = 7; byte >= 0; byte--)
+            limb = (limb << 8) | little_endian[8 * i + byte];
+
+        if (pn[i] < limb)
+            return -1;
+
+        if (pn[i] > limb)
+            return 1;
+    }
+
+    return 0;
+}
+
 template <unsigned int BITS>
 bool base_uint<BITS>::EqualTo(uint64_t b) const
 {
-    for (int i = WIDTH - 1; i >= 2; i--)
+    for (int i = WIDTH - 1; i >= 1; i--)
         if (pn[i] != 0)
             return false;
 
-    if (pn[1] != (b >> 32))
-        return false;
-
-    if (pn[0] != (b & 0xfffffffful))
-        return false;
-
-    return true;
+    return pn[0] == b;
 }
 
 template <unsigned int BITS>
@@ -178,11 +228,11 @@ unsigned int base_uint<BITS>::bits() const
     {
         if (pn[pos] != 0)
         {
-            for (int bits = 31; bits > 0; bits--)
-                if ((pn[pos] & 1 << bits) != 0)
-                    return 32 * pos + bits + 1;
+            unsigned int bits = 1;
+            for (uint64_t limb = pn[pos] >> 1; limb != 0; limb >>= 1)
+                bits++;
 
-            return 32 * pos + 1;
+            return 64 * pos + bits;
         }
     }
 
@@ -197,6 +247,7 @@ template base_uint<256>& base_uint<256>::operator*=(uint32_t b32);
 template base_uint<256>& base_uint<256>::operator*=(const base_uint<256>& b);
 template base_uint<256>& base_uint<256>::operator/=(const base_uint<256>& b);
 template int base_uint<256>::CompareTo(const base_uint<256>&) const;
+template int base_uint<256>::CompareTo(const unsigned char*) const;
 template bool base_uint<256>::EqualTo(uint64_t) const;
 template unsigned int base_uint<256>::bits() const;
 
@@ -230,32 +281,19 @@ uint32_t uint256_t::GetCompact(bool fNegative) const
     return nCompact;
 }
 
-// This implementation directly uses shifts instead of going
+// This implementation directly decodes limbs instead of going
 // through an intermediate MPI representation.
 uint256_t& uint256_t::SetCompact(uint32_t nCompact, bool* pfNegative, 
     bool* pfOverflow)
 {
-    int nSize = nCompact >> 24;
-    uint32_t nWord = nCompact & 0x007fffff;
-
-    if (nSize <= 3) 
-    {
-        nWord >>= 8 * (3 - nSize);
-        *this = nWord;
-    }
-    else 
-    {
-        *this = nWord;
-        *this <<= 8 * (nSize - 3);
-    }
+    for (int i = 0; i < WIDTH; i++)
+        pn[i] = compact_limb(nCompact, i);
 
     if (pfNegative != nullptr)
-        *pfNegative = nWord != 0 && (nCompact & 0x00800000) != 0;
+        *pfNegative = is_negative_compact(nCompact);
 
     if (pfOverflow != nullptr)
-        *pfOverflow = nWord != 0 && ((nSize > 34) ||
-        (nWord > 0xff && nSize > 33) ||
-        (nWord > 0xffff && nSize > 32));
+        *pfOverflow = is_overflow_compact(nCompact);
 
     return *this;
 }
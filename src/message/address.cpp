@@ -23,9 +23,9 @@
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -93,8 +93,8 @@ void address::reset()
 
 bool address::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    slice_reader source(data);
+    return from_data(version, source);
 }
 
 bool address::from_data(uint32_t version, std::istream& stream)
@@ -22,9 +22,9 @@
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -165,8 +165,8 @@ void alert_payload::reset()
 
 bool alert_payload::from_data(uint32_t version, const data_chunk& data)
 {
-    boost::iostreams::stream<byte_source<data_chunk>> istream(data);
-    return from_data(version, istream);
+    slice_reader source(data);
+    return from_data(version, source);
 }
 
 bool alert_payload::from_data(uint32_t version, std::istream& stream)
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/script/operation.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/filter_add.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::chain;
+
+const size_t bloom_filter::max_filter_size = 36000;
+const uint32_t bloom_filter::max_hash_functions = 50;
+const size_t bloom_filter::max_element_size = 520;
+
+// The multiplier of the function number in each murmur3 seed (bip37).
+static constexpr uint32_t seed_multiplier = 0xfba4c795;
+
+// The point is serialized as its hash followed by its little endian index.
+static byte_array<36> to_point_data(const hash_digest& hash, uint32_t index)
+{
+    byte_array<36> out;
+    build_array(out, { hash, to_little_endian(index) });
+    return out;
+}
+
+bloom_filter::bloom_filter()
+  : filter_(), hash_functions_(0), tweak_(0), flags_(update_none),
+    full_(true), empty_(false)
+{
+}
+
+bloom_filter::bloom_filter(const filter_load& load)
+  : bloom_filter()
+{
+    this->load(load);
+}
+
+// The filter is sized for the rate, within the bip37 limits.
+bloom_filter::bloom_filter(size_t elements, double false_positive_rate,
+    uint32_t tweak, uint8_t flags)
+  : tweak_(tweak), flags_(flags), full_(false), empty_(true)
+{
+    static const auto ln2 = std::log(2.0);
+    const auto count = std::max(elements, size_t(1));
+    const auto bits = -1.0 / (ln2 * ln2) * count *
+        std::log(false_positive_rate);
+    const auto limit = static_cast<double>(max_filter_size * 8);
+    const auto bytes = static_cast<size_t>(std::min(bits, limit) / 8);
+    const auto functions = static_cast<double>(bytes * 8) / count * ln2;
+
+    filter_.resize(std::max(bytes, size_t(1)), 0x00);
+    hash_functions_ = static_cast<uint32_t>(std::min(functions,
+        static_cast<double>(max_hash_functions)));
+}
+
+const data_chunk& bloom_filter::filter() const
+{
+    return filter_;
+}
+
+uint32_t bloom_filter::hash_functions() const
+{
+    return hash_functions_;
+}
+
+uint32_t bloom_filter::tweak() const
+{
+    return tweak_;
+}
+
+uint8_t bloom_filter::flags() const
+{
+    return flags_;
+}
+
+bool bloom_filter::is_valid() const
+{
+    return filter_.size() <= max_filter_size &&
+        hash_functions_ <= max_hash_functions;
+}
+
+void bloom_filter::load(const filter_load& load)
+{
+    filter_ = load.filter();
+    hash_functions_ = load.hash_functions();
+    tweak_ = load.tweak();
+    flags_ = load.flags();
+    update_state();
+}
+
+bool bloom_filter::add(const filter_add& add)
+{
+    if (add.data().size() > max_element_size)
+        return false;
+
+    insert(add.data());
+    return true;
+}
+
+void bloom_filter::clear()
+{
+    filter_.clear();
+    filter_.shrink_to_fit();
+    hash_functions_ = 0;
+    tweak_ = 0;
+    flags_ = update_none;
+    full_ = true;
+    empty_ = false;
+}
+
+// A filter of all zero bits matches nothing, of all one bits everything.
+// Any other filter cannot become either by insertion, so this is not rerun.
+void bloom_filter::update_state()
+{
+    const auto zero = [](uint8_t byte) { return byte == 0x00; };
+    const auto one = [](uint8_t byte) { return byte == 0xff; };
+    full_ = std::all_of(filter_.begin(), filter_.end(), one);
+    empty_ = std::all_of(filter_.begin(), filter_.end(), zero);
+}
+
+uint32_t bloom_filter::bit_index(uint32_t function, data_slice element) const
+{
+    const auto seed = function * seed_multiplier + tweak_;
+    const auto bits = static_cast<uint32_t>(filter_.size() * 8);
+    return murmur3_hash(element, seed) % bits;
+}
+
+void bloom_filter::insert(data_slice element)
+{
+    if (full_ || filter_.empty())
+        return;
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto index = bit_index(function, element);
+        filter_[index >> 3] |= (1 << (index & 7));
+    }
+
+    empty_ = false;
+}
+
+void bloom_filter::insert(const point& point)
+{
+    insert(to_point_data(point.hash(), point.index()));
+}
+
+bool bloom_filter::contains(data_slice element) const
+{
+    if (full_)
+        return true;
+
+    if (empty_)
+        return false;
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto index = bit_index(function, element);
+
+        if ((filter_[index >> 3] & (1 << (index & 7))) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool bloom_filter::contains(const point& point) const
+{
+    return contains(to_point_data(point.hash(), point.index()));
+}
+
+// The transaction matches on its hash, any data pushed by one of its output
+// scripts, any of its previous output points, or any data pushed by one of
+// its input scripts. Output matches are tested first, for all outputs, so
+// that each matched output is inserted into the filter as directed.
+bool bloom_filter::match(const transaction& tx)
+{
+    if (full_)
+        return true;
+
+    if (empty_)
+        return false;
+
+    const auto hash = tx.hash();
+    auto found = contains(hash);
+    const auto update = flags_ & update_mask;
+    const auto& outputs = tx.outputs();
+
+    for (uint32_t index = 0; index < outputs.size(); ++index)
+    {
+        const auto& script = outputs[index].script();
+
+        for (const auto& op: script.operations())
+        {
+            const auto& data = op.data();
+
+            if (data.empty() || !contains(data))
+                continue;
+
+            found = true;
+
+            if (update == update_all)
+                insert(to_point_data(hash, index));
+            else if (update == update_pay_public_key_only)
+            {
+                const auto pattern = script.pattern();
+
+                if (pattern == script_pattern::pay_public_key ||
+                    pattern == script_pattern::pay_multisig)
+                    insert(to_point_data(hash, index));
+            }
+
+            break;
+        }
+    }
+
+    if (found)
+        return true;
+
+    for (const auto& input: tx.inputs())
+    {
+        if (contains(input.previous_output()))
+            return true;
+
+        for (const auto& op: input.script().operations())
+        {
+            const auto& data = op.data();
+
+            if (!data.empty() && contains(data))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+filter_load bloom_filter::to_filter_load() const
+{
+    return{ filter_, hash_functions_, tweak_, flags_ };
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -19,14 +19,18 @@
  */
 #include <bitcoin/bitcoin/message/compact_block.hpp>
 
+#include <algorithm>
 #include <initializer_list>
 #include <boost/iostreams/stream.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -59,6 +63,15 @@ compact_block compact_block::factory_from_data(uint32_t version,
     return instance;
 }
 
+compact_block::short_id compact_block::to_short_id(const short_id_key& key,
+    const hash_digest& hash)
+{
+    const auto sip = to_little_endian(siphash(key.k0, key.k1, hash));
+    short_id out;
+    std::copy(sip.begin(), sip.begin() + out.size(), out.begin());
+    return out;
+}
+
 compact_block::compact_block()
   : header_(), nonce_(0), short_ids_(), transactions_()
 {
@@ -79,6 +92,23 @@ compact_block::compact_block(chain::header&& header, uint64_t nonce,
 {
 }
 
+compact_block::compact_block(const chain::block& block, uint64_t nonce)
+  : header_(block.header()), nonce_(nonce), short_ids_(), transactions_()
+{
+    const auto& txs = block.transactions();
+
+    if (txs.empty())
+        return;
+
+    // The coinbase cannot be in any pool, so it is always sent in full.
+    transactions_.emplace_back(0, txs.front());
+    short_ids_.reserve(txs.size() - 1);
+    const auto key = to_short_id_key();
+
+    for (auto tx = txs.begin() + 1; tx != txs.end(); ++tx)
+        short_ids_.push_back(to_short_id(key, tx->hash()));
+}
+
 compact_block::compact_block(const compact_block& other)
   : compact_block(other.header_, other.nonce_, other.short_ids_,
       other.transactions_)
@@ -108,8 +138,8 @@ void compact_block::reset()
 
 bool compact_block::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    slice_reader source(data);
+    return from_data(version, source);
 }
 
 bool compact_block::from_data(uint32_t version, std::istream& stream)
@@ -200,6 +230,16 @@ uint64_t compact_block::serialized_size(uint32_t version) const
     return size;
 }
 
+compact_block::short_id_key compact_block::to_short_id_key() const
+{
+    auto data = header_.to_data(false);
+    extend_data(data, to_little_endian(nonce_));
+    const auto hash = sha256_hash(data);
+    const auto k0 = from_little_endian_unsafe<uint64_t>(hash.begin());
+    const auto k1 = from_little_endian_unsafe<uint64_t>(hash.begin() + 8);
+    return { k0, k1 };
+}
+
 chain::header& compact_block::header()
 {
     return header_;
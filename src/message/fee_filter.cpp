@@ -22,9 +22,9 @@
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -81,8 +81,8 @@ fee_filter::fee_filter(fee_filter&& other)
 
 bool fee_filter::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    slice_reader source(data);
+    return from_data(version, source);
 }
 
 bool fee_filter::from_data(uint32_t version, std::istream& stream)
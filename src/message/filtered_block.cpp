@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/filtered_block.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
+#include <bitcoin/bitcoin/message/merkle_block.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::chain;
+
+hash_list filtered_block::to_hashes(const chain::block& block)
+{
+    hash_list hashes;
+    hashes.reserve(block.transactions().size());
+
+    for (const auto& tx: block.transactions())
+        hashes.push_back(tx.hash());
+
+    return hashes;
+}
+
+filtered_block::filtered_block(const chain::block& block)
+  : block_(block), tree_(to_hashes(block))
+{
+    // Parse each script once, so that matches share the operations.
+    for (const auto& tx: block_.transactions())
+    {
+        for (const auto& output: tx.outputs())
+            output.script().operations();
+
+        for (const auto& input: tx.inputs())
+            input.script().operations();
+    }
+}
+
+const chain::block& filtered_block::block() const
+{
+    return block_;
+}
+
+merkle_block filtered_block::match(bloom_filter& filter,
+    indexes& matches) const
+{
+    const auto& txs = block_.transactions();
+    matches.clear();
+
+    // Matches are in block order, as filter updates depend upon the order.
+    for (size_t position = 0; position < txs.size(); ++position)
+        if (filter.match(txs[position]))
+            matches.push_back(position);
+
+    return{ block_.header(), tree_, matches };
+}
+
+void filtered_block::match(merkle_block::list& out,
+    std::vector<indexes>& matches, const bloom_filter::ptr_list& filters,
+    size_t threads) const
+{
+    const auto size = filters.size();
+    out.resize(size);
+    matches.resize(size);
+
+    // Results are set by position, so that threads may set distinct elements.
+    const auto match_range = [&](size_t begin, size_t end)
+    {
+        for (auto position = begin; position < end; ++position)
+        {
+            BITCOIN_ASSERT(filters[position]);
+            out[position] = match(*filters[position], matches[position]);
+        }
+    };
+
+    parallel_for(threads, size, match_range);
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/framer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/checksum.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include "../math/bitcoin_hash_buffer.hpp"
+
+namespace libbitcoin {
+namespace message {
+
+// The checksum is the first four bytes of the payload bitcoin hash.
+static uint32_t to_checksum(const hash_digest& hash)
+{
+    return from_little_endian_unsafe<uint32_t>(hash.begin());
+}
+
+framer::framer(uint32_t magic, uint32_t version, handler handle)
+  : magic_(magic), version_(version), handle_(std::move(handle)),
+    failed_(false), reading_payload_(false),
+    heading_data_(heading::maximum_size()), heading_fill_(0),
+    payload_fill_(0), hasher_(new bitcoin_hash_buffer)
+{
+}
+
+// Defined here where bitcoin_hash_buffer is complete.
+framer::~framer()
+{
+}
+
+uint32_t framer::version() const
+{
+    return version_;
+}
+
+void framer::set_version(uint32_t value)
+{
+    version_ = value;
+}
+
+size_t framer::pending() const
+{
+    return reading_payload_ ? heading_.payload_size() - payload_fill_ :
+        heading_data_.size() - heading_fill_;
+}
+
+void framer::reset()
+{
+    failed_ = false;
+    reading_payload_ = false;
+    heading_.reset();
+    heading_fill_ = 0;
+    payload_fill_ = 0;
+    hasher_->reset();
+}
+
+code framer::fail()
+{
+    failed_ = true;
+    return error::bad_stream;
+}
+
+code framer::write(const data_slice data)
+{
+    if (failed_)
+        return error::bad_stream;
+
+    auto it = data.begin();
+    const auto end = data.end();
+
+    while (it != end)
+    {
+        const auto ec = reading_payload_ ? read_payload(it, end) :
+            read_heading(it, end);
+
+        if (ec)
+            return ec;
+    }
+
+    return error::success;
+}
+
+code framer::read_heading(const uint8_t*& it, const uint8_t* end)
+{
+    const auto needed = heading_data_.size() - heading_fill_;
+    const auto size = std::min(needed, static_cast<size_t>(end - it));
+    std::copy(it, it + size, heading_data_.begin() + heading_fill_);
+    heading_fill_ += size;
+    it += size;
+
+    if (heading_fill_ < heading_data_.size())
+        return error::success;
+
+    // The payload is not buffered until the heading is known to be valid.
+    heading_fill_ = 0;
+    slice_reader source(heading_data_);
+
+    if (!heading_.from_data(source) || heading_.magic() != magic_ ||
+        heading_.payload_size() > heading::maximum_payload_size(version_))
+        return fail();
+
+    const size_t payload_size = heading_.payload_size();
+    const auto available = static_cast<size_t>(end - it);
+
+    // Dispatch directly from the written chunk if it holds the full payload.
+    if (available >= payload_size)
+    {
+        const data_slice payload(it, it + payload_size);
+        it += payload_size;
+        return complete(payload, bitcoin_checksum(payload));
+    }
+
+    // The buffer retains its capacity across messages.
+    payload_.resize(payload_size);
+    payload_fill_ = 0;
+    hasher_->reset();
+    reading_payload_ = true;
+    return error::success;
+}
+
+code framer::read_payload(const uint8_t*& it, const uint8_t* end)
+{
+    const auto needed = payload_.size() - payload_fill_;
+    const auto size = std::min(needed, static_cast<size_t>(end - it));
+    std::copy(it, it + size, payload_.begin() + payload_fill_);
+
+    // Hash as the payload arrives so completion does not rescan it.
+    hasher_->sputn(reinterpret_cast<const char*>(&payload_[payload_fill_]),
+        size);
+
+    payload_fill_ += size;
+    it += size;
+
+    if (payload_fill_ < payload_.size())
+        return error::success;
+
+    reading_payload_ = false;
+    return complete(payload_, to_checksum(hasher_->digest()));
+}
+
+code framer::complete(const data_slice payload, uint32_t checksum)
+{
+    if (checksum != heading_.checksum() || !handle_(heading_, payload))
+        return fail();
+
+    return error::success;
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -20,19 +20,24 @@
 #include <bitcoin/bitcoin/message/headers.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
 #include <utility>
+#include <vector>
 #include <boost/iostreams/stream.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -109,8 +114,8 @@ void headers::reset()
 
 bool headers::from_data(uint32_t version, const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(version, istream);
+    slice_reader source(data);
+    return from_data(version, source);
 }
 
 bool headers::from_data(uint32_t version, std::istream& stream)
@@ -170,15 +175,56 @@ void headers::to_data(uint32_t version, writer& sink) const
         element.to_data(sink, true);
 }
 
+// Headers are serialized contiguously, so that they hash in parallel lanes.
 void headers::to_hashes(hash_list& out) const
 {
-    const auto map = [](const chain::header& header)
+    const auto header_size = chain::header::
+        satoshi_fixed_size_without_transaction_count();
+
+    data_chunk data;
+    data.reserve(elements_.size() * header_size);
+    data_sink ostream(data);
+    ostream_writer sink(ostream);
+
+    for (const auto& header: elements_)
+        header.to_data(sink, false);
+
+    ostream.flush();
+    bitcoin_hash_headers(out, data);
+}
+
+code headers::check(size_t& index, size_t threads) const
+{
+    const auto size = elements_.size();
+    hash_list hashes;
+    to_hashes(hashes);
+
+    // Results are set by position, so that threads may set distinct elements.
+    std::vector<code> results(size, error::success);
+
+    const auto check = [&](size_t begin, size_t end)
     {
-        return header.hash();
+        for (auto position = begin; position < end; ++position)
+        {
+            const auto& header = elements_[position];
+
+            if (!header.is_valid_proof_of_work(hashes[position]))
+                results[position] = error::invalid_proof_of_work;
+            else if (!header.is_valid_time_stamp())
+                results[position] = error::futuristic_timestamp;
+            else if (position > 0 &&
+                header.previous_block_hash() != hashes[position - 1])
+                results[position] = error::orphan;
+        }
     };
 
-    out.resize(elements_.size());
-    std::transform(elements_.begin(), elements_.end(), out.begin(), map);
+    parallel_for(threads, size, check);
+
+    for (index = 0; index < size; ++index)
+        if (results[index])
+            return results[index];
+
+    return error::success;
 }
 
 void headers::to_inventory(inventory_vector::list& out,
@@ -19,14 +19,17 @@
  */
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <boost/iostreams/stream.hpp>
+#include <bitcoin/bitcoin/chain/merkle_tree.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -77,6 +80,15 @@ merkle_block::merkle_block(chain::header&& header, hash_list&& hashes,
 {
 }
 
+merkle_block::merkle_block(const chain::header& header,
+    const chain::merkle_tree& tree,
+    const chain::merkle_tree::indexes& positions)
+  : header_(header), hashes_(), flags_()
+{
+    header_.set_transaction_count(tree.size());
+    tree.partial(hashes_, flags_, positions);
+}
+
 merkle_block::merkle_block(const merkle_block& other)
   : merkle_block(other.header_, other.hashes_, other.flags_)
 {
@@ -104,8 +116,8 @@ void merkle_block::reset()
 
 bool merkle_block::from_data(uint32_t version, const data_chunk& data)
 {
-    boost::iostreams::stream<byte_source<data_chunk>> istream(data);
-    return from_data(version, istream);
+    slice_reader source(data);
+    return from_data(version, source);
 }
 
 bool merkle_block::from_data(uint32_t version, std::istream& stream)
@@ -249,6 +261,24 @@ void merkle_block::set_flags(data_chunk&& value)
     flags_ = std::move(value);
 }
 
+bool merkle_block::extract(hash_list& matches,
+    chain::merkle_tree::indexes& positions) const
+{
+    // An oversized count is rejected by extract, so saturate here.
+    const auto count = std::min(header_.transaction_count(),
+        uint64_t(max_size_t));
+    const auto leaves = static_cast<size_t>(count);
+    const auto root = chain::merkle_tree::extract(matches, positions, leaves,
+        hashes_, flags_);
+
+    if (root != null_hash && root == header_.merkle())
+        return true;
+
+    matches.clear();
+    positions.clear();
+    return false;
+}
+
 merkle_block& merkle_block::operator=(merkle_block&& other)
 {
     header_ = std::move(other.header_);
@@ -21,9 +21,9 @@
 
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -92,8 +92,8 @@ void network_address::reset()
 bool network_address::from_data(uint32_t version,
     const data_chunk& data, bool with_timestamp)
 {
-    data_source istream(data);
-    return from_data(version, istream, with_timestamp);
+    slice_reader source(data);
+    return from_data(version, source, with_timestamp);
 }
 
 bool network_address::from_data(uint32_t version,
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/partial_block.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/compact_block.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
+#include <bitcoin/bitcoin/message/transaction_message.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::chain;
+
+// A transaction cannot be smaller than 60 bytes.
+static constexpr size_t max_transactions = max_block_size / 60;
+
+uint64_t partial_block::to_number(const compact_block::short_id& id)
+{
+    uint64_t value = 0;
+
+    for (size_t byte = 0; byte < id.size(); ++byte)
+        value |= static_cast<uint64_t>(id[byte]) << (8 * byte);
+
+    return value;
+}
+
+partial_block::partial_block(const compact_block& block)
+  : valid_(false), missing_(0), header_(block.header()),
+    hash_(header_.hash()), key_(block.to_short_id_key())
+{
+    valid_ = populate(block);
+
+    if (valid_)
+        return;
+
+    missing_ = 0;
+    transactions_.clear();
+    positions_.clear();
+}
+
+bool partial_block::populate(const compact_block& block)
+{
+    const auto& short_ids = block.short_ids();
+    const auto& prefilled = block.transactions();
+    const auto count = short_ids.size() + prefilled.size();
+
+    if (count == 0 || count > max_transactions)
+        return false;
+
+    transactions_.resize(count);
+
+    // Prefilled indexes are differentially encoded, in ascending order.
+    uint64_t next = 0;
+
+    for (const auto& tx: prefilled)
+    {
+        if (tx.index() >= count - next)
+            return false;
+
+        const auto index = static_cast<size_t>(next + tx.index());
+        transactions_[index] = std::make_shared<const transaction>(
+            tx.transaction());
+        next = index + 1;
+    }
+
+    // Short ids are assigned in order to the positions not prefilled.
+    positions_.reserve(short_ids.size());
+    auto id = short_ids.begin();
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        if (transactions_[index])
+            continue;
+
+        // Duplicate short ids cannot be resolved, request the full block.
+        if (!positions_.emplace(to_number(*id++), index).second)
+            return false;
+    }
+
+    missing_ = short_ids.size();
+    return true;
+}
+
+bool partial_block::is_valid() const
+{
+    return valid_;
+}
+
+bool partial_block::is_complete() const
+{
+    return valid_ && missing_ == 0;
+}
+
+size_t partial_block::missing() const
+{
+    return missing_;
+}
+
+size_t partial_block::fill(const transaction_message::const_ptr_list& pool)
+{
+    const auto start = missing_;
+
+    for (const auto& tx: pool)
+    {
+        if (positions_.empty())
+            break;
+
+        const auto hash = tx->hash();
+        const auto id = to_number(compact_block::to_short_id(key_, hash));
+        const auto position = positions_.find(id);
+
+        if (position == positions_.end())
+            continue;
+
+        auto& slot = transactions_[position->second];
+
+        if (!slot)
+        {
+            slot = tx;
+            --missing_;
+            continue;
+        }
+
+        if (slot->hash() == hash)
+            continue;
+
+        // Two candidates share the short id, so request the transaction.
+        slot.reset();
+        ++missing_;
+        positions_.erase(position);
+    }
+
+    return start > missing_ ? start - missing_ : 0;
+}
+
+bool partial_block::fill(const block_transactions& reply)
+{
+    const auto& txs = reply.transactions();
+
+    if (!valid_ || reply.block_hash() != hash_ || txs.size() != missing_)
+        return false;
+
+    auto tx = txs.begin();
+
+    for (auto& slot: transactions_)
+        if (!slot)
+            slot = std::make_shared<const transaction>(*tx++);
+
+    missing_ = 0;
+    positions_.clear();
+    return true;
+}
+
+get_block_transactions partial_block::request() const
+{
+    std::vector<uint64_t> indexes;
+    indexes.reserve(missing_);
+
+    // Indexes are differentially encoded, in ascending order.
+    uint64_t next = 0;
+
+    for (size_t index = 0; index < transactions_.size(); ++index)
+    {
+        if (transactions_[index])
+            continue;
+
+        indexes.push_back(index - next);
+        next = index + 1;
+    }
+
+    return{ hash_, std::move(indexes) };
+}
+
+bool partial_block::to_block(chain::block& out) const
+{
+    if (!is_complete())
+        return false;
+
+    transaction::list txs;
+    txs.reserve(transactions_.size());
+
+    for (const auto& tx: transactions_)
+        txs.push_back(*tx);
+
+    auto header = header_;
+    header.set_transaction_count(txs.size());
+    chain::block block(std::move(header), std::move(txs));
+
+    if (block.generate_merkle_root() != header_.merkle())
+        return false;
+
+    out = std::move(block);
+    return true;
+}
+
+} // namespace message
+} // namespace libbitcoin
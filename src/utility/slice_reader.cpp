@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+
+namespace libbitcoin {
+
+slice_reader::slice_reader(const data_slice data)
+  : position_(data.begin()), end_(data.end()), valid_(true)
+{
+}
+
+slice_reader::operator bool() const
+{
+    return valid_;
+}
+
+bool slice_reader::operator!() const
+{
+    return !valid_;
+}
+
+bool slice_reader::is_exhausted() const
+{
+    return valid_ && (position_ == end_);
+}
+
+size_t slice_reader::remaining() const
+{
+    return static_cast<size_t>(end_ - position_);
+}
+
+bool slice_reader::available(size_t size)
+{
+    if (valid_ && size <= remaining())
+        return true;
+
+    valid_ = false;
+    return false;
+}
+
+uint8_t slice_reader::read_byte()
+{
+    return available(1) ? *position_++ : 0;
+}
+
+uint16_t slice_reader::read_2_bytes_little_endian()
+{
+    return read_little_endian<uint16_t>();
+}
+
+uint32_t slice_reader::read_4_bytes_little_endian()
+{
+    return read_little_endian<uint32_t>();
+}
+
+uint64_t slice_reader::read_8_bytes_little_endian()
+{
+    return read_little_endian<uint64_t>();
+}
+
+uint64_t slice_reader::read_variable_uint_little_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_little_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_little_endian();
+
+    // length should be 0xff
+    return read_8_bytes_little_endian();
+}
+
+uint16_t slice_reader::read_2_bytes_big_endian()
+{
+    return read_big_endian<uint16_t>();
+}
+
+uint32_t slice_reader::read_4_bytes_big_endian()
+{
+    return read_big_endian<uint32_t>();
+}
+
+uint64_t slice_reader::read_8_bytes_big_endian()
+{
+    return read_big_endian<uint64_t>();
+}
+
+uint64_t slice_reader::read_variable_uint_big_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_big_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_big_endian();
+
+    // length should be 0xff
+    return read_8_bytes_big_endian();
+}
+
+// The size is bounded by the buffer before allocation, so an invalid length
+// prefix cannot cause an oversized allocation. A short read returns the
+// remaining bytes and invalidates the reader.
+data_chunk slice_reader::read_data(size_t size)
+{
+    if (!valid_)
+        return{};
+
+    const auto read_size = std::min(size, remaining());
+    const data_chunk raw_bytes(position_, position_ + read_size);
+    position_ += read_size;
+    valid_ = (read_size == size);
+    return raw_bytes;
+}
+
+size_t slice_reader::read_data(uint8_t* data, size_t size)
+{
+    if (!valid_)
+        return 0;
+
+    const auto read_size = std::min(size, remaining());
+    std::copy(position_, position_ + read_size, data);
+    position_ += read_size;
+    valid_ = (read_size == size);
+    return read_size;
+}
+
+data_chunk slice_reader::read_data_to_eof()
+{
+    if (!valid_)
+        return{};
+
+    const data_chunk raw_bytes(position_, end_);
+    position_ = end_;
+    return raw_bytes;
+}
+
+hash_digest slice_reader::read_hash()
+{
+    return read_bytes<hash_size>();
+}
+
+short_hash slice_reader::read_short_hash()
+{
+    return read_bytes<short_hash_size>();
+}
+
+mini_hash slice_reader::read_mini_hash()
+{
+    return read_bytes<mini_hash_size>();
+}
+
+std::string slice_reader::read_fixed_string(size_t length)
+{
+    if (!available(length))
+    {
+        position_ = end_;
+        return{};
+    }
+
+    const std::string result(position_, position_ + length);
+    position_ += length;
+
+    // Removes trailing 0s... Needed for string comparisons
+    return result.c_str();
+}
+
+std::string slice_reader::read_string()
+{
+    const auto size = read_variable_uint_little_endian();
+    BITCOIN_ASSERT(size <= bc::max_size_t);
+    const auto read_size = static_cast<size_t>(size);
+    return read_fixed_string(read_size);
+}
+
+} // namespace libbitcoin
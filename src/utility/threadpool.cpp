@@ -44,7 +44,7 @@ bool threadpool::empty() const
     // Critical Section
     shared_lock(threads_mutex);
 
-    return threads_.size() != 0;
+    return threads_.empty();
     ///////////////////////////////////////////////////////////////////////////
 }
 
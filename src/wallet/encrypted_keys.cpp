@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <algorithm>
 #include <stdexcept>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
@@ -33,6 +34,7 @@
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include "parse_encrypted_keys/parse_encrypted_key.hpp"
@@ -125,22 +127,37 @@ static one_byte point_sign(const one_byte& single, const hash_digest& hash)
 // scrypt_
 // ----------------------------------------------------------------------------
 
-static hash_digest scrypt_token(data_slice data, data_slice salt)
+static hash_digest scrypt_token(data_slice data, data_slice salt,
+    data_chunk& scratch)
 {
     // Arbitrary scrypt parameters from BIP38.
-    return scrypt<hash_size>(data, salt, 16384u, 8u, 8u);
+    return scrypt<hash_size>(data, salt, 16384u, 8u, 8u, scratch);
 }
 
-static long_hash scrypt_pair(data_slice data, data_slice salt)
+static long_hash scrypt_pair(data_slice data, data_slice salt,
+    data_chunk& scratch)
 {
     // Arbitrary scrypt parameters from BIP38.
-    return scrypt<long_hash_size>(data, salt, 1024u, 1u, 1u);
+    return scrypt<long_hash_size>(data, salt, 1024u, 1u, 1u, scratch);
 }
 
-static long_hash scrypt_private(data_slice data, data_slice salt)
+static long_hash scrypt_private(data_slice data, data_slice salt,
+    data_chunk& scratch)
 {
     // Arbitrary scrypt parameters from BIP38.
-    return scrypt<long_hash_size>(data, salt, 16384u, 8u, 8u);
+    return scrypt<long_hash_size>(data, salt, 16384u, 8u, 8u, scratch);
+}
+
+static hash_digest scrypt_token(data_slice data, data_slice salt)
+{
+    data_chunk scratch;
+    return scrypt_token(data, salt, scratch);
+}
+
+static long_hash scrypt_pair(data_slice data, data_slice salt)
+{
+    data_chunk scratch;
+    return scrypt_pair(data, salt, scratch);
 }
 
 // set_flags
@@ -343,14 +360,16 @@ bool create_token(encrypted_token& out_token, const std::string& passphrase,
 // encrypt
 // ----------------------------------------------------------------------------
 
-bool encrypt(encrypted_private& out_private, const ec_secret& secret,
-    const std::string& passphrase, uint8_t version, bool compressed)
+// The passphrase is normalized.
+static bool encrypt_secret(encrypted_private& out_private,
+    const ec_secret& secret, data_slice passphrase, uint8_t version,
+    bool compressed, data_chunk& scratch)
 {
     ek_salt salt;
     if (!address_salt(salt, secret, version, compressed))
         return false;
 
-    const auto derived = split(scrypt_private(normal(passphrase), salt));
+    const auto derived = split(scrypt_private(passphrase, salt, scratch));
     const auto prefix = parse_encrypted_private::prefix_factory(version,
         false);
 
@@ -370,13 +389,47 @@ bool encrypt(encrypted_private& out_private, const ec_secret& secret,
     });
 }
 
+bool encrypt(encrypted_private& out_private, const ec_secret& secret,
+    const std::string& passphrase, uint8_t version, bool compressed)
+{
+    data_chunk scratch;
+    return encrypt_secret(out_private, secret, normal(passphrase), version,
+        compressed, scratch);
+}
+
+bool encrypt(encrypted_private_list& out_privates,
+    const secret_list& secrets, const std::string& passphrase,
+    uint8_t version, bool compressed, size_t threads)
+{
+    const auto normalized = normal(passphrase);
+    out_privates.assign(secrets.size(), encrypted_private{});
+
+    // Results are bytes so that threads may set distinct elements.
+    std::vector<uint8_t> results(secrets.size(), 0);
+
+    const auto encrypt_range = [&](size_t begin, size_t end)
+    {
+        data_chunk scratch;
+
+        for (auto index = begin; index < end; ++index)
+            results[index] = encrypt_secret(out_privates[index],
+                secrets[index], normalized, version, compressed, scratch);
+    };
+
+    parallel_for(threads, secrets.size(), encrypt_range);
+    return std::all_of(results.begin(), results.end(),
+        [](uint8_t result) { return result != 0; });
+}
+
 // decrypt private_key
 // ----------------------------------------------------------------------------
 
+// The passphrase is normalized.
 static bool decrypt_multiplied(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, data_slice passphrase,
+    data_chunk& scratch)
 {
-    auto secret = scrypt_token(normal(passphrase), parse.owner_salt());
+    auto secret = scrypt_token(passphrase, parse.owner_salt(), scratch);
 
     if (parse.lot_sequence())
         secret = bitcoin_hash(splice(secret, parse.entropy()));
@@ -386,7 +439,7 @@ static bool decrypt_multiplied(ec_secret& out_secret,
         return false;
 
     const auto salt_entropy = splice(parse.salt(), parse.entropy());
-    const auto derived = split(scrypt_pair(point, salt_entropy));
+    const auto derived = split(scrypt_pair(point, salt_entropy, scratch));
 
     auto encrypt1 = parse.data1();
     auto encrypt2 = parse.data2();
@@ -411,13 +464,15 @@ static bool decrypt_multiplied(ec_secret& out_secret,
     return true;
 }
 
+// The passphrase is normalized.
 static bool decrypt_secret(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+    const parse_encrypted_private& parse, data_slice passphrase,
+    data_chunk& scratch)
 {
     auto encrypt1 = splice(parse.entropy(), parse.data1());
     auto encrypt2 = parse.data2();
-    const auto derived = split(scrypt_private(normal(passphrase),
-        parse.salt()));
+    const auto derived = split(scrypt_private(passphrase, parse.salt(),
+        scratch));
 
     aes256_decrypt(derived.right, encrypt1);
     aes256_decrypt(derived.right, encrypt2);
@@ -434,16 +489,18 @@ static bool decrypt_secret(ec_secret& out_secret,
     return true;
 }
 
-bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
-    const encrypted_private& key, const std::string& passphrase)
+// The passphrase is normalized.
+static bool decrypt_private(ec_secret& out_secret, uint8_t& out_version,
+    bool& out_compressed, const encrypted_private& key, data_slice passphrase,
+    data_chunk& scratch)
 {
     const parse_encrypted_private parse(key);
     if (!parse.valid())
         return false;
 
     const auto success = parse.multiplied() ?
-        decrypt_multiplied(out_secret, parse, passphrase) :
-        decrypt_secret(out_secret, parse, passphrase);
+        decrypt_multiplied(out_secret, parse, passphrase, scratch) :
+        decrypt_secret(out_secret, parse, passphrase, scratch);
 
     if (success)
     {
@@ -454,6 +511,51 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     return success;
 }
 
+bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
+    const encrypted_private& key, const std::string& passphrase)
+{
+    data_chunk scratch;
+    return decrypt_private(out_secret, out_version, out_compressed, key,
+        normal(passphrase), scratch);
+}
+
+bool decrypt(secret_list& out_secrets, data_chunk& out_versions,
+    std::vector<bool>& out_compressed, const encrypted_private_list& keys,
+    const std::string& passphrase, size_t threads)
+{
+    const auto size = keys.size();
+    const auto normalized = normal(passphrase);
+    out_secrets.assign(size, null_hash);
+    out_versions.assign(size, 0);
+
+    // Results are bytes so that threads may set distinct elements.
+    std::vector<uint8_t> results(size, 0);
+    std::vector<uint8_t> compressions(size, 0);
+
+    const auto decrypt_range = [&](size_t begin, size_t end)
+    {
+        data_chunk scratch;
+
+        for (auto index = begin; index < end; ++index)
+        {
+            bool compressed;
+            results[index] = decrypt_private(out_secrets[index],
+                out_versions[index], compressed, keys[index], normalized,
+                scratch);
+
+            if (results[index])
+                compressions[index] = compressed;
+            else
+                out_secrets[index] = null_hash;
+        }
+    };
+
+    parallel_for(threads, size, decrypt_range);
+    out_compressed.assign(compressions.begin(), compressions.end());
+    return std::all_of(results.begin(), results.end(),
+        [](uint8_t result) { return result != 0; });
+}
+
 // decrypt public_key
 // ----------------------------------------------------------------------------
 
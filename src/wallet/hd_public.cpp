@@ -19,8 +19,11 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_public.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -32,15 +35,26 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
+#include <bitcoin/bitcoin/wallet/payment_address.hpp>
+#include "../math/external/hmac_sha512.h"
 
 namespace libbitcoin {
 namespace wallet {
 
 const uint32_t hd_public::mainnet = 76067358;
 
+// The calling thread derives one of the ranges.
+static size_t pool_size(size_t threads, size_t count)
+{
+    const auto concurrency = std::min(threads, count);
+    return concurrency < 2 ? 0 : concurrency - 1;
+}
+
 // hd_public
 // ----------------------------------------------------------------------------
 
@@ -238,9 +252,161 @@ hd_public hd_public::derive_public(uint32_t index) const
     return hd_public(combined, intermediate.right, lineage);
 }
 
+hd_public::list hd_public::derive_public_range(uint32_t first, size_t count,
+    threadpool& pool) const
+{
+    point_list points;
+    std::vector<hd_chain_code> chains;
+
+    if (lineage_.depth == max_uint8 ||
+        !derive_points(points, &chains, nullptr, first, count, pool))
+        return list();
+
+    // A private parent carries both prefixes, the children only the public.
+    const auto prefix = to_prefix(lineage_.prefixes);
+    const auto parent_fingerprint = fingerprint();
+    const auto depth = safe_add(lineage_.depth, uint8_t(1));
+    list out(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        if (points[index] == null_compressed_point)
+            continue;
+
+        const hd_lineage lineage
+        {
+            prefix,
+            depth,
+            parent_fingerprint,
+            static_cast<uint32_t>(first + index)
+        };
+
+        out[index] = hd_public(points[index], chains[index], lineage);
+    }
+
+    return out;
+}
+
+short_hash_list hd_public::derive_hash_range(uint32_t first, size_t count,
+    threadpool& pool) const
+{
+    point_list points;
+    short_hash_list out;
+
+    if (!derive_points(points, nullptr, &out, first, count, pool))
+        return short_hash_list();
+
+    return out;
+}
+
+payment_address::list hd_public::derive_address_range(uint32_t first,
+    size_t count, uint8_t version, threadpool& pool) const
+{
+    point_list points;
+    short_hash_list hashes;
+
+    if (!derive_points(points, nullptr, &hashes, first, count, pool))
+        return payment_address::list();
+
+    payment_address::list out(count);
+
+    for (size_t index = 0; index < count; ++index)
+        if (points[index] != null_compressed_point)
+            out[index] = payment_address(hashes[index], version);
+
+    return out;
+}
+
+hd_public::list hd_public::derive_public_range(uint32_t first, size_t count,
+    size_t threads) const
+{
+    threadpool pool(pool_size(threads, count));
+    return derive_public_range(first, count, pool);
+}
+
+short_hash_list hd_public::derive_hash_range(uint32_t first, size_t count,
+    size_t threads) const
+{
+    threadpool pool(pool_size(threads, count));
+    return derive_hash_range(first, count, pool);
+}
+
+payment_address::list hd_public::derive_address_range(uint32_t first,
+    size_t count, uint8_t version, size_t threads) const
+{
+    threadpool pool(pool_size(threads, count));
+    return derive_address_range(first, count, version, pool);
+}
+
 // Helpers.
 // ----------------------------------------------------------------------------
 
+// The child points (null where underivable), optionally with chain codes and
+// point hashes (null where underivable). Each range is derived and hashed on
+// one thread, with the range's sums added against the parsed parent point.
+bool hd_public::derive_points(point_list& out,
+    std::vector<hd_chain_code>* chains, short_hash_list* hashes,
+    uint32_t first, size_t count, threadpool& pool) const
+{
+    if (!valid_ || first >= hd_first_hardened_key ||
+        count > hd_first_hardened_key - first)
+        return false;
+
+    // The hmac key schedule depends only on the parent chain code.
+    HMACSHA512CTX parent;
+    HMACSHA512Init(&parent, chain_.data(), chain_.size());
+
+    out.assign(count, null_compressed_point);
+
+    if (chains != nullptr)
+        chains->resize(count);
+
+    if (hashes != nullptr)
+        hashes->assign(count, null_short_hash);
+
+    const auto derive = [&](size_t begin, size_t end)
+    {
+        auto data = splice(point_, to_big_endian(uint32_t(0)));
+        long_hash intermediate;
+        secret_list tweaks;
+        tweaks.reserve(end - begin);
+
+        for (auto index = begin; index < end; ++index)
+        {
+            const auto child = to_big_endian(
+                static_cast<uint32_t>(first + index));
+            std::copy(child.begin(), child.end(),
+                data.begin() + ec_compressed_size);
+
+            auto context = parent;
+            HMACSHA512Update(&context, data.data(), data.size());
+            HMACSHA512Final(&context, intermediate.data());
+
+            const auto parts = split(intermediate);
+            tweaks.push_back(parts.left);
+
+            if (chains != nullptr)
+                (*chains)[index] = parts.right;
+        }
+
+        // Failed sums are nulled in place, the overall result is not needed.
+        point_list points;
+        ec_add(points, point_, tweaks);
+
+        for (auto index = begin; index < end; ++index)
+        {
+            const auto& point = points[index - begin];
+            out[index] = point;
+
+            if (hashes != nullptr && point != null_compressed_point)
+                (*hashes)[index] = bitcoin_short_hash(point);
+        }
+    };
+
+    parallel_for(pool, count, derive);
+    return true;
+}
+
 uint32_t hd_public::fingerprint() const
 {
     const auto message_digest = bitcoin_short_hash(point_);
@@ -140,6 +140,20 @@ long_hash decode_mnemonic(const word_list& mnemonic)
         to_chunk(salt), hmac_iterations);
 }
 
+long_hash_list decode_mnemonics(const word_lists& mnemonics, size_t threads)
+{
+    const std::string prefix(passphrase_prefix);
+    const data_stack salts(mnemonics.size(), to_chunk(prefix));
+    data_stack sentences;
+    sentences.reserve(mnemonics.size());
+
+    for (const auto& mnemonic: mnemonics)
+        sentences.push_back(to_chunk(join(mnemonic)));
+
+    return pkcs5_pbkdf2_hmac_sha512(sentences, salts, hmac_iterations,
+        threads);
+}
+
 #ifdef WITH_ICU
 
 long_hash decode_mnemonic(const word_list& mnemonic,
@@ -152,6 +166,21 @@ long_hash decode_mnemonic(const word_list& mnemonic,
         to_chunk(salt), hmac_iterations);
 }
 
+long_hash_list decode_mnemonics(const word_list& mnemonic,
+    const string_list& passphrases, size_t threads)
+{
+    const std::string prefix(passphrase_prefix);
+    const data_stack sentences(passphrases.size(), to_chunk(join(mnemonic)));
+    data_stack salts;
+    salts.reserve(passphrases.size());
+
+    for (const auto& passphrase: passphrases)
+        salts.push_back(to_chunk(to_normal_nfkd_form(prefix + passphrase)));
+
+    return pkcs5_pbkdf2_hmac_sha512(sentences, salts, hmac_iterations,
+        threads);
+}
+
 #endif
 
 } // namespace wallet
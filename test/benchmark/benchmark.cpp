@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace libbitcoin {
+namespace benchmark {
+
+typedef std::chrono::steady_clock clock;
+
+static volatile uint64_t sink = 0;
+
+void consume(uint64_t value)
+{
+    sink = sink + value;
+}
+
+suite::suite(size_t milliseconds, size_t samples)
+  : milliseconds_(milliseconds), samples_(std::max(samples, size_t(1)))
+{
+}
+
+void suite::add(const std::string& name, size_t bytes, operation function)
+{
+    entries_.push_back({ name, bytes, function });
+}
+
+std::vector<std::string> suite::names() const
+{
+    std::vector<std::string> out;
+
+    for (const auto& benchmark: entries_)
+        out.push_back(benchmark.name);
+
+    return out;
+}
+
+std::vector<result> suite::run(const std::string& filter) const
+{
+    std::vector<result> out;
+
+    for (const auto& benchmark: entries_)
+        if (benchmark.name.find(filter) != std::string::npos)
+            out.push_back(measure(benchmark));
+
+    return out;
+}
+
+double suite::time(const operation& function, size_t iterations) const
+{
+    const auto start = clock::now();
+    function(iterations);
+    const auto elapsed = clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+result suite::measure(const entry& benchmark) const
+{
+    const auto target = milliseconds_ * 1e6;
+
+    // Double the batch until it takes a tenth of the sample time, then scale.
+    size_t iterations = 1;
+    auto elapsed = time(benchmark.function, iterations);
+
+    while (elapsed < target / 10 && iterations < (size_t(1) << 40))
+    {
+        iterations *= 2;
+        elapsed = time(benchmark.function, iterations);
+    }
+
+    const auto scale = elapsed > 0 ? target / elapsed : 1.0;
+    iterations = std::max(size_t(1), static_cast<size_t>(iterations * scale));
+
+    std::vector<double> samples;
+    samples.reserve(samples_);
+
+    for (size_t sample = 0; sample < samples_; ++sample)
+        samples.push_back(time(benchmark.function, iterations) / iterations);
+
+    std::sort(samples.begin(), samples.end());
+    return{ benchmark.name, iterations, samples[samples.size() / 2],
+        benchmark.bytes };
+}
+
+static double to_megabytes_per_second(const result& value)
+{
+    return value.nanoseconds_per_operation == 0 ? 0 :
+        value.bytes_per_operation * 1e3 / value.nanoseconds_per_operation;
+}
+
+void suite::write(std::ostream& stream, const std::vector<result>& results,
+    format output)
+{
+    stream << std::fixed << std::setprecision(1);
+
+    switch (output)
+    {
+        case format::csv:
+        {
+            stream << "name,iterations,ns_per_op,bytes_per_op,mb_per_s\n";
+
+            for (const auto& value: results)
+                stream << value.name << "," << value.iterations << ","
+                    << value.nanoseconds_per_operation << ","
+                    << value.bytes_per_operation << ","
+                    << to_megabytes_per_second(value) << "\n";
+
+            break;
+        }
+        case format::json:
+        {
+            stream << "[\n";
+
+            for (size_t index = 0; index < results.size(); ++index)
+            {
+                const auto& value = results[index];
+                stream << "  { \"name\": \"" << value.name << "\", "
+                    << "\"iterations\": " << value.iterations << ", "
+                    << "\"ns_per_op\": " << value.nanoseconds_per_operation
+                    << ", \"bytes_per_op\": " << value.bytes_per_operation
+                    << ", \"mb_per_s\": " << to_megabytes_per_second(value)
+                    << " }" << (index + 1 < results.size() ? "," : "")
+                    << "\n";
+            }
+
+            stream << "]\n";
+            break;
+        }
+        case format::text:
+        default:
+        {
+            stream << std::left << std::setw(40) << "name" << std::right
+                << std::setw(14) << "ns/op" << std::setw(14) << "bytes/op"
+                << std::setw(12) << "MB/s" << std::setw(14) << "iterations"
+                << "\n";
+
+            for (const auto& value: results)
+                stream << std::left << std::setw(40) << value.name
+                    << std::right << std::setw(14)
+                    << value.nanoseconds_per_operation << std::setw(14)
+                    << value.bytes_per_operation << std::setw(12)
+                    << to_megabytes_per_second(value) << std::setw(14)
+                    << value.iterations << "\n";
+
+            break;
+        }
+    }
+
+    stream.flush();
+}
+
+} // namespace benchmark
+} // namespace libbitcoin
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BENCHMARK_BENCHMARK_HPP
+#define LIBBITCOIN_BENCHMARK_BENCHMARK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace libbitcoin {
+namespace benchmark {
+
+/// The output format of results.
+enum class format
+{
+    text,
+    csv,
+    json
+};
+
+/// The measurement of one benchmark, the median of its samples.
+struct result
+{
+    std::string name;
+    size_t iterations;
+    double nanoseconds_per_operation;
+    size_t bytes_per_operation;
+};
+
+/// This class is not thread safe.
+/// A set of named operations, each timed over batches of iterations. The
+/// batch size is calibrated to the minimum sample time and the median of the
+/// samples is reported, so that runs on one machine are comparable.
+class suite
+{
+public:
+    typedef std::function<void(size_t iterations)> operation;
+
+    suite(size_t milliseconds=200, size_t samples=5);
+
+    /// Add an operation that processes the given bytes on each iteration.
+    void add(const std::string& name, size_t bytes, operation function);
+
+    /// Run the operations with the filter in their name (all if empty).
+    std::vector<result> run(const std::string& filter) const;
+
+    /// The names of all operations.
+    std::vector<std::string> names() const;
+
+    static void write(std::ostream& stream, const std::vector<result>& results,
+        format output);
+
+private:
+    struct entry
+    {
+        std::string name;
+        size_t bytes;
+        operation function;
+    };
+
+    double time(const operation& function, size_t iterations) const;
+    result measure(const entry& benchmark) const;
+
+    const size_t milliseconds_;
+    const size_t samples_;
+    std::vector<entry> entries_;
+};
+
+/// Prevent the optimizer from discarding a computed value.
+void consume(uint64_t value);
+
+} // namespace benchmark
+} // namespace libbitcoin
+
+#endif
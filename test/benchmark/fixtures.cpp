@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fixtures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace benchmark {
+
+// Block 00000000839a8e6886ab5951d76f411475428afc90947ee320161bbf18eb6048.
+static const std::string encoded_mainnet_block1 =
+    "010000006fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d61900"
+    "00000000982051fd1e4ba744bbbe680e1fee14677ba1a3c3540bf7b1cdb606e8"
+    "57233e0e61bc6649ffff001d01e3629901010000000100000000000000000000"
+    "00000000000000000000000000000000000000000000ffffffff0704ffff001d"
+    "0104ffffffff0100f2052a0100000043410496b538e853519c726a2c91e61ec1"
+    "1600ae1390813a627c66fb8be7947be63c52da7589379515d4e0a604f8141781"
+    "e62294721166bf621e73a82cbf2342c858eeac00000000";
+
+// splitmix64, so that fixtures do not depend on the standard library.
+static uint64_t next(uint64_t& state)
+{
+    auto value = (state += 0x9e3779b97f4a7c15ull);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+data_chunk mainnet_block1()
+{
+    data_chunk out;
+    decode_base16(out, encoded_mainnet_block1);
+    return out;
+}
+
+data_chunk synthetic_data(size_t size, uint64_t seed)
+{
+    data_chunk out(size);
+
+    for (auto& byte: out)
+        byte = static_cast<uint8_t>(next(seed));
+
+    return out;
+}
+
+data_chunk synthetic_transaction(uint64_t seed)
+{
+    data_chunk out;
+    const auto bytes = [&seed](size_t size)
+    {
+        return synthetic_data(size, next(seed));
+    };
+
+    extend_data(out, to_little_endian<uint32_t>(1));
+    out.push_back(2);
+
+    for (size_t input = 0; input < 2; ++input)
+    {
+        // Previous output, then a push of an endorsement and of a key.
+        extend_data(out, bytes(hash_size));
+        extend_data(out, to_little_endian<uint32_t>(next(seed) % 4));
+        out.push_back(1 + 71 + 1 + 33);
+        out.push_back(71);
+        extend_data(out, bytes(71));
+        out.push_back(33);
+        out.push_back(0x02);
+        extend_data(out, bytes(32));
+        extend_data(out, to_little_endian<uint32_t>(max_uint32));
+    }
+
+    out.push_back(2);
+
+    for (size_t output = 0; output < 2; ++output)
+    {
+        extend_data(out, to_little_endian<uint64_t>(next(seed) % max_money()));
+        out.push_back(25);
+        extend_data(out, data_chunk{ 0x76, 0xa9, 0x14 });
+        extend_data(out, bytes(short_hash_size));
+        extend_data(out, data_chunk{ 0x88, 0xac });
+    }
+
+    extend_data(out, to_little_endian<uint32_t>(0));
+    return out;
+}
+
+data_chunk synthetic_block(size_t transactions, uint64_t seed)
+{
+    chain::block block;
+    block.header().set_version(1);
+    block.header().set_bits(max_work_bits);
+    block.transactions().reserve(transactions);
+
+    for (size_t tx = 0; tx < transactions; ++tx)
+        block.transactions().push_back(chain::transaction::factory_from_data(
+            synthetic_transaction(next(seed))));
+
+    block.header().set_merkle(block.generate_merkle_root());
+    block.header().set_transaction_count(transactions);
+    return block.to_data();
+}
+
+} // namespace benchmark
+} // namespace libbitcoin
@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BENCHMARK_FIXTURES_HPP
+#define LIBBITCOIN_BENCHMARK_FIXTURES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace benchmark {
+
+/// Mainnet block 1 (the genesis block is chain::block::genesis_mainnet).
+data_chunk mainnet_block1();
+
+/// Deterministic pseudo-random bytes, identical across platforms.
+data_chunk synthetic_data(size_t size, uint64_t seed);
+
+/// A serialized transaction shaped as two p2pkh spends to two p2pkh outputs.
+data_chunk synthetic_transaction(uint64_t seed);
+
+/// A serialized block of synthetic transactions with a valid merkle root.
+data_chunk synthetic_block(size_t transactions, uint64_t seed);
+
+} // namespace benchmark
+} // namespace libbitcoin
+
+#endif
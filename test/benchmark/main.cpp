@@ -0,0 +1,398 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+BC_USE_LIBBITCOIN_MAIN
+
+using namespace bc;
+using namespace bc::benchmark;
+using namespace bc::chain;
+using namespace bc::wallet;
+
+// Fixtures are generated from fixed seeds, so every run measures the same data.
+static const uint64_t seed = 42;
+static const size_t block_transactions = 2000;
+static const size_t peer_filters = 16;
+
+static void add_hashing(suite& benchmarks)
+{
+    const auto header = block::genesis_mainnet().header().to_data(false);
+    const auto kilobyte = synthetic_data(1024, seed);
+    const auto key = synthetic_data(33, seed);
+    const auto txid = sha256_hash(kilobyte);
+    const auto point = synthetic_data(36, seed);
+
+    benchmarks.add("hash.sha256.1024", kilobyte.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(sha256_hash(kilobyte)[0]);
+    });
+
+    benchmarks.add("hash.bitcoin_hash.header", header.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(bitcoin_hash(header)[0]);
+    });
+
+    benchmarks.add("hash.bitcoin_short_hash.key", key.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(bitcoin_short_hash(key)[0]);
+    });
+
+    benchmarks.add("hash.sha512.1024", kilobyte.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(sha512_hash(kilobyte)[0]);
+    });
+
+    benchmarks.add("hash.siphash.txid", txid.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(siphash(iteration, seed, txid));
+    });
+
+    benchmarks.add("hash.murmur3.point", point.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(murmur3_hash(point, static_cast<uint32_t>(iteration)));
+    });
+}
+
+static void add_parsing(suite& benchmarks)
+{
+    const auto genesis = block::genesis_mainnet().to_data();
+    const auto block1 = mainnet_block1();
+    const auto transaction = synthetic_transaction(seed);
+    const auto full = synthetic_block(block_transactions, seed);
+
+    benchmarks.add("parse.block.mainnet_genesis", genesis.size(),
+        [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(block::factory_from_data(genesis).is_valid());
+    });
+
+    benchmarks.add("parse.block.mainnet_1", block1.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(block::factory_from_data(block1).is_valid());
+    });
+
+    benchmarks.add("parse.block.synthetic_2000", full.size(),
+        [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(block::factory_from_data(full).is_valid());
+    });
+
+    benchmarks.add("parse.transaction.p2pkh", transaction.size(),
+        [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(chain::transaction::factory_from_data(transaction)
+                .is_valid());
+    });
+
+    const auto parsed = block::factory_from_data(full);
+
+    benchmarks.add("serialize.block.synthetic_2000", full.size(),
+        [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(parsed.to_data().size());
+    });
+}
+
+static void add_merkle(suite& benchmarks)
+{
+    const auto full = block::factory_from_data(synthetic_block(
+        block_transactions, seed));
+
+    benchmarks.add("merkle.root.synthetic_2000", block_transactions *
+        hash_size, [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(full.generate_merkle_root()[0]);
+    });
+
+    benchmarks.add("block.hash.transactions_2000", full.serialized_size(),
+        [=](size_t count)
+    {
+        // Parsing is included, as transaction hashes are cached on first use.
+        const auto data = full.to_data();
+
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(block::factory_from_data(data).generate_merkle_root()[0]);
+    });
+}
+
+static void add_filtering(suite& benchmarks)
+{
+    const auto data = synthetic_block(block_transactions, seed);
+    const auto full = block::factory_from_data(data);
+    const auto threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Peer filters of a few wallet hashes each, which are not updated by
+    // matches, so every iteration matches the same filters.
+    message::bloom_filter::ptr_list filters;
+    for (size_t peer = 0; peer < peer_filters; ++peer)
+    {
+        const auto filter = std::make_shared<message::bloom_filter>(10,
+            0.0001, static_cast<uint32_t>(peer),
+            message::bloom_filter::update_none);
+
+        for (size_t element = 0; element < 10; ++element)
+            filter->insert(synthetic_data(short_hash_size,
+                seed + peer * 10 + element));
+
+        filters.push_back(filter);
+    }
+
+    benchmarks.add("bloom.filtered_block.serial_16", data.size(),
+        [=](size_t count)
+    {
+        message::filtered_block::indexes matches;
+
+        for (size_t iteration = 0; iteration < count; ++iteration)
+        {
+            const message::filtered_block filtered(full);
+
+            for (const auto& filter: filters)
+                consume(filtered.match(*filter, matches).hashes().size());
+        }
+    });
+
+    // The filters are divided among the threads with parallel_for.
+    benchmarks.add("bloom.filtered_block.parallel_16", data.size(),
+        [=](size_t count)
+    {
+        message::merkle_block::list out;
+        std::vector<message::filtered_block::indexes> matches;
+
+        for (size_t iteration = 0; iteration < count; ++iteration)
+        {
+            const message::filtered_block filtered(full);
+            filtered.match(out, matches, filters, threads);
+            consume(out.size());
+        }
+    });
+}
+
+static void add_scripts(suite& benchmarks)
+{
+    // A hash lock output and its spend, evaluated without signatures.
+    const auto preimage = synthetic_data(32, seed);
+    auto lock = data_chunk{ 0xa9, 0x14 };
+    extend_data(lock, bitcoin_short_hash(preimage));
+    lock.push_back(0x87);
+    auto unlock = data_chunk{ 0x20 };
+    extend_data(unlock, preimage);
+
+    const auto prevout = script::factory_from_data(lock, false,
+        script::parse_mode::strict);
+    auto spend = chain::transaction::factory_from_data(
+        synthetic_transaction(seed));
+    spend.inputs()[0].set_script(script::factory_from_data(unlock, false,
+        script::parse_mode::strict));
+
+    benchmarks.add("script.verify.hash_lock", unlock.size() + lock.size(),
+        [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(script::verify(spend, 0, prevout, rule_fork::no_rules)
+                .value());
+    });
+
+    benchmarks.add("script.signature_hash.all", spend.serialized_size(),
+        [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(script::generate_signature_hash(spend, 0, prevout,
+                signature_hash_algorithm::all)[0]);
+    });
+}
+
+static void add_encoding(suite& benchmarks)
+{
+    const auto payload = synthetic_data(25, seed);
+    const auto encoded = encode_base58(payload);
+
+    benchmarks.add("base58.encode.address", payload.size(), [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(encode_base58(payload).size());
+    });
+
+    benchmarks.add("base58.decode.address", encoded.size(), [=](size_t count)
+    {
+        data_chunk out;
+
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(decode_base58(out, encoded));
+    });
+
+    benchmarks.add("base16.encode.hash", hash_size, [=](size_t count)
+    {
+        const auto hash = sha256_hash(payload);
+
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(encode_hash(hash).size());
+    });
+}
+
+static void add_wallet(suite& benchmarks)
+{
+    const hd_private root(synthetic_data(32, seed));
+    const auto root_public = root.to_public();
+
+    benchmarks.add("hd.derive_private", 0, [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(root.derive_private(static_cast<uint32_t>(iteration))
+                .lineage().depth);
+    });
+
+    benchmarks.add("hd.derive_public", 0, [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(root_public.derive_public(static_cast<uint32_t>(
+                iteration)).lineage().depth);
+    });
+
+    benchmarks.add("hd.encoded", 0, [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(root.encoded().size());
+    });
+}
+
+static void add_proof_of_work(suite& benchmarks)
+{
+    const auto header = block::genesis_mainnet().header();
+
+    benchmarks.add("chain.header.proof_of_work", 80, [=](size_t count)
+    {
+        const auto hash = header.hash();
+
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(header.is_valid_proof_of_work(hash));
+    });
+
+    benchmarks.add("chain.block.difficulty", sizeof(uint32_t),
+        [=](size_t count)
+    {
+        for (size_t iteration = 0; iteration < count; ++iteration)
+            consume(block::difficulty(header.bits()).compact());
+    });
+}
+
+static void show_usage()
+{
+    bc::cout
+        << "Usage: libbitcoin_benchmark [options]" << std::endl
+        << "  --filter=<text>        Run benchmarks with the text in the name."
+        << std::endl
+        << "  --format=text|csv|json Output format, text by default."
+        << std::endl
+        << "  --time=<milliseconds>  Minimum time per sample, 200 by default."
+        << std::endl
+        << "  --samples=<count>      Samples (median reported), 5 by default."
+        << std::endl
+        << "  --list                 List the benchmark names." << std::endl;
+}
+
+static bool starts_with(const std::string& text, const std::string& prefix,
+    std::string& value)
+{
+    if (text.compare(0, prefix.size(), prefix) != 0)
+        return false;
+
+    value = text.substr(prefix.size());
+    return true;
+}
+
+int bc::main(int argc, char* argv[])
+{
+    set_utf8_stdio();
+
+    std::string filter;
+    auto output = format::text;
+    auto list = false;
+    size_t milliseconds = 200;
+    size_t samples = 5;
+
+    for (auto index = 1; index < argc; ++index)
+    {
+        const std::string argument(argv[index]);
+        std::string value;
+
+        if (argument == "--list")
+            list = true;
+        else if (starts_with(argument, "--filter=", value))
+            filter = value;
+        else if (starts_with(argument, "--time=", value))
+            milliseconds = std::strtoul(value.c_str(), nullptr, 10);
+        else if (starts_with(argument, "--samples=", value))
+            samples = std::strtoul(value.c_str(), nullptr, 10);
+        else if (argument == "--format=csv")
+            output = format::csv;
+        else if (argument == "--format=json")
+            output = format::json;
+        else if (argument == "--format=text")
+            output = format::text;
+        else
+        {
+            show_usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    suite benchmarks(milliseconds, samples);
+    add_hashing(benchmarks);
+    add_parsing(benchmarks);
+    add_merkle(benchmarks);
+    add_filtering(benchmarks);
+    add_scripts(benchmarks);
+    add_encoding(benchmarks);
+    add_wallet(benchmarks);
+    add_proof_of_work(benchmarks);
+
+    if (list)
+    {
+        for (const auto& name: benchmarks.names())
+            bc::cout << name << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    suite::write(bc::cout, benchmarks.run(filter), output);
+    return EXIT_SUCCESS;
+}
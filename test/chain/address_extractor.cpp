@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2011-2013 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(address_extractor_tests)
+
+#define KEY1 "03b8e27c9f4e6d79a27ac5b3a9d66f4c1e88c4e2b3c0bfa65baf2fb2e0d8b1b2c9"
+#define KEY2 "0211c1e1d49b4bb7e6b9d4d4a5bff22f0c2ab1aa52d6b0cd1e0b4fe8f8b51c4f9b"
+#define HASH1 "88350574280395ad2c3e2ee20e322073d94e5e40"
+#define SIGNATURE "3044022057d0b4fb0df5cefa245e76ba9b099bb63aa46340cb152a927c1cb3f8befe324802203750eae5727db3e6cc4275062971552e467f7cfd7269fec2626588b6c6d58e9201"
+
+static script make_script(const std::string& text)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string(text));
+    return instance;
+}
+
+static short_hash to_hash160(const std::string& hex)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, hex));
+    return bitcoin_short_hash(data);
+}
+
+static void require_classify(const std::string& text, script_pattern expected,
+    size_t payloads)
+{
+    const auto instance = make_script(text);
+    const auto data = instance.to_data(false);
+    address_extractor::payloads out;
+    BOOST_REQUIRE(address_extractor::classify(out, data) == expected);
+    BOOST_REQUIRE_EQUAL(out.size(), payloads);
+}
+
+BOOST_AUTO_TEST_CASE(address_extractor__classify__standard_outputs__expected_payloads)
+{
+    require_classify("dup hash160 [ " HASH1 " ] equalverify checksig", script_pattern::pay_key_hash, 1);
+    require_classify("hash160 [ " HASH1 " ] equal", script_pattern::pay_script_hash, 1);
+    require_classify("[ " KEY1 " ] checksig", script_pattern::pay_public_key, 1);
+    require_classify("1 [ " KEY1 " ] [ " KEY2 " ] 2 checkmultisig", script_pattern::pay_multisig, 2);
+    require_classify("return [ 0102030405 ]", script_pattern::null_data, 0);
+}
+
+// The classification of the serialized script agrees with script::pattern.
+static void require_null_data(const data_chunk& data, script_pattern expected)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data(data, false, script::parse_mode::strict));
+    BOOST_REQUIRE(instance.pattern() == expected);
+
+    address_extractor::payloads out;
+    BOOST_REQUIRE(address_extractor::classify(out, data) == expected);
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(address_extractor__classify__null_data_sizes__matches_pattern)
+{
+    static const auto return_ = static_cast<uint8_t>(opcode::return_);
+    static const auto pushdata1 = static_cast<uint8_t>(opcode::pushdata1);
+    const auto max = operation::max_null_data_size;
+
+    require_null_data({ return_, 0x00 }, script_pattern::null_data);
+    require_null_data({ return_, 0x01, 0x42 }, script_pattern::null_data);
+
+    for (size_t length = 75; length <= max + 1; ++length)
+    {
+        data_chunk data{ return_ };
+        if (length > 75)
+            data.push_back(pushdata1);
+
+        data.push_back(static_cast<uint8_t>(length));
+        data.resize(data.size() + length, 0x2a);
+        require_null_data(data, length <= max ? script_pattern::null_data :
+            script_pattern::non_standard);
+    }
+
+    require_null_data({ return_, pushdata1, 0x00 }, script_pattern::null_data);
+}
+
+BOOST_AUTO_TEST_CASE(address_extractor__classify__non_standard__no_payloads)
+{
+    require_classify("dup hash160 [ " HASH1 " ] equal checksig", script_pattern::non_standard, 0);
+    require_classify("[ 0102 ] checksig", script_pattern::non_standard, 0);
+    require_classify("2 [ " KEY1 " ] 1 checkmultisig", script_pattern::non_standard, 0);
+    require_classify("1 [ " KEY1 " ] [ 0102 ] 2 checkmultisig", script_pattern::non_standard, 0);
+
+    address_extractor::payloads out;
+    BOOST_REQUIRE(address_extractor::classify(out, data_chunk{}) == script_pattern::non_standard);
+}
+
+BOOST_AUTO_TEST_CASE(address_extractor__extract__block__expected_rows)
+{
+    const auto redeem = make_script("1 [ " KEY1 " ] [ " KEY2 " ] 2 checkmultisig").to_data(false);
+
+    const transaction coinbase
+    {
+        1, 0,
+        { { output_point{ point{ null_hash, point::null_index } }, make_script("[ 0102 ]"), 0 } },
+        {
+            { 50, make_script("dup hash160 [ " HASH1 " ] equalverify checksig") },
+            { 0, make_script("return [ 0102030405 ]") }
+        }
+    };
+
+    const transaction spend
+    {
+        1, 0,
+        {
+            { output_point{ point{ coinbase.hash(), 0 } }, make_script("[ " SIGNATURE " ] [ " KEY1 " ]"), 0 },
+            { output_point{ point{ coinbase.hash(), 1 } }, make_script("zero [ " SIGNATURE " ] [ " + encode_base16(redeem) + " ]"), 0 }
+        },
+        {
+            { 10, make_script("[ " KEY2 " ] checksig") },
+            { 20, make_script("1 [ " KEY1 " ] [ " KEY2 " ] 2 checkmultisig") },
+            { 30, make_script("hash160 [ " HASH1 " ] equal") }
+        }
+    };
+
+    // Round trip so that scripts retain their serialization.
+    const block instance{ header{}, { coinbase, spend } };
+    const auto parsed = block::factory_from_data(instance.to_data());
+    BOOST_REQUIRE(parsed.is_valid());
+
+    address_extractor extractor;
+    address_row::list rows;
+    extractor.extract(rows, parsed, 42);
+
+    short_hash hash1;
+    BOOST_REQUIRE(decode_base16(hash1, HASH1));
+    BOOST_REQUIRE_EQUAL(rows.size(), 7u);
+
+    BOOST_REQUIRE(rows[0].hash == hash1);
+    BOOST_REQUIRE(rows[0].kind == point_kind::output);
+    BOOST_REQUIRE(rows[0].point == point(coinbase.hash(), 0));
+    BOOST_REQUIRE_EQUAL(rows[0].height, 42u);
+    BOOST_REQUIRE_EQUAL(rows[0].value, 50u);
+
+    BOOST_REQUIRE(rows[1].hash == to_hash160(KEY2));
+    BOOST_REQUIRE(rows[1].point == point(spend.hash(), 0));
+    BOOST_REQUIRE_EQUAL(rows[1].value, 10u);
+
+    BOOST_REQUIRE(rows[2].hash == to_hash160(KEY1));
+    BOOST_REQUIRE(rows[3].hash == to_hash160(KEY2));
+    BOOST_REQUIRE(rows[3].point == point(spend.hash(), 1));
+    BOOST_REQUIRE_EQUAL(rows[3].value, 20u);
+
+    BOOST_REQUIRE(rows[4].hash == hash1);
+    BOOST_REQUIRE_EQUAL(rows[4].value, 30u);
+
+    BOOST_REQUIRE(rows[5].hash == to_hash160(KEY1));
+    BOOST_REQUIRE(rows[5].kind == point_kind::spend);
+    BOOST_REQUIRE(rows[5].point == point(spend.hash(), 0));
+    BOOST_REQUIRE_EQUAL(rows[5].previous_checksum, point(coinbase.hash(), 0).checksum());
+
+    BOOST_REQUIRE(rows[6].hash == bitcoin_short_hash(redeem));
+    BOOST_REQUIRE(rows[6].kind == point_kind::spend);
+    BOOST_REQUIRE(rows[6].point == point(spend.hash(), 1));
+}
+
+BOOST_AUTO_TEST_CASE(address_extractor__extract__constructed_scripts__same_rows)
+{
+    const transaction coinbase
+    {
+        1, 0,
+        { { output_point{ point{ null_hash, point::null_index } }, make_script("[ 0102 ]"), 0 } },
+        { { 50, make_script("[ " KEY1 " ] checksig") } }
+    };
+
+    const block instance{ header{}, { coinbase } };
+    address_extractor extractor;
+    address_row::list rows;
+    extractor.extract(rows, instance, 7);
+    extractor.extract(rows, instance, 8);
+
+    BOOST_REQUIRE_EQUAL(rows.size(), 2u);
+    BOOST_REQUIRE(rows[0].hash == to_hash160(KEY1));
+    BOOST_REQUIRE(rows[1].hash == to_hash160(KEY1));
+    BOOST_REQUIRE_EQUAL(rows[1].height, 8u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
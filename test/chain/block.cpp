@@ -48,6 +48,93 @@ static bool all_valid(const chain::transaction::list& transactions)
     return valid;
 }
 
+// Test helper.
+static chain::block block100k()
+{
+    // encodes the 100,000 block data.
+    const data_chunk raw = to_chunk(base16_literal(
+        "010000007f110631052deeee06f0754a3629ad7663e56359fd5f3aa7b3e30a00"
+        "000000005f55996827d9712147a8eb6d7bae44175fe0bcfa967e424a25bfe9f4"
+        "dc118244d67fb74c9d8e2f1bea5ee82a03010000000100000000000000000000"
+        "00000000000000000000000000000000000000000000ffffffff07049d8e2f1b"
+        "0114ffffffff0100f2052a0100000043410437b36a7221bc977dce712728a954"
+        "e3b5d88643ed5aef46660ddcfeeec132724cd950c1fdd008ad4a2dfd354d6af0"
+        "ff155fc17c1ee9ef802062feb07ef1d065f0ac000000000100000001260fd102"
+        "fab456d6b169f6af4595965c03c2296ecf25bfd8790e7aa29b404eff01000000"
+        "8c493046022100c56ad717e07229eb93ecef2a32a42ad041832ffe66bd2e1485"
+        "dc6758073e40af022100e4ba0559a4cebbc7ccb5d14d1312634664bac46f36dd"
+        "d35761edaae20cefb16f01410417e418ba79380f462a60d8dd12dcef8ebfd7ab"
+        "1741c5c907525a69a8743465f063c1d9182eea27746aeb9f1f52583040b1bc34"
+        "1b31ca0388139f2f323fd59f8effffffff0200ffb2081d0000001976a914fc7b"
+        "44566256621affb1541cc9d59f08336d276b88ac80f0fa02000000001976a914"
+        "617f0609c9fabb545105f7898f36b84ec583350d88ac00000000010000000122"
+        "cd6da26eef232381b1a670aa08f4513e9f91a9fd129d912081a3dd138cb01301"
+        "0000008c4930460221009339c11b83f234b6c03ebbc4729c2633cbc8cbd0d157"
+        "74594bfedc45c4f99e2f022100ae0135094a7d651801539df110a028d65459d2"
+        "4bc752d7512bc8a9f78b4ab368014104a2e06c38dc72c4414564f190478e3b0d"
+        "01260f09b8520b196c2f6ec3d06239861e49507f09b7568189efe8d327c3384a"
+        "4e488f8c534484835f8020b3669e5aebffffffff0200ac23fc060000001976a9"
+        "14b9a2c9700ff9519516b21af338d28d53ddf5349388ac00743ba40b00000019"
+        "76a914eb675c349c474bec8dea2d79d12cff6f330ab48788ac00000000"));
+
+    return chain::block::factory_from_data(raw);
+}
+
+// Test helper.
+// Populate prevouts of non-coinbase inputs as p2kh of the input's public key.
+static void populate_prevouts(const chain::block& block)
+{
+    for (const auto& tx: block.transactions())
+    {
+        if (tx.is_coinbase())
+            continue;
+
+        for (const auto& input: tx.inputs())
+        {
+            const auto& point = input.script().operations().back().data();
+            const auto ops = chain::operation::to_pay_key_hash_pattern(
+                bitcoin_short_hash(point));
+            auto& cache = input.previous_output().validation.cache;
+            cache = chain::output(0, chain::script(ops));
+        }
+    }
+}
+
+// Test helper.
+static chain::chain_state::ptr state100k()
+{
+    static const chain::chain_state::checkpoints checkpoints;
+    chain::chain_state::data data;
+    data.testnet = false;
+    data.enabled = false;
+    data.height = 100000;
+    data.bits.ordered = { 0x1b04864c };
+    data.version.unordered = { 1 };
+    data.timestamp.self = 1293623863;
+    data.timestamp.retarget = 1293623863;
+    data.timestamp.ordered = { 1293623863 };
+    return std::make_shared<chain::chain_state>(std::move(data), checkpoints);
+}
+
+// Test helper.
+// A chain state at the given height under which the block header is accepted.
+static chain::chain_state::ptr accept_state(const chain::block& block,
+    size_t height)
+{
+    static const chain::chain_state::checkpoints checkpoints;
+    const auto& header = block.header();
+    chain::chain_state::data data;
+    data.testnet = false;
+    data.enabled = false;
+    data.height = height;
+    data.bits.ordered = { header.bits() };
+    data.version.unordered = { header.version() };
+    data.timestamp.self = header.timestamp() - 1;
+    data.timestamp.retarget = header.timestamp() - 1;
+    data.timestamp.ordered = { header.timestamp() - 1 };
+    return std::make_shared<chain::chain_state>(std::move(data), checkpoints);
+}
+
 BOOST_AUTO_TEST_SUITE(block_tests)
 
 BOOST_AUTO_TEST_CASE(block__locator_size__zero_backoff__returns_top_plus_one)
@@ -654,4 +741,136 @@ BOOST_AUTO_TEST_CASE(validate_block__is_distinct_tx_set__partialy_distinct_not_a
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(block_check_accept_tests)
+
+BOOST_AUTO_TEST_CASE(block__check__block100k__success)
+{
+    const auto block = block100k();
+    BOOST_REQUIRE_EQUAL(block.check(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(block__check__no_transactions__empty_block)
+{
+    auto block = block100k();
+    block.transactions().clear();
+    BOOST_REQUIRE_EQUAL(block.check(), error::empty_block);
+}
+
+BOOST_AUTO_TEST_CASE(block__check__extra_coinbase__extra_coinbases_precedes_duplicate)
+{
+    auto block = block100k();
+    auto& txs = block.transactions();
+    txs.push_back(txs.front());
+    BOOST_REQUIRE_EQUAL(block.check(), error::extra_coinbases);
+}
+
+BOOST_AUTO_TEST_CASE(block__check__first_not_coinbase_and_invalid_transaction__first_not_coinbase)
+{
+    auto block = block100k();
+    auto& txs = block.transactions();
+    std::swap(txs[0], txs[1]);
+    txs.push_back(chain::transaction{});
+    BOOST_REQUIRE_EQUAL(block.check(), error::first_not_coinbase);
+}
+
+BOOST_AUTO_TEST_CASE(block__check__duplicate_transaction__duplicate_precedes_merkle_mismatch)
+{
+    auto block = block100k();
+    auto& txs = block.transactions();
+    txs.push_back(txs.back());
+    BOOST_REQUIRE_EQUAL(block.check(), error::duplicate);
+}
+
+BOOST_AUTO_TEST_CASE(block__check__reordered_transactions__merkle_mismatch)
+{
+    auto block = block100k();
+    auto& txs = block.transactions();
+    std::swap(txs[1], txs[2]);
+    BOOST_REQUIRE_EQUAL(block.check(), error::merkle_mismatch);
+}
+
+BOOST_AUTO_TEST_CASE(block__accept__missing_prevouts__input_not_found)
+{
+    const auto block = block100k();
+    const auto state = accept_state(block, 100000);
+    BOOST_REQUIRE_EQUAL(block.accept(*state), error::input_not_found);
+}
+
+BOOST_AUTO_TEST_CASE(block__accept__excess_claim__coinbase_too_large)
+{
+    auto block = block100k();
+    const auto state = accept_state(block, 100000);
+    auto& coinbase = block.transactions().front();
+    auto& output = coinbase.outputs().front();
+    output.set_value(output.value() + 1);
+    BOOST_REQUIRE_EQUAL(block.accept(*state), error::coinbase_too_large);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(block_connect_transactions_tests)
+
+BOOST_AUTO_TEST_CASE(block__to_input_sets__fanout_two__distributes_all_inputs)
+{
+    const auto block = block100k();
+    const auto sets = block.to_input_sets(2);
+    BOOST_REQUIRE_EQUAL(sets->size(), 2u);
+    BOOST_REQUIRE_EQUAL((*sets)[0].size() + (*sets)[1].size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(block__to_input_sets__without_coinbase__excludes_coinbase_input)
+{
+    const auto block = block100k();
+    const auto sets = block.to_input_sets(1, false);
+    BOOST_REQUIRE_EQUAL(sets->size(), 1u);
+    BOOST_REQUIRE_EQUAL(sets->front().size(), 2u);
+    BOOST_REQUIRE(&sets->front().front().tx == &block.transactions()[1]);
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__missing_prevouts__parallel_matches_serial)
+{
+    threadpool pool(4);
+    const auto block = block100k();
+    const auto state = state100k();
+    const auto serial = block.connect_transactions(*state);
+    BOOST_REQUIRE_EQUAL(serial, error::input_not_found);
+    BOOST_REQUIRE_EQUAL(block.connect_transactions(*state, pool), serial);
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__valid_prevouts__parallel_matches_serial)
+{
+    threadpool pool(4);
+    const auto block = block100k();
+    const auto state = state100k();
+    populate_prevouts(block);
+    const auto serial = block.connect_transactions(*state);
+    BOOST_REQUIRE_EQUAL(serial, error::success);
+    BOOST_REQUIRE_EQUAL(block.connect_transactions(*state, pool), serial);
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__invalid_prevout__parallel_matches_serial)
+{
+    threadpool pool(4);
+    const auto block = block100k();
+    const auto state = state100k();
+    populate_prevouts(block);
+    const auto& input = block.transactions()[2].inputs().front();
+    const auto ops = chain::operation::to_pay_key_hash_pattern(null_short_hash);
+    input.previous_output().validation.cache.set_script(chain::script(ops));
+    const auto serial = block.connect_transactions(*state);
+    BOOST_REQUIRE_EQUAL(serial, error::validate_inputs_failed);
+    BOOST_REQUIRE_EQUAL(block.connect_transactions(*state, pool), serial);
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__empty_pool__matches_serial)
+{
+    threadpool pool;
+    const auto block = block100k();
+    const auto state = state100k();
+    populate_prevouts(block);
+    BOOST_REQUIRE_EQUAL(block.connect_transactions(*state, pool), error::success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
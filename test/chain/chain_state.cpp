@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+// A synthetic chain, with values by height.
+struct chain_values
+{
+    std::vector<uint32_t> versions;
+    std::vector<uint32_t> timestamps;
+    std::vector<uint32_t> bits;
+};
+
+static chain_values make_chain(size_t count, size_t version_4_from)
+{
+    chain_values chain;
+
+    for (size_t height = 0; height < count; ++height)
+    {
+        // Timestamps are not monotonic, so the median window is exercised.
+        const auto jitter = static_cast<uint32_t>((height * 7919) % 1200);
+        chain.timestamps.push_back(1231006505 + 600 * height + jitter);
+        chain.versions.push_back(height < version_4_from ?
+            static_cast<uint32_t>(1 + height % 3) : 4);
+        chain.bits.push_back(height % 50 == 7 ? 0x1c0fffff : 0x1d00ffff);
+    }
+
+    return chain;
+}
+
+// The sample of each value over the height range.
+static std::vector<uint32_t> sample(const std::vector<uint32_t>& values,
+    const chain_state::range& range)
+{
+    return std::vector<uint32_t>(values.begin() + range.low,
+        values.begin() + range.high + 1);
+}
+
+// The data of the height map, as for full construction.
+static chain_state::data full_data(const chain_values& chain, size_t height,
+    bool testnet, bool enabled)
+{
+    const auto map = chain_state::get_map(height, enabled, testnet);
+
+    chain_state::data data;
+    data.testnet = testnet;
+    data.enabled = enabled;
+    data.height = height;
+    data.bits.ordered = sample(chain.bits, map.bits);
+    data.version.unordered = sample(chain.versions, map.version);
+    data.timestamp.ordered = sample(chain.timestamps, map.timestamp);
+    data.timestamp.self = chain.timestamps[map.timestamp_self];
+    data.timestamp.retarget = chain.timestamps[map.timestamp_retarget];
+    return data;
+}
+
+// Each full construction is enabled as cached from the preceding height.
+static void require_promotion_matches(const chain_values& chain,
+    size_t first, size_t count, bool testnet, bool enabled)
+{
+    static const chain_state::checkpoints checkpoints;
+    static const rule_fork forks[] =
+    {
+        rule_fork::bip16_rule,
+        rule_fork::bip30_rule,
+        rule_fork::bip34_rule,
+        rule_fork::bip65_rule,
+        rule_fork::bip66_rule
+    };
+
+    auto state = std::make_shared<chain_state>(full_data(chain, first,
+        testnet, enabled), checkpoints);
+    auto previous = state;
+
+    for (size_t height = first + 1; height < count; ++height)
+    {
+        const auto parent = height - 1;
+        const header top(chain.versions[parent], null_hash, null_hash,
+            chain.timestamps[parent], chain.bits[parent], 0);
+
+        const auto retarget = height % retargeting_interval == 0 ?
+            chain.timestamps[height - retargeting_interval] : 0;
+
+        state = std::make_shared<chain_state>(*state, top,
+            chain.timestamps[height], retarget);
+
+        const auto full = std::make_shared<chain_state>(full_data(chain,
+            height, testnet, previous->is_enabled()), checkpoints);
+
+        BOOST_REQUIRE_EQUAL(state->height(), height);
+        BOOST_REQUIRE_EQUAL(state->is_enabled(), full->is_enabled());
+        BOOST_REQUIRE_EQUAL(state->enabled_forks(), full->enabled_forks());
+        BOOST_REQUIRE_EQUAL(state->minimum_version(), full->minimum_version());
+        BOOST_REQUIRE_EQUAL(state->median_time_past(), full->median_time_past());
+        BOOST_REQUIRE_EQUAL(state->work_required(), full->work_required());
+
+        for (const auto fork: forks)
+            BOOST_REQUIRE_EQUAL(state->is_enabled(fork), full->is_enabled(fork));
+
+        previous = full;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(chain_state_tests)
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__mainnet__matches_full_construction)
+{
+    static const size_t count = 1300;
+    const auto chain = make_chain(count, 200);
+    require_promotion_matches(chain, 1, count, false, true);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__mainnet_enabled__matches_full_construction)
+{
+    // Version 4 enforcement begins during promotion.
+    static const size_t count = 2300;
+    const auto chain = make_chain(count, 200);
+    require_promotion_matches(chain, 1001, count, false, true);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__mainnet_not_enabled__matches_full_construction)
+{
+    // The full version sample would activate, the reduced sample does not.
+    static const size_t count = 2300;
+    const auto chain = make_chain(count, 200);
+    require_promotion_matches(chain, 1001, count, false, false);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__testnet_across_retarget__matches_full_construction)
+{
+    static const size_t count = 2100;
+    const auto chain = make_chain(count, 40);
+    require_promotion_matches(chain, 101, count, true, true);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__testnet_not_enabled__matches_full_construction)
+{
+    static const size_t count = 2100;
+    const auto chain = make_chain(count, 40);
+    require_promotion_matches(chain, 101, count, true, false);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__promote__activation__forks_enabled)
+{
+    static const size_t count = 1300;
+    static const chain_state::checkpoints checkpoints;
+    const auto chain = make_chain(count, 200);
+    const chain_state full(full_data(chain, count - 1, false, true),
+        checkpoints);
+    BOOST_REQUIRE(full.is_enabled(rule_fork::bip65_rule));
+    BOOST_REQUIRE_EQUAL(full.minimum_version(), bip65_version);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
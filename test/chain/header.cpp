@@ -21,6 +21,8 @@
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin.hpp>
 #include <chrono>
+#include <thread>
+#include <vector>
 
 using namespace bc;
 
@@ -494,6 +496,73 @@ BOOST_AUTO_TEST_CASE(header__is_valid_proof_of_work__hash_less_than_bits__return
     BOOST_REQUIRE_EQUAL(true, instance.is_valid_proof_of_work());
 }
 
+BOOST_AUTO_TEST_CASE(header__hash__mainnet_genesis__expected)
+{
+    const chain::header instance
+    {
+        1,
+        null_hash,
+        hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+        1231006505,
+        0x1d00ffff,
+        2083236893
+    };
+
+    const auto expected = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    BOOST_REQUIRE(instance.hash() == expected);
+    BOOST_REQUIRE(instance.hash() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(header__hash__modified__recomputed)
+{
+    chain::header instance
+    {
+        1,
+        null_hash,
+        hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+        1231006505,
+        0x1d00ffff,
+        2083236893
+    };
+
+    const auto expected = instance.hash();
+    instance.set_nonce(42);
+    BOOST_REQUIRE(instance.hash() != expected);
+    BOOST_REQUIRE(instance.hash() == bitcoin_hash(instance.to_data(false)));
+
+    instance.set_nonce(2083236893);
+    BOOST_REQUIRE(instance.hash() == expected);
+
+    instance.merkle()[0] = 42;
+    BOOST_REQUIRE(instance.hash() != expected);
+}
+
+BOOST_AUTO_TEST_CASE(header__hash__concurrent_readers__consistent)
+{
+    const chain::header instance
+    {
+        1,
+        null_hash,
+        hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+        1231006505,
+        0x1d00ffff,
+        2083236893
+    };
+
+    const auto expected = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    std::vector<hash_digest> hashes(8);
+    std::vector<std::thread> threads;
+
+    for (auto& hash: hashes)
+        threads.emplace_back([&]() { hash = instance.hash(); });
+
+    for (auto& thread: threads)
+        thread.join();
+
+    for (const auto& hash: hashes)
+        BOOST_REQUIRE(hash == expected);
+}
+
 BOOST_AUTO_TEST_CASE(header__operator_assign_equals__always__matches_equivalent)
 {
     // This must be non-const.
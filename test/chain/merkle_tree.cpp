@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(merkle_tree_tests)
+
+// Mainnet block 100000.
+#define BLOCK100000_MERKLE "f3e94742aca4b5ef85488dc37c06c3282295ffec960994b2c0d5ac2a25a95766"
+#define BLOCK100000_TX0 "8c14f0db3df150123e6f3dbbf30f8b955a8249b62ac1d1ff16284aefa3d06d87"
+#define BLOCK100000_TX1 "fff2525b8931402dd09222c50775608f75787bd2b87e56995a7bdd30f79702c4"
+#define BLOCK100000_TX2 "6359f0868171b1d194cbee1af2f16ea598ae8fad666d9b012c8ed2b79a236ec4"
+#define BLOCK100000_TX3 "e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d"
+
+static hash_list block100000_hashes()
+{
+    return
+    {
+        hash_literal(BLOCK100000_TX0),
+        hash_literal(BLOCK100000_TX1),
+        hash_literal(BLOCK100000_TX2),
+        hash_literal(BLOCK100000_TX3)
+    };
+}
+
+static hash_list make_hashes(size_t count)
+{
+    hash_list hashes;
+
+    for (size_t index = 0; index < count; ++index)
+        hashes.push_back(bitcoin_hash(to_chunk(to_little_endian(index))));
+
+    return hashes;
+}
+
+// Every subset of the leaves (by bit mask) round trips through a partial tree.
+static void require_all_subsets_roundtrip(const hash_list& leaves)
+{
+    const merkle_tree tree(leaves);
+
+    for (size_t mask = 0; mask < (size_t(1) << leaves.size()); ++mask)
+    {
+        merkle_tree::indexes positions;
+
+        for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+            if (((mask >> leaf) & 1) != 0)
+                positions.push_back(leaf);
+
+        hash_list hashes;
+        data_chunk flags;
+        tree.partial(hashes, flags, positions);
+
+        hash_list matches;
+        merkle_tree::indexes extracted;
+        const auto root = merkle_tree::extract(matches, extracted, leaves.size(), hashes, flags);
+        BOOST_REQUIRE(root == tree.root());
+        BOOST_REQUIRE(extracted == positions);
+        BOOST_REQUIRE_EQUAL(matches.size(), positions.size());
+
+        for (size_t match = 0; match < matches.size(); ++match)
+            BOOST_REQUIRE(matches[match] == leaves[positions[match]]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__root__empty__null_hash)
+{
+    const merkle_tree tree(hash_list{});
+    BOOST_REQUIRE(tree.root() == null_hash);
+    BOOST_REQUIRE_EQUAL(tree.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__root__genesis__expected)
+{
+    const auto genesis = block::genesis_mainnet();
+    const merkle_tree tree(hash_list{ genesis.transactions().front().hash() });
+    BOOST_REQUIRE(tree.root() == genesis.header().merkle());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__root__block100000__expected)
+{
+    const merkle_tree tree(block100000_hashes());
+    BOOST_REQUIRE(tree.root() == hash_literal(BLOCK100000_MERKLE));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__root__odd_leaves__generate_merkle_root)
+{
+    block instance;
+
+    for (uint32_t index = 0; index < 7; ++index)
+    {
+        transaction tx;
+        tx.set_locktime(index);
+        instance.transactions().push_back(tx);
+    }
+
+    hash_list hashes;
+
+    for (const auto& tx: instance.transactions())
+        hashes.push_back(tx.hash());
+
+    const merkle_tree tree(std::move(hashes));
+    BOOST_REQUIRE(tree.root() == instance.generate_merkle_root());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__partial__block100000_third_transaction__expected)
+{
+    const auto leaves = block100000_hashes();
+    const merkle_tree tree(leaves);
+    hash_list hashes;
+    data_chunk flags;
+    tree.partial(hashes, flags, { 2 });
+
+    // Bits are root, left (pruned), right, leaf 2, leaf 3.
+    BOOST_REQUIRE_EQUAL(flags.size(), 1u);
+    BOOST_REQUIRE_EQUAL(flags[0], 0x0d);
+    BOOST_REQUIRE_EQUAL(hashes.size(), 3u);
+    BOOST_REQUIRE(hashes[0] == bitcoin_hash(build_chunk({ leaves[0], leaves[1] })));
+    BOOST_REQUIRE(hashes[1] == leaves[2]);
+    BOOST_REQUIRE(hashes[2] == leaves[3]);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__extract__block100000_all_subsets__roundtrip)
+{
+    require_all_subsets_roundtrip(block100000_hashes());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__extract__odd_leaves_all_subsets__roundtrip)
+{
+    require_all_subsets_roundtrip(make_hashes(1));
+    require_all_subsets_roundtrip(make_hashes(3));
+    require_all_subsets_roundtrip(make_hashes(7));
+    require_all_subsets_roundtrip(make_hashes(11));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__extract__zero_leaves__null_hash)
+{
+    hash_list matches;
+    merkle_tree::indexes positions;
+    BOOST_REQUIRE(merkle_tree::extract(matches, positions, 0, {}, {}) == null_hash);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__extract__extra_hash__null_hash)
+{
+    const merkle_tree tree(block100000_hashes());
+    hash_list hashes;
+    data_chunk flags;
+    tree.partial(hashes, flags, { 1 });
+    hashes.push_back(null_hash);
+
+    hash_list matches;
+    merkle_tree::indexes positions;
+    BOOST_REQUIRE(merkle_tree::extract(matches, positions, tree.size(), hashes, flags) == null_hash);
+    BOOST_REQUIRE(matches.empty());
+    BOOST_REQUIRE(positions.empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__extract__extra_flag_byte__null_hash)
+{
+    const merkle_tree tree(block100000_hashes());
+    hash_list hashes;
+    data_chunk flags;
+    tree.partial(hashes, flags, { 1 });
+    flags.push_back(0x00);
+
+    hash_list matches;
+    merkle_tree::indexes positions;
+    BOOST_REQUIRE(merkle_tree::extract(matches, positions, tree.size(), hashes, flags) == null_hash);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_tree__extract__missing_hash__null_hash)
+{
+    const merkle_tree tree(block100000_hashes());
+    hash_list hashes;
+    data_chunk flags;
+    tree.partial(hashes, flags, { 1 });
+    hashes.pop_back();
+
+    hash_list matches;
+    merkle_tree::indexes positions;
+    BOOST_REQUIRE(merkle_tree::extract(matches, positions, tree.size(), hashes, flags) == null_hash);
+}
+
+// The tree of [a, b, c, c] has the root of [a, b, c] (CVE-2012-2459).
+BOOST_AUTO_TEST_CASE(merkle_tree__extract__duplicated_right_branch__null_hash)
+{
+    auto leaves = make_hashes(3);
+    const merkle_tree tree(leaves);
+    leaves.push_back(leaves.back());
+    const merkle_tree mutated(leaves);
+    BOOST_REQUIRE(tree.root() == mutated.root());
+
+    hash_list hashes;
+    data_chunk flags;
+    mutated.partial(hashes, flags, { 0, 1, 2, 3 });
+
+    hash_list matches;
+    merkle_tree::indexes positions;
+    BOOST_REQUIRE(merkle_tree::extract(matches, positions, mutated.size(), hashes, flags) == null_hash);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -269,6 +269,88 @@ BOOST_AUTO_TEST_CASE(script__from_data__to_data__roundtrips)
     BOOST_REQUIRE(roundtrip == normal_output_script);
 }
 
+BOOST_AUTO_TEST_CASE(script__from_data__multiple_operations__sized_exactly)
+{
+    const auto normal_output_script = to_chunk(base16_literal("76a91406ccef231c2db72526df9338894ccf9355e8f12188ac"));
+
+    script out_script;
+    BOOST_REQUIRE(out_script.from_data(normal_output_script, false, script::parse_mode::strict));
+    BOOST_REQUIRE_EQUAL(out_script.operations().size(), 5u);
+    BOOST_REQUIRE_EQUAL(out_script.operations().capacity(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(script__from_data__truncated_push__fails)
+{
+    const auto truncated_script = to_chunk(base16_literal("4d0500aabb"));
+
+    script parsed;
+    BOOST_REQUIRE(!parsed.from_data(truncated_script, false, script::parse_mode::strict));
+}
+
+BOOST_AUTO_TEST_CASE(script__from_data__pay_key_hash__matches_parsed_operations)
+{
+    const auto normal_output_script = to_chunk(base16_literal("76a91406ccef231c2db72526df9338894ccf9355e8f12188ac"));
+
+    script out_script;
+    BOOST_REQUIRE(out_script.from_data(normal_output_script, false, script::parse_mode::strict));
+    BOOST_REQUIRE(out_script.pattern() == script_pattern::pay_key_hash);
+    BOOST_REQUIRE_EQUAL(out_script.sigops(false), 1u);
+    BOOST_REQUIRE_EQUAL(out_script.satoshi_content_size(), normal_output_script.size());
+
+    const script parsed(out_script.operations());
+    BOOST_REQUIRE(parsed.pattern() == script_pattern::pay_key_hash);
+    BOOST_REQUIRE_EQUAL(parsed.sigops(false), 1u);
+    BOOST_REQUIRE(parsed == out_script);
+    BOOST_REQUIRE(parsed.to_data(false) == normal_output_script);
+}
+
+BOOST_AUTO_TEST_CASE(script__from_data__pay_script_hash__pattern)
+{
+    const auto p2sh_output_script = to_chunk(base16_literal("a914f815b036d9bbbce5e9f2a00abd1bf3dc91e9551087"));
+
+    script out_script;
+    BOOST_REQUIRE(out_script.from_data(p2sh_output_script, false, script::parse_mode::strict));
+    BOOST_REQUIRE(out_script.pattern() == script_pattern::pay_script_hash);
+    BOOST_REQUIRE_EQUAL(out_script.sigops(true), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(script__copy__read_script__equal_and_roundtrips)
+{
+    const auto normal_output_script = to_chunk(base16_literal("76a91406ccef231c2db72526df9338894ccf9355e8f12188ac"));
+
+    script out_script;
+    BOOST_REQUIRE(out_script.from_data(normal_output_script, false, script::parse_mode::strict));
+
+    const script copy(out_script);
+    BOOST_REQUIRE(copy == out_script);
+    BOOST_REQUIRE(copy.to_data(false) == normal_output_script);
+    BOOST_REQUIRE_EQUAL(copy.operations().size(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(script__operations__modified__reserializes)
+{
+    const auto normal_output_script = to_chunk(base16_literal("76a91406ccef231c2db72526df9338894ccf9355e8f12188ac"));
+
+    script out_script;
+    BOOST_REQUIRE(out_script.from_data(normal_output_script, false, script::parse_mode::strict));
+    out_script.operations().pop_back();
+
+    const auto expected = to_chunk(base16_literal("76a91406ccef231c2db72526df9338894ccf9355e8f12188"));
+    BOOST_REQUIRE(out_script.to_data(false) == expected);
+    BOOST_REQUIRE_EQUAL(out_script.sigops(false), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(script__from_data__multisig__sigops_from_serialized)
+{
+    const auto multisig_script = to_chunk(base16_literal("52210282a0f4ab2ae1a0c8c7c5a7f0a6d41e82f0f1d55f34ba5e9b1cb6c1bdc0c6c2ce2102d7bd5ac1d6f7a8a7f0c1aa6d4b0fd7ca8b7d4c2f1d3c9ce3f9e1a5c8d3b0e4f552ae"));
+
+    script out_script;
+    BOOST_REQUIRE(out_script.from_data(multisig_script, false, script::parse_mode::strict));
+    BOOST_REQUIRE_EQUAL(out_script.sigops(true), 2u);
+    BOOST_REQUIRE_EQUAL(out_script.sigops(false), 20u);
+    BOOST_REQUIRE_EQUAL(script(out_script.operations()).sigops(true), 2u);
+}
+
 BOOST_AUTO_TEST_CASE(script__from_data__to_data_weird__roundtrips)
 {
     const auto weird_raw_script = to_chunk(base16_literal(
@@ -575,6 +657,170 @@ BOOST_AUTO_TEST_CASE(script__checksig__normal)
     BOOST_REQUIRE(script::check_signature(signature, signature_hash_algorithm::single, pubkey, script_code, parent_tx, input_index));
 }
 
+BOOST_AUTO_TEST_CASE(script__verify__pay_key_hash__expected)
+{
+    // input 315ac7d4c26d69668129cc352851d9389b4a6868f1509c6c8b66bead11e2619f:0
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000002dc38e9359bd7da3b58386204e186d9408685f427f5e513666db735aa8a6b2169000000006a47304402205d8feeb312478e468d0b514e63e113958d7214fa572acd87079a7f0cc026fc5c02200fa76ea05bf243af6d0f9177f241caf606d01fcfd5e62d6befbca24e569e5c27032102100a1a9ca2c18932d6577c58f225580184d0e08226d41959874ac963e3c1b2feffffffffdc38e9359bd7da3b58386204e186d9408685f427f5e513666db735aa8a6b2169010000006b4830450220087ede38729e6d35e4f515505018e659222031273b7366920f393ee3ab17bc1e022100ca43164b757d1a6d1235f13200d4b5f76dd8fda4ec9fc28546b2df5b1211e8df03210275983913e60093b767e85597ca9397fb2f418e57f998d6afbbc536116085b1cbffffffff0140899500000000001976a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48c88ac00000000");
+    transaction parent_tx;
+    BOOST_REQUIRE(parent_tx.from_data(tx_data));
+
+    script prevout_script;
+    BOOST_REQUIRE(prevout_script.from_data(to_chunk(base16_literal("76a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48c88ac")), false, script::parse_mode::strict));
+    BOOST_REQUIRE(prevout_script.pattern() == script_pattern::pay_key_hash);
+    BOOST_REQUIRE_EQUAL(script::verify(parent_tx, 0, prevout_script, rule_fork::all_rules), error::success);
+
+    script other_script;
+    BOOST_REQUIRE(other_script.from_data(to_chunk(base16_literal("76a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48d88ac")), false, script::parse_mode::strict));
+    BOOST_REQUIRE(script::verify(parent_tx, 0, other_script, rule_fork::all_rules) != error::success);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__repeated__hits_verified_signatures)
+{
+    // input 315ac7d4c26d69668129cc352851d9389b4a6868f1509c6c8b66bead11e2619f:0
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000002dc38e9359bd7da3b58386204e186d9408685f427f5e513666db735aa8a6b2169000000006a47304402205d8feeb312478e468d0b514e63e113958d7214fa572acd87079a7f0cc026fc5c02200fa76ea05bf243af6d0f9177f241caf606d01fcfd5e62d6befbca24e569e5c27032102100a1a9ca2c18932d6577c58f225580184d0e08226d41959874ac963e3c1b2feffffffffdc38e9359bd7da3b58386204e186d9408685f427f5e513666db735aa8a6b2169010000006b4830450220087ede38729e6d35e4f515505018e659222031273b7366920f393ee3ab17bc1e022100ca43164b757d1a6d1235f13200d4b5f76dd8fda4ec9fc28546b2df5b1211e8df03210275983913e60093b767e85597ca9397fb2f418e57f998d6afbbc536116085b1cbffffffff0140899500000000001976a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48c88ac00000000");
+    transaction parent_tx;
+    BOOST_REQUIRE(parent_tx.from_data(tx_data));
+
+    script prevout_script;
+    BOOST_REQUIRE(prevout_script.from_data(to_chunk(base16_literal("76a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48c88ac")), false, script::parse_mode::strict));
+    BOOST_REQUIRE_EQUAL(script::verify(parent_tx, 0, prevout_script, rule_fork::all_rules), error::success);
+
+    const auto hits = script::verified_signatures().hits();
+    BOOST_REQUIRE_EQUAL(script::verify(parent_tx, 0, prevout_script, rule_fork::all_rules), error::success);
+    BOOST_REQUIRE_EQUAL(script::verified_signatures().hits(), hits + 1u);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_script_hash_without_bip16__compares_hash)
+{
+    // input 315ac7d4c26d69668129cc352851d9389b4a6868f1509c6c8b66bead11e2619f:0
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000002dc38e9359bd7da3b58386204e186d9408685f427f5e513666db735aa8a6b2169000000006a47304402205d8feeb312478e468d0b514e63e113958d7214fa572acd87079a7f0cc026fc5c02200fa76ea05bf243af6d0f9177f241caf606d01fcfd5e62d6befbca24e569e5c27032102100a1a9ca2c18932d6577c58f225580184d0e08226d41959874ac963e3c1b2feffffffffdc38e9359bd7da3b58386204e186d9408685f427f5e513666db735aa8a6b2169010000006b4830450220087ede38729e6d35e4f515505018e659222031273b7366920f393ee3ab17bc1e022100ca43164b757d1a6d1235f13200d4b5f76dd8fda4ec9fc28546b2df5b1211e8df03210275983913e60093b767e85597ca9397fb2f418e57f998d6afbbc536116085b1cbffffffff0140899500000000001976a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48c88ac00000000");
+    transaction parent_tx;
+    BOOST_REQUIRE(parent_tx.from_data(tx_data));
+
+    // The last push of the input script is the public key, hashing to fcc9b3...
+    script prevout_script;
+    BOOST_REQUIRE(prevout_script.from_data(to_chunk(base16_literal("a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48c87")), false, script::parse_mode::strict));
+    BOOST_REQUIRE(prevout_script.pattern() == script_pattern::pay_script_hash);
+    BOOST_REQUIRE_EQUAL(script::verify(parent_tx, 0, prevout_script, rule_fork::no_rules), error::success);
+
+    script other_script;
+    BOOST_REQUIRE(other_script.from_data(to_chunk(base16_literal("a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48d87")), false, script::parse_mode::strict));
+    BOOST_REQUIRE(script::verify(parent_tx, 0, other_script, rule_fork::no_rules) != error::success);
+}
+
+// Spend a single input with an input script of the endorsements of the signers
+// over the output script, corrupting the signature of the last if requested.
+static code verify_endorsed(const std::string& output,
+    const std::vector<ec_secret>& signers, bool corrupt)
+{
+    data_chunk tx_data;
+    decode_base16(tx_data, "0100000001b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee0970100000000ffffffff01905f0100000000001976a91418c0bd8d1818f1bf99cb1df2269c645318ef7b7388ac00000000");
+    transaction tx;
+    BOOST_REQUIRE(tx.from_data(tx_data));
+
+    script prevout_script;
+    BOOST_REQUIRE(prevout_script.from_string(output));
+
+    // The extra item popped by checkmultisig.
+    std::vector<std::string> tokens;
+    if (boost::ends_with(output, "checkmultisig"))
+        tokens.push_back("zero");
+
+    for (const auto& secret: signers)
+    {
+        endorsement out;
+        BOOST_REQUIRE(script::create_endorsement(out, secret, prevout_script, tx, 0, signature_hash_algorithm::all));
+
+        if (corrupt && &secret == &signers.back())
+            out[10] ^= 0x01;
+
+        tokens.push_back("[ " + encode_base16(out) + " ]");
+    }
+
+    script input_script;
+    if (!tokens.empty())
+        BOOST_REQUIRE(input_script.from_string(boost::join(tokens, " ")));
+
+    auto inputs = tx.inputs();
+    inputs.front().set_script(input_script);
+    tx.set_inputs(inputs);
+    return script::verify(tx, 0, prevout_script, rule_fork::all_rules);
+}
+
+// The output script matches the pattern, so verify evaluates it directly. A
+// leading nop defeats the pattern, so the general evaluator runs the otherwise
+// identical script, and the results must agree.
+static void require_direct_matches_general(const std::string& output,
+    script_pattern pattern, const std::vector<ec_secret>& signers,
+    bool corrupt, bool expected)
+{
+    script prevout_script;
+    BOOST_REQUIRE(prevout_script.from_string(output));
+    BOOST_REQUIRE(prevout_script.pattern() == pattern);
+
+    const auto direct = verify_endorsed(output, signers, corrupt);
+    const auto general = verify_endorsed("nop " + output, signers, corrupt);
+    BOOST_REQUIRE_EQUAL(direct, general);
+    BOOST_REQUIRE_EQUAL(direct == error::success, expected);
+}
+
+static std::string to_public_key(const ec_secret& secret)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    return "[ " + encode_base16(point) + " ]";
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_public_key__matches_general_evaluator)
+{
+    const ec_secret secret1 = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+    const ec_secret secret2 = hash_literal("8010b1bb119ad37d4b65a1022a314897b1b3614b345974332cb1b9582cf03536");
+    const auto output = to_public_key(secret1) + " checksig";
+    const auto pattern = script_pattern::pay_public_key;
+
+    require_direct_matches_general(output, pattern, { secret1 }, false, true);
+    require_direct_matches_general(output, pattern, { secret1 }, true, false);
+    require_direct_matches_general(output, pattern, { secret2 }, false, false);
+    require_direct_matches_general(output, pattern, {}, false, false);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__pay_multisig__matches_general_evaluator)
+{
+    const ec_secret secret1 = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+    const ec_secret secret2 = hash_literal("8010b1bb119ad37d4b65a1022a314897b1b3614b345974332cb1b9582cf03536");
+    const ec_secret secret3 = hash_literal("0b7f2b7ee9ea7e1a5ca46ab3b3e1e2e3c3b5b26b1fd0c1a1b9e8fe3c8f2a1b77");
+    const auto keys = to_public_key(secret1) + " " + to_public_key(secret2);
+    const auto one_of_two = "1 " + keys + " 2 checkmultisig";
+    const auto two_of_two = "2 " + keys + " 2 checkmultisig";
+    const auto pattern = script_pattern::pay_multisig;
+
+    require_direct_matches_general(one_of_two, pattern, { secret1 }, false, true);
+    require_direct_matches_general(one_of_two, pattern, { secret2 }, false, true);
+    require_direct_matches_general(one_of_two, pattern, { secret3 }, false, false);
+    require_direct_matches_general(one_of_two, pattern, { secret2 }, true, false);
+    require_direct_matches_general(two_of_two, pattern, { secret1, secret2 }, false, true);
+    require_direct_matches_general(two_of_two, pattern, { secret1, secret2 }, true, false);
+    require_direct_matches_general(two_of_two, pattern, { secret2, secret1 }, false, false);
+    require_direct_matches_general(two_of_two, pattern, { secret1 }, false, false);
+    require_direct_matches_general(two_of_two, pattern, {}, false, false);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__multisig_wrong_key_count__matches_general_evaluator)
+{
+    const ec_secret secret1 = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+    const ec_secret secret2 = hash_literal("8010b1bb119ad37d4b65a1022a314897b1b3614b345974332cb1b9582cf03536");
+    const auto keys = to_public_key(secret1) + " " + to_public_key(secret2);
+    const auto pattern = script_pattern::non_standard;
+
+    // A key count that differs from the number of keys is not the pattern.
+    require_direct_matches_general("1 " + keys + " 3 checkmultisig", pattern, { secret1 }, false, false);
+    require_direct_matches_general("1 " + keys + " 1 checkmultisig", pattern, { secret1 }, false, false);
+    require_direct_matches_general("3 " + keys + " 2 checkmultisig", pattern, { secret1, secret2 }, false, false);
+}
+
 BOOST_AUTO_TEST_CASE(script__create_endorsement__single_input_single_output__expected)
 {
     data_chunk tx_data;
@@ -638,4 +884,123 @@ BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all__expected)
     BOOST_REQUIRE_EQUAL(result, expected);
 }
 
+// A tx of 20 inputs and 3 outputs, spanning multiple signature hash midstates.
+static transaction signature_hash_test_tx()
+{
+    data_chunk tx_data;
+    decode_base16(tx_data, "01000000146e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d0000000000ffffffff4bf5122f344554c53bde2ebb8cd2b7e3d1600ad631c385a5d7cce23c7785459a010000000151feffffffdbc1b4c900ffe48d575b5da5c638040125f65db0fe3e24494b76ea986457d9860200000000fdffffff084fed08b978af4d7d196a7446a86b58009e636b611db16211b65a9aadff29c5000000000151fcffffffe52d9c508c502347344d8c07ad91cbd6068afc75ff6292f062a09ca381c89e710100000000fbffffffe77b9a9ae9e30b0dbdb6f510a264ef9de781501d7b6b92ae89eb059c5ab743db020000000151faffffff67586e98fad27da0b9968bc039a1ef34c939b9b8e523a8bef89d478608c5ecf60000000000f9ffffffca358758f6d27e6cf45272937977a748fd88391db679ceda7dc7bf1f005ee879010000000151f8ffffffbeead77994cf573341ec17b58bbf7eb34d2711c993c1d976b128b3188dc1829a0200000000f7ffffff2b4c342f5433ebe591a1da77e013d1b72475562d48578dca8b84bac6651c3cb9000000000151f6ffffff01ba4719c80b6fe911b091a7c05124b64eeece964e09c058ef8f9805daca546b0100000000f5ffffffe7cf46a078fed4fafd0b5e3aff144802b853f8ae459a4f0c14add3314b7cc3a6020000000151f4ffffffef6cbd2161eaea7943ce8693b9824d23d1793ffb1c0fca05b600d3899b44c9770000000000f3ffffff9d1e0e2d9459d06523ad13e28a4093c2316baafe7aec5b25f30eba2e113599c4010000000151f2ffffff4d7b3ef7300acf70c892d8327db8272f54434adbc61a4e130a563cb59a0d0f470200000000f1ffffffdc0e9c3658a1a3ed1ec94274d8b19925c93e1abb7ddba294923ad9bde30f8cb8000000000151f0ffffffc555eab45d08845ae9f10d452a99bfcb06f74a50b988fe7e48dd323789b88ee30100000000efffffff4a64a107f0cb32536e5bce6c98c393db21cca7f4ea187ba8c4dca8b51d4ea80a020000000151eefffffff299791cddd3d6664f6670842812ef6053eb6501bd6282a476bbbf3ee91e750c0000000000edffffffab897fbdedfa502b2d839b6a56100887dccdc507555c282e59589e06300a62e2010000000151ecffffff03e8030000000000001976a914000000000000000000000000000000000000000088acd0070000000000001976a914010101010101010101010101010101010101010188acb80b0000000000001976a914020202020202020202020202020202020202020288ac00000000");
+    return transaction::factory_from_data(tx_data);
+}
+
+static script signature_hash_test_script()
+{
+    script prevout_script;
+    prevout_script.from_string("dup hash160 [ 88350574280395ad2c3e2ee20e322073d94e5e40 ] equalverify checksig");
+    return prevout_script;
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all_first_input__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 0;
+    const uint8_t sighash_type = signature_hash_algorithm::all;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "142de596fcaf6c3d346107e25782869f3d503cf925b474e07e6131cafef650c3");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all_midstate_boundary__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 16;
+    const uint8_t sighash_type = signature_hash_algorithm::all;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "0f2f08c7a96b0bc176533c8f01b464687fbc91ab40d627e24c3e93d63ca04ec0");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all_after_midstate__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 17;
+    const uint8_t sighash_type = signature_hash_algorithm::all;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "a4990999cc2fcc801e37754b4fa6e190122273c1ee2868045d2bb53001d01bb2");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all_last_input__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 19;
+    const uint8_t sighash_type = signature_hash_algorithm::all;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "ea4e092a3a174fee3ecf51ce54491e6fe8d7913231cb355173712baa711db461");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__none__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 17;
+    const uint8_t sighash_type = signature_hash_algorithm::none;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "6829fe5a7e172ccdab16caa55bbff00ff27661e16b1308d7d435ac6061f3cbec");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__single__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 1;
+    const uint8_t sighash_type = signature_hash_algorithm::single;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "85f6cd8d9bf36b0007d68829b52db02e7689e4652dff7c956aca6639e57bd0d0");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all_anyone_can_pay__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 17;
+    const uint8_t sighash_type = signature_hash_algorithm::all_anyone_can_pay;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "9614068c017386b5e3e886cd80199d5c4600314d42dc28b9dd0663702271f385");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__none_anyone_can_pay__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 17;
+    const uint8_t sighash_type = signature_hash_algorithm::none_anyone_can_pay;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "7596a88566d816ccc0ec8bad5a6c561b35ca1aba827f8796ec445ffaf484a6e9");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__single_anyone_can_pay__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 1;
+    const uint8_t sighash_type = signature_hash_algorithm::single_anyone_can_pay;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "3e0782f7d4696b2280c6d54d8c097d2e183834aeba07ae92e26c5ed347833a22");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__single_without_output__expected)
+{
+    const auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 17;
+    const uint8_t sighash_type = signature_hash_algorithm::single;
+    const auto sighash = script::generate_signature_hash(tx, input_index, signature_hash_test_script(), sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(sighash), "0100000000000000000000000000000000000000000000000000000000000000");
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__modified_inputs__expected)
+{
+    auto tx = signature_hash_test_tx();
+    const uint32_t input_index = 17;
+    const uint8_t sighash_type = signature_hash_algorithm::all;
+    const auto prevout_script = signature_hash_test_script();
+    const auto original = script::generate_signature_hash(tx, input_index, prevout_script, sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(original), "a4990999cc2fcc801e37754b4fa6e190122273c1ee2868045d2bb53001d01bb2");
+
+    tx.inputs()[0].set_sequence(0);
+    const auto modified = script::generate_signature_hash(tx, input_index, prevout_script, sighash_type);
+    BOOST_REQUIRE_EQUAL(encode_base16(modified), "51cf59287f8e2e7ae7b8dea4d60360e57f692d7b2d967b3063680e7df7804a7b");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1186,4 +1186,92 @@ BOOST_AUTO_TEST_CASE(transaction__hash__block320670__success)
     BOOST_REQUIRE(data == instance.to_data());
 }
 
+BOOST_AUTO_TEST_CASE(transaction__hash__modified__recomputed)
+{
+    const auto data = to_chunk(base16_literal(
+        "0100000001b63634c25f23018c18cbb24ad503672fe7c5edc3fef193ec0f581dd"
+        "b27d4e401490000006a47304402203b361bfb7e189c77379d6ffc90babe1b9658"
+        "39d0b9b60966ade0c4b8de28385f022057432fe6f8f530c54d3513e41da6fb138"
+        "fba2440c877cd2bfb0c94cdb5610fbe0121020d2d76d6db0d1c0bda17950f6468"
+        "6e4bf42481337707e9a81bbe48458cfc8389ffffffff010000000000000000566"
+        "a54e38193e381aee4b896e7958ce381afe4bb96e4babae381abe38288e381a3e3"
+        "81a6e7ac91e9a194e38292e5a5aae3828fe3828ce3828be7bea9e58b99e38292e"
+        "8a8ade38191e381a6e381afe38184e381aae3818400000000"));
+
+    chain::transaction instance;
+    BOOST_REQUIRE(instance.from_data(data));
+    const auto expected = instance.hash();
+
+    instance.set_locktime(42);
+    BOOST_REQUIRE(instance.hash() != expected);
+    BOOST_REQUIRE(instance.hash() == bitcoin_hash(instance.to_data()));
+
+    instance.set_locktime(0);
+    BOOST_REQUIRE(instance.hash() == expected);
+
+    instance.outputs()[0].set_value(42);
+    BOOST_REQUIRE(instance.hash() != expected);
+    BOOST_REQUIRE(instance.hash() == bitcoin_hash(instance.to_data()));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__hash__copy_with_hash__uses_provided_hash)
+{
+    const chain::transaction instance;
+    const chain::transaction copy(instance, null_hash);
+    BOOST_REQUIRE(copy.hash() == null_hash);
+    BOOST_REQUIRE(instance.hash() != null_hash);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__total_output_value__modified__recomputed)
+{
+    chain::transaction instance;
+    instance.outputs().emplace_back(1200, chain::script{});
+    BOOST_REQUIRE_EQUAL(instance.total_output_value(), 1200u);
+
+    instance.outputs().back().set_value(34);
+    BOOST_REQUIRE_EQUAL(instance.total_output_value(), 34u);
+
+    instance.set_outputs({ { 1, chain::script{} }, { 2, chain::script{} } });
+    BOOST_REQUIRE_EQUAL(instance.total_output_value(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__serialized_size__modified__recomputed)
+{
+    chain::transaction instance;
+    const auto empty = instance.serialized_size();
+    BOOST_REQUIRE_EQUAL(empty, instance.to_data().size());
+
+    instance.outputs().emplace_back(1200, chain::script{});
+    BOOST_REQUIRE(instance.serialized_size() != empty);
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), instance.to_data().size());
+}
+
+BOOST_AUTO_TEST_CASE(transaction__total_input_value__populated_after_call__recomputed)
+{
+    chain::transaction instance;
+    instance.inputs().emplace_back();
+    instance.inputs().emplace_back();
+    const auto& inputs = static_cast<const chain::transaction&>(instance).inputs();
+    inputs[0].previous_output().validation.cache.set_value(123u);
+    BOOST_REQUIRE_EQUAL(instance.total_input_value(), 123u);
+
+    // The value was not retained, as the second prevout was missing.
+    inputs[1].previous_output().validation.cache.set_value(321u);
+    BOOST_REQUIRE_EQUAL(instance.total_input_value(), 444u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__signature_operations__modified__recomputed)
+{
+    chain::transaction instance;
+    chain::script multisig;
+    BOOST_REQUIRE(multisig.from_string("checkmultisig"));
+    instance.outputs().emplace_back(0, multisig);
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(false), 20u);
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(true), 20u);
+
+    instance.outputs().emplace_back(0, multisig);
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(false), 40u);
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(true), 40u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
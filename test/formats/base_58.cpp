@@ -101,4 +101,126 @@ BOOST_AUTO_TEST_CASE(base58_array_test)
     BOOST_REQUIRE(converted == expected);
 }
 
+// The byte at a time conversion, for comparison with the limb conversion.
+static std::string reference_encode(const data_chunk& data)
+{
+    static const std::string digits =
+        "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+    size_t zeros = 0;
+    while (zeros < data.size() && data[zeros] == 0)
+        ++zeros;
+
+    data_chunk indexes;
+    for (auto it = data.begin() + zeros; it != data.end(); ++it)
+    {
+        size_t carry = *it;
+        for (auto index = indexes.rbegin(); index != indexes.rend(); ++index)
+        {
+            carry += 256 * (*index);
+            *index = carry % 58;
+            carry /= 58;
+        }
+
+        for (; carry != 0; carry /= 58)
+            indexes.insert(indexes.begin(), carry % 58);
+    }
+
+    std::string encoded(zeros, '1');
+    for (const auto index: indexes)
+        encoded += digits[index];
+
+    return encoded;
+}
+
+BOOST_AUTO_TEST_CASE(base58__encode_base58__all_sizes__matches_reference)
+{
+    uint32_t state = 42;
+    for (size_t size = 0; size < 100; ++size)
+    {
+        for (size_t zeros = 0; zeros < 3 && zeros <= size; ++zeros)
+        {
+            data_chunk data(size);
+            for (size_t index = zeros; index < size; ++index)
+            {
+                state = state * 1103515245 + 12345;
+                data[index] = static_cast<uint8_t>(state >> 16);
+            }
+
+            const auto encoded = encode_base58(data);
+            BOOST_REQUIRE_EQUAL(encoded, reference_encode(data));
+
+            data_chunk decoded;
+            BOOST_REQUIRE(decode_base58(decoded, encoded));
+            BOOST_REQUIRE(decoded == data);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(base58__encode_base58__fixed_sizes__matches_slice)
+{
+    byte_array<25> address;
+    byte_array<38> wif;
+    byte_array<82> key;
+    uint8_t value = 0;
+
+    for (auto& byte: address)
+        byte = value += 7;
+    for (auto& byte: wif)
+        byte = value += 11;
+    for (auto& byte: key)
+        byte = value += 13;
+
+    address[0] = 0x00;
+    BOOST_REQUIRE_EQUAL(encode_base58(address), encode_base58(to_chunk(address)));
+    BOOST_REQUIRE_EQUAL(encode_base58(wif), encode_base58(to_chunk(wif)));
+    BOOST_REQUIRE_EQUAL(encode_base58(key), encode_base58(to_chunk(key)));
+
+    byte_array<38> decoded_wif;
+    byte_array<82> decoded_key;
+    BOOST_REQUIRE(decode_base58(decoded_wif, encode_base58(wif)));
+    BOOST_REQUIRE(decode_base58(decoded_key, encode_base58(key)));
+    BOOST_REQUIRE(decoded_wif == wif);
+    BOOST_REQUIRE(decoded_key == key);
+}
+
+BOOST_AUTO_TEST_CASE(base58__decode_base58__wrong_size__false)
+{
+    byte_array<25> converted;
+    BOOST_REQUIRE(!decode_base58(converted, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFV"));
+    BOOST_REQUIRE(!decode_base58(converted, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViTT"));
+    BOOST_REQUIRE(!decode_base58(converted, "119TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT"));
+    BOOST_REQUIRE(!decode_base58(converted, "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz"));
+}
+
+BOOST_AUTO_TEST_CASE(base58__decode_base58__invalid_character__false)
+{
+    data_chunk decoded;
+    byte_array<25> converted;
+    BOOST_REQUIRE(!decode_base58(decoded, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFVi0"));
+    BOOST_REQUIRE(!decode_base58(converted, "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFVl"));
+}
+
+BOOST_AUTO_TEST_CASE(base58__batch__round_trip__expected)
+{
+    const std::vector<byte_array<25>> addresses
+    {
+        base58_literal("19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT"),
+        base58_literal("1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L")
+    };
+
+    const auto encoded = encode_base58(addresses);
+    BOOST_REQUIRE_EQUAL(encoded.size(), 2u);
+    BOOST_REQUIRE_EQUAL(encoded[0], "19TbMSWwHvnxAKy12iNm3KdbGfzfaMFViT");
+    BOOST_REQUIRE_EQUAL(encoded[1], "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L");
+
+    std::vector<byte_array<25>> decoded;
+    BOOST_REQUIRE(decode_base58(decoded, encoded));
+    BOOST_REQUIRE(decoded == addresses);
+
+    const string_list invalid{ encoded[0], "1111" };
+    BOOST_REQUIRE(!decode_base58(decoded, invalid));
+    BOOST_REQUIRE(decoded == addresses);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
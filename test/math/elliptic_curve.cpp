@@ -129,6 +129,81 @@ BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signature__negative__test)
     BOOST_REQUIRE(!verify_signature(point, sighash, signature));
 }
 
+BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signatures__empty__true)
+{
+    std::vector<bool> results;
+    BOOST_REQUIRE(verify_signatures(results, {}, 4));
+    BOOST_REQUIRE(results.empty());
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signatures__valid__true)
+{
+    ec_signature signature2;
+    const hash_digest sighash2 = hash_literal(SIGHASH2);
+    const ec_compressed point2 = base16_literal(COMPRESSED2);
+    der_signature distinguished;
+    BOOST_REQUIRE(decode_base16(distinguished, SIGNATURE2));
+    BOOST_REQUIRE(parse_signature(signature2, distinguished, false));
+
+    ec_signature signature3;
+    ec_compressed point3;
+    const ec_secret secret3 = base16_literal(SECRET3);
+    const hash_digest sighash3 = hash_literal(SIGHASH3);
+    BOOST_REQUIRE(secret_to_public(point3, secret3));
+    BOOST_REQUIRE(sign(signature3, secret3, sighash3));
+
+    const signature_verification item2{ to_chunk(point2), sighash2, signature2 };
+    const signature_verification item3{ to_chunk(point3), sighash3, signature3 };
+    const signature_verification::list batch{ item2, item3, item2, item3, item2 };
+
+    std::vector<bool> results;
+    BOOST_REQUIRE(verify_signatures(results, batch, 2));
+    BOOST_REQUIRE_EQUAL(results.size(), 5u);
+    BOOST_REQUIRE(results == std::vector<bool>(5, true));
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signatures__invalid_items__false_for_invalid)
+{
+    ec_signature signature;
+    const hash_digest sighash = hash_literal(SIGHASH2);
+    const ec_compressed point = base16_literal(COMPRESSED2);
+    der_signature distinguished;
+    BOOST_REQUIRE(decode_base16(distinguished, SIGNATURE2));
+    BOOST_REQUIRE(parse_signature(signature, distinguished, false));
+
+    auto invalid_signature = signature;
+    invalid_signature[10] = 110;
+    auto invalid_point = to_chunk(point);
+    invalid_point[0] = 0x42;
+
+    const signature_verification::list batch
+    {
+        { to_chunk(point), sighash, signature },
+        { to_chunk(point), sighash, invalid_signature },
+        { invalid_point, sighash, signature },
+        { to_chunk(point), sighash, signature }
+    };
+
+    std::vector<bool> results;
+    BOOST_REQUIRE(!verify_signatures(results, batch, 3));
+    BOOST_REQUIRE(results == std::vector<bool>({ true, false, false, true }));
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__verify_signatures__more_threads_than_items__true)
+{
+    ec_signature signature;
+    const hash_digest sighash = hash_literal(SIGHASH2);
+    const ec_compressed point = base16_literal(COMPRESSED2);
+    der_signature distinguished;
+    BOOST_REQUIRE(decode_base16(distinguished, SIGNATURE2));
+    BOOST_REQUIRE(parse_signature(signature, distinguished, false));
+
+    std::vector<bool> results;
+    const signature_verification::list batch{ { to_chunk(point), sighash, signature } };
+    BOOST_REQUIRE(verify_signatures(results, batch, 8));
+    BOOST_REQUIRE(results == std::vector<bool>{ true });
+}
+
 BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add__positive__test)
 {
     ec_secret secret1{ { 1, 2, 3 } };
@@ -156,6 +231,32 @@ BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add__negative__test)
     BOOST_REQUIRE(!ec_add(public1, secret2));
 }
 
+BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add_batch__threads__matches_ec_add)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(decode_base16(point, COMPRESSED1));
+    const secret_list secrets{ { { 1, 2, 3 } }, { { 3, 2, 1 } }, { { 7 } } };
+
+    point_list out;
+    BOOST_REQUIRE(ec_add(out, point, secrets, 2));
+    BOOST_REQUIRE_EQUAL(out.size(), secrets.size());
+
+    for (size_t index = 0; index < secrets.size(); ++index)
+    {
+        auto expected = point;
+        BOOST_REQUIRE(ec_add(expected, secrets[index]));
+        BOOST_REQUIRE(out[index] == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(elliptic_curve__ec_add_batch__invalid_point__false)
+{
+    point_list out;
+    const secret_list secrets{ { { 1 } } };
+    BOOST_REQUIRE(!ec_add(out, null_compressed_point, secrets));
+    BOOST_REQUIRE(out.front() == null_compressed_point);
+}
+
 BOOST_AUTO_TEST_CASE(elliptic_curve__ec_multiply_test)
 {
     ec_secret secret1{{0}};
@@ -59,6 +59,136 @@ BOOST_AUTO_TEST_CASE(sha256_hash_test)
     BOOST_REQUIRE_EQUAL(encode_base16(hash), "3a6eb0790f39ac87c94f3856b2dd2c5d110e6811602261a9a923d3bb23adc8b7");
 }
 
+BOOST_AUTO_TEST_CASE(sha256_hash__known_vectors__expected)
+{
+    for (const auto& result: sha256_tests)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        BOOST_REQUIRE_EQUAL(encode_base16(sha256_hash(data)), result.result);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha256_hash__million_a__expected)
+{
+    const data_chunk data(1000000, 'a');
+    const auto hash = sha256_hash(data);
+    BOOST_REQUIRE_EQUAL(encode_base16(hash), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_pairs__empty__empty)
+{
+    hash_list out{ null_hash };
+    bitcoin_hash_pairs(out, {});
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_pairs__all_lane_counts__matches_bitcoin_hash)
+{
+    // Covers partial and complete runs of eight, four and single lanes.
+    for (size_t pairs = 1; pairs <= 21; ++pairs)
+    {
+        hash_list hashes;
+        for (size_t index = 0; index < 2 * pairs; ++index)
+            hashes.push_back(sha256_hash(to_chunk(to_little_endian(index))));
+
+        hash_list out;
+        bitcoin_hash_pairs(out, hashes);
+        BOOST_REQUIRE_EQUAL(out.size(), pairs);
+
+        for (size_t pair = 0; pair < pairs; ++pair)
+        {
+            const auto& left = hashes[2 * pair];
+            const auto& right = hashes[2 * pair + 1];
+            const auto expected = bitcoin_hash(build_chunk({ left, right }));
+            BOOST_REQUIRE(out[pair] == expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_headers__all_lane_counts__matches_bitcoin_hash)
+{
+    // Covers partial and complete runs of eight, four and single lanes.
+    for (size_t count = 0; count <= 21; ++count)
+    {
+        data_chunk headers;
+        for (size_t index = 0; index < 80 * count; ++index)
+            headers.push_back(static_cast<uint8_t>(index * 7 + 3));
+
+        hash_list out;
+        bitcoin_hash_headers(out, headers);
+        BOOST_REQUIRE_EQUAL(out.size(), count);
+
+        for (size_t header = 0; header < count; ++header)
+        {
+            const auto begin = headers.begin() + 80 * header;
+            const data_chunk expected(begin, begin + 80);
+            BOOST_REQUIRE(out[header] == bitcoin_hash(expected));
+        }
+    }
+}
+
+// Restores all hash kernels on scope exit, including test failure.
+struct kernels_restorer
+{
+    ~kernels_restorer()
+    {
+        restrict_hash_kernels(all_kernels);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(hash_kernels__each_kernel__matches_portable)
+{
+    const kernels_restorer restorer;
+
+    // Covers partial and complete runs of eight, four and single lanes.
+    hash_list hashes;
+    data_chunk headers;
+    data_stack passphrases;
+    data_stack salts;
+    const data_chunk message(1000, 'a');
+
+    for (size_t index = 0; index < 42; ++index)
+        hashes.push_back(sha256_hash(to_chunk(to_little_endian(index))));
+
+    for (size_t index = 0; index < 80 * 21; ++index)
+        headers.push_back(static_cast<uint8_t>(index * 7 + 3));
+
+    for (size_t index = 0; index < 9; ++index)
+    {
+        passphrases.push_back(data_chunk(index * 30, static_cast<uint8_t>(index)));
+        salts.push_back(data_chunk(index, 0x42));
+    }
+
+    BOOST_REQUIRE_EQUAL(restrict_hash_kernels(portable_kernels), 0u);
+    const auto expected_message = sha256_hash(message);
+    const auto expected_seeds = pkcs5_pbkdf2_hmac_sha512(passphrases, salts, 3);
+    hash_list expected_pairs;
+    bitcoin_hash_pairs(expected_pairs, hashes);
+    hash_list expected_headers;
+    bitcoin_hash_headers(expected_headers, headers);
+
+    const uint32_t masks[] =
+    {
+        sse41_kernels, avx2_kernels, shani_kernels, all_kernels
+    };
+
+    for (const auto mask: masks)
+    {
+        BOOST_REQUIRE_EQUAL(restrict_hash_kernels(mask) & ~mask, 0u);
+        BOOST_REQUIRE(sha256_hash(message) == expected_message);
+        BOOST_REQUIRE(pkcs5_pbkdf2_hmac_sha512(passphrases, salts, 3) == expected_seeds);
+
+        hash_list pairs;
+        bitcoin_hash_pairs(pairs, hashes);
+        BOOST_REQUIRE(pairs == expected_pairs);
+
+        hash_list digests;
+        bitcoin_hash_headers(digests, headers);
+        BOOST_REQUIRE(digests == expected_headers);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(sha512_hash_test)
 {
     const data_chunk chunk{ 'd', 'a', 't', 'a' };
@@ -91,4 +221,123 @@ BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch_all_lane_counts__matches_single)
+{
+    for (size_t count = 0; count <= 9; ++count)
+    {
+        data_stack passphrases;
+        data_stack salts;
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            passphrases.push_back(data_chunk(index * 30, static_cast<uint8_t>(index)));
+            salts.push_back(data_chunk(index, 0x42));
+        }
+
+        for (size_t threads = 1; threads <= 3; ++threads)
+        {
+            const auto hashes = pkcs5_pbkdf2_hmac_sha512(passphrases, salts, 3, threads);
+            BOOST_REQUIRE_EQUAL(hashes.size(), count);
+
+            for (size_t index = 0; index < count; ++index)
+                BOOST_REQUIRE(hashes[index] == pkcs5_pbkdf2_hmac_sha512(passphrases[index], salts[index], 3));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch_vectors__expected)
+{
+    data_stack passphrases;
+    data_stack salts;
+
+    for (const auto& result: pkcs5_pbkdf2_hmac_sha512_tests)
+    {
+        if (result.iterations == 4096)
+        {
+            passphrases.push_back(to_chunk(result.passphrase));
+            salts.push_back(to_chunk(result.salt));
+        }
+    }
+
+    const auto hashes = pkcs5_pbkdf2_hmac_sha512(passphrases, salts, 4096, 2);
+    BOOST_REQUIRE_EQUAL(hashes.size(), 2u);
+    BOOST_REQUIRE_EQUAL(encode_base16(hashes[0]), "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5143f30602641b3d55cd335988cb36b84376060ecd532e039b742a239434af2d5");
+    BOOST_REQUIRE_EQUAL(encode_base16(hashes[1]), "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71115b59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b8");
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512__batch_salts_mismatch__empty)
+{
+    const data_stack passphrases{ data_chunk{ 1 }, data_chunk{ 2 } };
+    const data_stack salts{ data_chunk{ 3 } };
+    BOOST_REQUIRE(pkcs5_pbkdf2_hmac_sha512(passphrases, salts, 1).empty());
+    BOOST_REQUIRE(pkcs5_pbkdf2_hmac_sha512(salts, passphrases, 1, 2).empty());
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__rfc7914_vectors__expected)
+{
+    const auto expected1 = "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906";
+    const auto expected2 = "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640";
+    const auto password = to_chunk(std::string("password"));
+    const auto salt = to_chunk(std::string("NaCl"));
+
+    BOOST_REQUIRE_EQUAL(encode_base16(scrypt(data_chunk{}, data_chunk{}, 16, 1, 1, 64)), expected1);
+    BOOST_REQUIRE_EQUAL(encode_base16(scrypt(password, salt, 1024, 16, 8, 64)), expected2);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__reused_scratch__expected)
+{
+    data_chunk scratch;
+    const auto password = to_chunk(std::string("password"));
+    const auto salt = to_chunk(std::string("NaCl"));
+
+    BOOST_REQUIRE_EQUAL(encode_base16(scrypt(password, salt, 1024, 16, 8, 64, scratch)), "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640");
+    BOOST_REQUIRE_EQUAL(encode_base16(scrypt(data_chunk{}, data_chunk{}, 16, 1, 1, 64, scratch)), "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__threads__matches_single_thread)
+{
+    const auto password = to_chunk(std::string("password"));
+    const auto salt = to_chunk(std::string("NaCl"));
+    const auto expected = scrypt(password, salt, 64, 5, 2, 40);
+
+    for (size_t threads = 0; threads <= 6; ++threads)
+        BOOST_REQUIRE(scrypt(password, salt, 64, 5, 2, 40, threads) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__invalid_n__throws)
+{
+    data_chunk scratch;
+    BOOST_REQUIRE_THROW(scrypt(data_chunk{}, data_chunk{}, 3, 1, 1, 64, scratch), std::runtime_error);
+    BOOST_REQUIRE_THROW(scrypt(data_chunk{}, data_chunk{}, 3, 1, 1, 64, size_t(2)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(murmur3_hash_test)
+{
+    for (const auto& result: murmur3_tests)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        BOOST_REQUIRE_EQUAL(murmur3_hash(data, result.seed), result.result);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(siphash_test)
+{
+    static const uint64_t k0 = 0x0706050403020100;
+    static const uint64_t k1 = 0x0f0e0d0c0b0a0908;
+
+    for (const auto& result: siphash_tests)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+        BOOST_REQUIRE_EQUAL(siphash(k0, k1, data), result.result);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(siphash__hash_digest__matches_data_slice)
+{
+    const auto hash = sha256_hash(to_chunk(std::string("siphash")));
+    BOOST_REQUIRE_EQUAL(siphash(42, 24, hash), siphash(42, 24, data_slice(hash)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_TEST_HASH_HPP
 #define LIBBITCOIN_TEST_HASH_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -35,9 +36,24 @@ struct pkcs5_pbkdf2_hmac_sha512_result
     std::string result;
 };
 
+struct murmur3_result
+{
+    std::string input;
+    uint32_t seed;
+    uint32_t result;
+};
+
+struct siphash_result
+{
+    std::string input;
+    uint64_t result;
+};
+
 typedef std::vector<hash_result> hash_result_list;
 typedef std::vector<pkcs5_pbkdf2_hmac_sha512_result>
     pkcs5_pbkdf2_hmac_sha512_result_list;
+typedef std::vector<murmur3_result> murmur3_result_list;
+typedef std::vector<siphash_result> siphash_result_list;
 
 hash_result_list sha1_tests{{
     {"", "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
@@ -84,7 +100,15 @@ hash_result_list sha256_tests{{
     {"fb89f0f61023de0f133ad0b18deef86337a8861f2dc50cfb76d2f0f4a4ad3e3edda87198c19452f3c8b1dda58d", "044ed06e0272fe15a8f0bb8bf5c817c14880bdd293597d47f1039a4815424f4d"},
     {"279b6543be0a72dda676c5ff99da02f227637b", "f8f7394e8665d30c90870c742363baa529a5053aae1b9438d31c22f5184141a9"},
     {"26d34b5f6d0e23bc1e4fdf11a00d8c", "73b12a2fde6b7d790f7da3eb60f990208f28fabf43380a66cf26b615c7f6f545"},
-    {"a475bc116efb92cde208e19af68dd00e28f62e27836d28cc41ff4571391ee21379069e4632599d75", "cc7ef1dd07f26065caeab1a9dbd820db31448812d3cf5d1a592b8b263e493a47"}
+    {"a475bc116efb92cde208e19af68dd00e28f62e27836d28cc41ff4571391ee21379069e4632599d75", "cc7ef1dd07f26065caeab1a9dbd820db31448812d3cf5d1a592b8b263e493a47"},
+    {"616263", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+    {"6162636462636465636465666465666765666768666768696768696a68696a6b696a6b6c6a6b6c6d6b6c6d6e6c6d6e6f6d6e6f706e6f7071", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+    {"61626364656667686263646566676869636465666768696a6465666768696a6b65666768696a6b6c666768696a6b6c6d6768696a6b6c6d6e68696a6b6c6d6e6f696a6b6c6d6e6f706a6b6c6d6e6f70716b6c6d6e6f7071726c6d6e6f707172736d6e6f70717273746e6f707172737475", "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f30313233343536", "463eb28e72f82e0a96c0a4cc53690c571281131f672aa229e0d45ae59b598b59"},
+    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f3031323334353637", "da2ae4d6b36748f2a318f23e7ab1dfdf45acdc9d049bd80e59de82a60895f562"},
+    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f", "fdeab9acf3710362bd2658cdc9a29e8f9c757fcf9811603a8c447cd1d9151108"},
+    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f606162636465666768696a6b6c6d6e6f70717273747576", "da18797ed7c3a777f0847f429724a2d8cd5138e6ed2895c3fa1a6d39d18f7ec6"},
+    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f", "471fb943aa23c511f6f72f8d1652d9c880cfa392ad80503120547703e56a2be5"}
 }};
 
 hash_result_list sha512_tests{{
@@ -144,4 +168,33 @@ pkcs5_pbkdf2_hmac_sha512_result_list pkcs5_pbkdf2_hmac_sha512_tests{{
 }};
 
 
+// Test vectors from the bitcoin reference client (bip37).
+murmur3_result_list murmur3_tests{{
+    {"", 0x00000000, 0x00000000},
+    {"", 0xfba4c795, 0x6a396f08},
+    {"", 0xffffffff, 0x81f16f39},
+    {"00", 0x00000000, 0x514e28b7},
+    {"00", 0xfba4c795, 0xea3f0b17},
+    {"ff", 0x00000000, 0xfd6cf10d},
+    {"0011", 0x00000000, 0x16c6b7ab},
+    {"001122", 0x00000000, 0x8eb51c3d},
+    {"00112233", 0x00000000, 0xb4471bf8},
+    {"0011223344", 0x00000000, 0xe2301fa8},
+    {"001122334455", 0x00000000, 0xfc2e4a15},
+    {"00112233445566", 0x00000000, 0xb074502c},
+    {"0011223344556677", 0x00000000, 0x8034d2a0},
+    {"001122334455667788", 0x00000000, 0xb4698def}
+}};
+
+// Test vectors from the siphash reference implementation, with the key
+// 000102030405060708090a0b0c0d0e0f and messages of incrementing bytes.
+siphash_result_list siphash_tests{{
+    {"", 0x726fdb47dd0e0e31},
+    {"00", 0x74f839c593dc67fd},
+    {"0001020304050607", 0x93f5f5799a932462},
+    {"000102030405060708090a0b0c0d0e", 0xa129ca6149be45e5},
+    {"000102030405060708090a0b0c0d0e0f", 0x3f2acc7f57c29bdb},
+    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", 0x7127512f72f27cce}
+}};
+
 #endif
@@ -40,4 +40,130 @@ BOOST_AUTO_TEST_CASE(hash_number__simple__test)
     BOOST_REQUIRE(!(our_value > target));
 }
 
+BOOST_AUTO_TEST_CASE(hash_number__set_compact__zero_mantissa__zero_not_negative)
+{
+    for (const uint32_t bits: { 0x00000000u, 0x00123456u, 0x01003456u,
+        0x02000056u, 0x03000000u, 0x04000000u, 0x00923456u, 0x01803456u,
+        0x02800056u, 0x03800000u, 0x04800000u })
+    {
+        hash_number value;
+        BOOST_REQUIRE(value.set_compact(bits));
+        BOOST_REQUIRE(value == 0);
+        BOOST_REQUIRE_EQUAL(value.compact(), 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__set_compact__positive__round_trips)
+{
+    hash_number value;
+    BOOST_REQUIRE(value.set_compact(0x01123456));
+    BOOST_REQUIRE(value == 0x12);
+    BOOST_REQUIRE_EQUAL(value.compact(), 0x01120000u);
+
+    BOOST_REQUIRE(value.set_compact(0x02123456));
+    BOOST_REQUIRE(value == 0x1234);
+    BOOST_REQUIRE_EQUAL(value.compact(), 0x02123400u);
+
+    BOOST_REQUIRE(value.set_compact(0x03123456));
+    BOOST_REQUIRE(value == 0x123456);
+    BOOST_REQUIRE_EQUAL(value.compact(), 0x03123456u);
+
+    BOOST_REQUIRE(value.set_compact(0x04123456));
+    BOOST_REQUIRE(value == 0x12345600);
+    BOOST_REQUIRE_EQUAL(value.compact(), 0x04123456u);
+
+    BOOST_REQUIRE(value.set_compact(0x05009234));
+    BOOST_REQUIRE(value == 0x92340000);
+    BOOST_REQUIRE_EQUAL(value.compact(), 0x05009234u);
+
+    BOOST_REQUIRE(value.set_compact(0x20123456));
+    BOOST_REQUIRE((hash_number(0x123456) << 232).hash() == value.hash());
+    BOOST_REQUIRE_EQUAL(value.compact(), 0x20123456u);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__set_compact__negative_or_overflow__false)
+{
+    hash_number value;
+    BOOST_REQUIRE(!value.set_compact(0x01fedcba));
+    BOOST_REQUIRE(value == 0x7e);
+    BOOST_REQUIRE(!value.set_compact(0x04923456));
+    BOOST_REQUIRE(value == 0x12345600);
+    BOOST_REQUIRE(!value.set_compact(0xff123456));
+    BOOST_REQUIRE(!value.set_compact(0x22000100));
+    BOOST_REQUIRE(value.set_compact(0x22000001));
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__compact_limb__max_work_bits__expected)
+{
+    BOOST_REQUIRE_EQUAL(uint256_t::compact_limb(max_work_bits, 0), 0u);
+    BOOST_REQUIRE_EQUAL(uint256_t::compact_limb(max_work_bits, 1), 0u);
+    BOOST_REQUIRE_EQUAL(uint256_t::compact_limb(max_work_bits, 2), 0u);
+    BOOST_REQUIRE_EQUAL(uint256_t::compact_limb(max_work_bits, 3), 0xffff0000u);
+    BOOST_REQUIRE(!uint256_t::is_negative_compact(max_work_bits));
+    BOOST_REQUIRE(!uint256_t::is_overflow_compact(max_work_bits));
+
+    // The mantissa straddles limbs 0 and 1.
+    BOOST_REQUIRE_EQUAL(uint256_t::compact_limb(0x0a123456, 0), 0x5600000000000000u);
+    BOOST_REQUIRE_EQUAL(uint256_t::compact_limb(0x0a123456, 1), 0x1234u);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__is_met_by__target__expected)
+{
+    hash_number target;
+    BOOST_REQUIRE(target.set_compact(max_work_bits));
+    BOOST_REQUIRE(target.is_met_by(target.hash()));
+    BOOST_REQUIRE(target.is_met_by(null_hash));
+    BOOST_REQUIRE(!target.is_met_by((target + 1).hash()));
+    BOOST_REQUIRE(!target.is_met_by(hash_literal("0000000100000000000000000000000000000000000000000000000000000000")));
+    BOOST_REQUIRE(target.is_met_by(hash_literal("00000000b873e79784647a6c82962c70d228557d24a747ea4d1b8bbe878e1206")));
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__multiply__limb_carries__expected)
+{
+    const uint256_t value(max_uint64);
+    const auto product = value * value;
+    const auto expected = (uint256_t(1) << 128) - (uint256_t(1) << 65) + 1;
+    BOOST_REQUIRE(product == expected);
+
+    hash_number number(max_uint64);
+    number *= max_uint32;
+    BOOST_REQUIRE(number.hash() == hash_literal("0000000000000000000000000000000000000000fffffffeffffffff00000001"));
+    BOOST_REQUIRE((number / max_uint32) == max_uint64);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__divide__single_limb__quotient_and_remainder)
+{
+    const auto value = hash_number(1) << 200;
+    auto quotient = value;
+    quotient /= 3;
+
+    // 2^200 = 1 (mod 3).
+    auto product = quotient;
+    product *= 3;
+    BOOST_REQUIRE((product + 1).hash() == value.hash());
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__difficulty__max_work_bits__expected)
+{
+    BOOST_REQUIRE(chain::block::difficulty(max_work_bits) == 0x100010001);
+}
+
+BOOST_AUTO_TEST_CASE(hash_number__difficulty__headers__cumulative)
+{
+    chain::header minimum;
+    minimum.set_bits(max_work_bits);
+    chain::header harder;
+    harder.set_bits(0x1c00ffff);
+
+    auto expected = chain::block::difficulty(max_work_bits);
+    expected *= 3;
+    auto harder_work = chain::block::difficulty(0x1c00ffff);
+    harder_work *= 2;
+    expected += harder_work;
+
+    const chain::header::list headers{ minimum, minimum, harder, harder, minimum };
+    BOOST_REQUIRE(chain::block::difficulty(headers).hash() == expected.hash());
+    BOOST_REQUIRE(chain::block::difficulty(chain::header::list{}) == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
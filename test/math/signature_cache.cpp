@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(signature_cache_tests)
+
+#define COMPRESSED "03bc88a1bd6ebac38e9a9ed58eda735352ad10650e235499b7318315cc26c9b55b"
+#define SIGHASH "ed8f9b40c2d349c8a7e58cebe79faa25c21b6bb85b874901f72a1b3f1ad0a67f"
+#define OTHER_SIGHASH "f89572635651b2e4f89778350616989183c98d1a721c911324bf9f17a0cf5bf0"
+
+static ec_signature make_signature(uint8_t fill)
+{
+    ec_signature signature;
+    signature.fill(fill);
+    return signature;
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__contains__empty__false_and_miss)
+{
+    const signature_cache cache;
+    BOOST_REQUIRE(!cache.contains(base16_literal(COMPRESSED), hash_literal(SIGHASH), make_signature(1)));
+    BOOST_REQUIRE_EQUAL(cache.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.capacity(), signature_cache::default_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__contains__stored__true_and_hit)
+{
+    signature_cache cache;
+    const auto point = to_chunk(base16_literal(COMPRESSED));
+    cache.store(point, hash_literal(SIGHASH), make_signature(1));
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+    BOOST_REQUIRE(cache.contains(point, hash_literal(SIGHASH), make_signature(1)));
+    BOOST_REQUIRE(!cache.contains(point, hash_literal(OTHER_SIGHASH), make_signature(1)));
+    BOOST_REQUIRE(!cache.contains(point, hash_literal(SIGHASH), make_signature(2)));
+    BOOST_REQUIRE_EQUAL(cache.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__duplicate__single_entry)
+{
+    signature_cache cache(2);
+    const auto point = to_chunk(base16_literal(COMPRESSED));
+    cache.store(point, hash_literal(SIGHASH), make_signature(1));
+    cache.store(point, hash_literal(SIGHASH), make_signature(1));
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__full__evicts_oldest)
+{
+    signature_cache cache(2);
+    const auto point = to_chunk(base16_literal(COMPRESSED));
+    cache.store(point, hash_literal(SIGHASH), make_signature(1));
+    cache.store(point, hash_literal(SIGHASH), make_signature(2));
+    cache.store(point, hash_literal(SIGHASH), make_signature(3));
+    BOOST_REQUIRE_EQUAL(cache.size(), 2u);
+    BOOST_REQUIRE(!cache.contains(point, hash_literal(SIGHASH), make_signature(1)));
+    BOOST_REQUIRE(cache.contains(point, hash_literal(SIGHASH), make_signature(2)));
+    BOOST_REQUIRE(cache.contains(point, hash_literal(SIGHASH), make_signature(3)));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__zero_capacity__not_stored)
+{
+    signature_cache cache(0);
+    const auto point = to_chunk(base16_literal(COMPRESSED));
+    cache.store(point, hash_literal(SIGHASH), make_signature(1));
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    BOOST_REQUIRE(!cache.contains(point, hash_literal(SIGHASH), make_signature(1)));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__clear__stored__empty_and_counters_reset)
+{
+    signature_cache cache;
+    const auto point = to_chunk(base16_literal(COMPRESSED));
+    cache.store(point, hash_literal(SIGHASH), make_signature(1));
+    BOOST_REQUIRE(cache.contains(point, hash_literal(SIGHASH), make_signature(1)));
+    cache.clear();
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    BOOST_REQUIRE_EQUAL(cache.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(cache.misses(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(bloom_filter_tests)
+
+#define ELEMENT1 "99108ad8ed9bb6274d3980bab5a85c048f0950c8"
+#define ELEMENT2 "b5a2c786d9ef4658287ced5914b37a1b4aa32eee"
+#define ELEMENT3 "b9300670b4c5366e95b2699e8b18bc75e5f729c5"
+#define OTHER_ELEMENT "19108ad8ed9bb6274d3980bab5a85c048f0950c8"
+
+static chain::transaction make_pay_transaction(const std::string& push)
+{
+    chain::script script;
+    BOOST_REQUIRE(script.from_string("dup hash160 [ " + push + " ] equalverify checksig"));
+    chain::transaction tx;
+    tx.outputs().emplace_back(1000, script);
+    return tx;
+}
+
+static chain::transaction make_spend_transaction(const hash_digest& hash,
+    uint32_t index)
+{
+    chain::transaction tx;
+    tx.inputs().emplace_back(chain::output_point{ hash, index },
+        chain::script{}, 0xffffffff);
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor_1__always__matches_all)
+{
+    message::bloom_filter instance;
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.contains(base16_literal(OTHER_ELEMENT)));
+    BOOST_REQUIRE(instance.match(chain::transaction{}));
+}
+
+// Reference client vectors (bloom_create_insert_serialize).
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__reference_vector__expected_filter)
+{
+    message::bloom_filter instance(3, 0.01, 0, message::bloom_filter::update_all);
+    instance.insert(base16_literal(ELEMENT1));
+    BOOST_REQUIRE(instance.contains(base16_literal(ELEMENT1)));
+    BOOST_REQUIRE(!instance.contains(base16_literal(OTHER_ELEMENT)));
+
+    instance.insert(base16_literal(ELEMENT2));
+    BOOST_REQUIRE(instance.contains(base16_literal(ELEMENT2)));
+    instance.insert(base16_literal(ELEMENT3));
+    BOOST_REQUIRE(instance.contains(base16_literal(ELEMENT3)));
+
+    const auto load = instance.to_filter_load();
+    const auto data = load.to_data(message::version::level::maximum);
+    BOOST_REQUIRE_EQUAL(encode_base16(data), "03614e9b050000000000000001");
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__reference_vector_with_tweak__expected_filter)
+{
+    message::bloom_filter instance(3, 0.01, 2147483649u, message::bloom_filter::update_all);
+    instance.insert(base16_literal(ELEMENT1));
+    BOOST_REQUIRE(instance.contains(base16_literal(ELEMENT1)));
+    BOOST_REQUIRE(!instance.contains(base16_literal(OTHER_ELEMENT)));
+    instance.insert(base16_literal(ELEMENT2));
+    instance.insert(base16_literal(ELEMENT3));
+
+    const auto load = instance.to_filter_load();
+    const auto data = load.to_data(message::version::level::maximum);
+    BOOST_REQUIRE_EQUAL(encode_base16(data), "03ce4299050000000100008001");
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__load__roundtrip__equal_filter)
+{
+    message::bloom_filter expected(10, 0.001, 42, message::bloom_filter::update_none);
+    expected.insert(base16_literal(ELEMENT1));
+
+    const message::bloom_filter instance(expected.to_filter_load());
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.filter() == expected.filter());
+    BOOST_REQUIRE_EQUAL(instance.hash_functions(), expected.hash_functions());
+    BOOST_REQUIRE_EQUAL(instance.tweak(), 42u);
+    BOOST_REQUIRE(instance.contains(base16_literal(ELEMENT1)));
+    BOOST_REQUIRE(!instance.contains(base16_literal(OTHER_ELEMENT)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__load__oversized__invalid)
+{
+    const data_chunk filter(message::bloom_filter::max_filter_size + 1, 0x00);
+    const message::bloom_filter instance({ filter, 1, 0, 0 });
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__add__oversized__false)
+{
+    message::bloom_filter instance(10, 0.001, 0, 0);
+    const data_chunk data(message::bloom_filter::max_element_size + 1, 0x42);
+    BOOST_REQUIRE(!instance.add({ data }));
+    BOOST_REQUIRE(!instance.contains(data));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__add__element__contains)
+{
+    message::bloom_filter instance(10, 0.001, 0, 0);
+    BOOST_REQUIRE(instance.add({ to_chunk(base16_literal(ELEMENT1)) }));
+    BOOST_REQUIRE(instance.contains(base16_literal(ELEMENT1)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__clear__loaded__matches_all)
+{
+    message::bloom_filter instance(10, 0.001, 0, 0);
+    BOOST_REQUIRE(!instance.match(make_pay_transaction(ELEMENT1)));
+    instance.clear();
+    BOOST_REQUIRE(instance.match(make_pay_transaction(ELEMENT1)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__transaction_hash__true)
+{
+    const auto tx = make_pay_transaction(ELEMENT1);
+    message::bloom_filter instance(10, 0.001, 0, 0);
+    instance.insert(tx.hash());
+    BOOST_REQUIRE(instance.match(tx));
+    BOOST_REQUIRE(!instance.match(make_pay_transaction(ELEMENT2)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__update_all__matches_spend)
+{
+    const auto tx = make_pay_transaction(ELEMENT1);
+    message::bloom_filter instance(10, 0.001, 0, message::bloom_filter::update_all);
+    instance.insert(base16_literal(ELEMENT1));
+    BOOST_REQUIRE(instance.match(tx));
+    BOOST_REQUIRE(instance.contains(chain::point{ tx.hash(), 0 }));
+    BOOST_REQUIRE(instance.match(make_spend_transaction(tx.hash(), 0)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__update_none__does_not_match_spend)
+{
+    const auto tx = make_pay_transaction(ELEMENT1);
+    message::bloom_filter instance(10, 0.001, 0, message::bloom_filter::update_none);
+    instance.insert(base16_literal(ELEMENT1));
+    BOOST_REQUIRE(instance.match(tx));
+    BOOST_REQUIRE(!instance.match(make_spend_transaction(tx.hash(), 0)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__match__update_pay_public_key_only_key_hash__does_not_match_spend)
+{
+    const auto tx = make_pay_transaction(ELEMENT1);
+    message::bloom_filter instance(10, 0.001, 0, message::bloom_filter::update_pay_public_key_only);
+    instance.insert(base16_literal(ELEMENT1));
+    BOOST_REQUIRE(instance.match(tx));
+    BOOST_REQUIRE(!instance.match(make_spend_transaction(tx.hash(), 0)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
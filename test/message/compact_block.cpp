@@ -709,5 +709,48 @@ BOOST_AUTO_TEST_CASE(compact_block__operator_boolean_not_equals__differs__return
     BOOST_REQUIRE_EQUAL(true, instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(compact_block__constructor_block__prefills_coinbase_only)
+{
+    chain::block block;
+
+    for (uint32_t index = 0; index < 3; ++index)
+        block.transactions().push_back(chain::transaction(1, index, {}, {}));
+
+    const auto& txs = block.transactions();
+    const message::compact_block instance(block, 42u);
+    BOOST_REQUIRE(instance.header() == block.header());
+    BOOST_REQUIRE_EQUAL(instance.nonce(), 42u);
+    BOOST_REQUIRE_EQUAL(instance.transactions().size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.transactions()[0].index(), 0u);
+    BOOST_REQUIRE(instance.transactions()[0].transaction() == txs[0]);
+
+    const auto key = instance.to_short_id_key();
+    BOOST_REQUIRE_EQUAL(instance.short_ids().size(), 2u);
+    BOOST_REQUIRE(instance.short_ids()[0] == message::compact_block::to_short_id(key, txs[1].hash()));
+    BOOST_REQUIRE(instance.short_ids()[1] == message::compact_block::to_short_id(key, txs[2].hash()));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__to_short_id_key__sha256_of_header_and_nonce)
+{
+    const chain::header header(10u, null_hash, null_hash, 531234u, 6523454u, 68644u);
+    const message::compact_block instance(header, 0x0102030405060708, {}, {});
+    const auto key = instance.to_short_id_key();
+
+    auto data = header.to_data(false);
+    extend_data(data, base16_literal("0807060504030201"));
+    const auto hash = sha256_hash(data);
+    BOOST_REQUIRE_EQUAL(key.k0, from_little_endian_unsafe<uint64_t>(hash.begin()));
+    BOOST_REQUIRE_EQUAL(key.k1, from_little_endian_unsafe<uint64_t>(hash.begin() + 8));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__to_short_id__low_six_bytes_of_siphash)
+{
+    const message::compact_block::short_id_key key{ 0x0706050403020100, 0x0f0e0d0c0b0a0908 };
+    const auto hash = sha256_hash(data_chunk{ 42 });
+    const auto sip = to_little_endian(siphash(key.k0, key.k1, hash));
+    const auto id = message::compact_block::to_short_id(key, hash);
+    BOOST_REQUIRE(std::equal(id.begin(), id.end(), sip.begin()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(filtered_block_tests)
+
+#define PUSH "99108ad8ed9bb6274d3980bab5a85c048f0950c8"
+
+// Each transaction is distinct by its locktime.
+static chain::block make_block(size_t count)
+{
+    chain::block block;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        chain::transaction tx;
+        tx.set_locktime(static_cast<uint32_t>(index));
+        tx.outputs().emplace_back(index, chain::script{});
+        block.transactions().push_back(std::move(tx));
+    }
+
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
+static hash_digest hash_pair(const hash_digest& left, const hash_digest& right)
+{
+    return bitcoin_hash(build_chunk({ left, right }));
+}
+
+BOOST_AUTO_TEST_CASE(filtered_block__match__empty_block__no_hashes)
+{
+    const chain::block block;
+    const message::filtered_block instance(block);
+    message::bloom_filter filter;
+    message::filtered_block::indexes matches;
+    const auto result = instance.match(filter, matches);
+    BOOST_REQUIRE(matches.empty());
+    BOOST_REQUIRE(result.hashes().empty());
+    BOOST_REQUIRE(result.flags().empty());
+    BOOST_REQUIRE_EQUAL(result.header().transaction_count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(filtered_block__match__cleared_filter__all_transactions)
+{
+    const auto block = make_block(3);
+    const message::filtered_block instance(block);
+    message::bloom_filter filter;
+    message::filtered_block::indexes matches;
+    const auto result = instance.match(filter, matches);
+
+    const auto& txs = block.transactions();
+    BOOST_REQUIRE_EQUAL(matches.size(), 3u);
+    BOOST_REQUIRE_EQUAL(result.header().transaction_count(), 3u);
+    BOOST_REQUIRE(result.header().merkle() == block.header().merkle());
+    BOOST_REQUIRE_EQUAL(result.hashes().size(), 3u);
+    BOOST_REQUIRE(result.hashes()[0] == txs[0].hash());
+    BOOST_REQUIRE(result.hashes()[1] == txs[1].hash());
+    BOOST_REQUIRE(result.hashes()[2] == txs[2].hash());
+
+    // Bits are root, left, leaf 0, leaf 1, right, leaf 2.
+    BOOST_REQUIRE_EQUAL(result.flags().size(), 1u);
+    BOOST_REQUIRE_EQUAL(result.flags()[0], 0x3f);
+}
+
+BOOST_AUTO_TEST_CASE(filtered_block__match__last_of_three__partial_tree)
+{
+    const auto block = make_block(3);
+    const auto& txs = block.transactions();
+    const message::filtered_block instance(block);
+    message::bloom_filter filter(10, 0.000001, 0, 0);
+    filter.insert(txs[2].hash());
+    message::filtered_block::indexes matches;
+    const auto result = instance.match(filter, matches);
+
+    BOOST_REQUIRE_EQUAL(matches.size(), 1u);
+    BOOST_REQUIRE_EQUAL(matches[0], 2u);
+
+    // Bits are root, left (pruned), right, leaf 2.
+    BOOST_REQUIRE_EQUAL(result.flags().size(), 1u);
+    BOOST_REQUIRE_EQUAL(result.flags()[0], 0x0d);
+    BOOST_REQUIRE_EQUAL(result.hashes().size(), 2u);
+
+    const auto left = hash_pair(txs[0].hash(), txs[1].hash());
+    BOOST_REQUIRE(result.hashes()[0] == left);
+    BOOST_REQUIRE(result.hashes()[1] == txs[2].hash());
+
+    const auto right = hash_pair(txs[2].hash(), txs[2].hash());
+    BOOST_REQUIRE(hash_pair(left, right) == block.header().merkle());
+}
+
+BOOST_AUTO_TEST_CASE(filtered_block__match__update_all__matches_spend_in_block)
+{
+    chain::script script;
+    BOOST_REQUIRE(script.from_string("dup hash160 [ " PUSH " ] equalverify checksig"));
+    chain::transaction pay;
+    pay.outputs().emplace_back(1000, script);
+    chain::transaction spend;
+    spend.inputs().emplace_back(chain::output_point{ pay.hash(), 0 }, chain::script{}, 0xffffffff);
+    const chain::block block{ chain::header{}, chain::transaction::list{ chain::transaction{}, pay, spend } };
+
+    const message::filtered_block instance(block);
+    message::filtered_block::indexes matches;
+
+    message::bloom_filter update_none(10, 0.000001, 0, message::bloom_filter::update_none);
+    update_none.insert(base16_literal(PUSH));
+    instance.match(update_none, matches);
+    BOOST_REQUIRE_EQUAL(matches.size(), 1u);
+    BOOST_REQUIRE_EQUAL(matches[0], 1u);
+
+    message::bloom_filter update_all(10, 0.000001, 0, message::bloom_filter::update_all);
+    update_all.insert(base16_literal(PUSH));
+    instance.match(update_all, matches);
+    BOOST_REQUIRE_EQUAL(matches.size(), 2u);
+    BOOST_REQUIRE_EQUAL(matches[0], 1u);
+    BOOST_REQUIRE_EQUAL(matches[1], 2u);
+}
+
+BOOST_AUTO_TEST_CASE(filtered_block__match__many_filters_threaded__same_as_serial)
+{
+    const auto block = make_block(7);
+    const auto& txs = block.transactions();
+    const message::filtered_block instance(block);
+    message::bloom_filter::ptr_list filters;
+
+    for (size_t index = 0; index < txs.size(); ++index)
+    {
+        const auto filter = std::make_shared<message::bloom_filter>(10, 0.000001, 0, 0);
+        filter->insert(txs[index].hash());
+        filters.push_back(filter);
+    }
+
+    message::merkle_block::list out;
+    std::vector<message::filtered_block::indexes> matches;
+    instance.match(out, matches, filters, 3);
+    BOOST_REQUIRE_EQUAL(out.size(), txs.size());
+    BOOST_REQUIRE_EQUAL(matches.size(), txs.size());
+
+    for (size_t index = 0; index < txs.size(); ++index)
+    {
+        message::filtered_block::indexes expected_matches;
+        const auto expected = instance.match(*filters[index], expected_matches);
+        BOOST_REQUIRE(out[index] == expected);
+        BOOST_REQUIRE_EQUAL(matches[index].size(), 1u);
+        BOOST_REQUIRE_EQUAL(matches[index][0], index);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
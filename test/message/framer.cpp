@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2011-2013 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(framer_tests)
+
+static const uint32_t magic = 0xd9b4bef9;
+static const uint32_t version = 70014;
+
+struct collector
+{
+    bool operator()(const heading& head, const data_slice payload)
+    {
+        commands.push_back(head.command());
+        payloads.push_back(to_chunk(payload));
+        return accept;
+    }
+
+    bool accept = true;
+    std::vector<std::string> commands;
+    std::vector<data_chunk> payloads;
+};
+
+static data_chunk two_messages()
+{
+    auto stream = serialize(version, ping(42), magic);
+    extend_data(stream, serialize(version, verack(), magic));
+    extend_data(stream, serialize(version, pong(7), magic));
+    return stream;
+}
+
+BOOST_AUTO_TEST_CASE(framer__write__single_chunk__dispatches_all)
+{
+    collector sink;
+    framer instance(magic, version, std::ref(sink));
+    BOOST_REQUIRE_EQUAL(instance.write(two_messages()), error::success);
+    BOOST_REQUIRE_EQUAL(sink.commands.size(), 3u);
+    BOOST_REQUIRE_EQUAL(sink.commands[0], ping::command);
+    BOOST_REQUIRE_EQUAL(sink.commands[1], verack::command);
+    BOOST_REQUIRE_EQUAL(sink.commands[2], pong::command);
+    BOOST_REQUIRE(sink.payloads[1].empty());
+    BOOST_REQUIRE_EQUAL(instance.pending(), heading::maximum_size());
+}
+
+BOOST_AUTO_TEST_CASE(framer__write__byte_chunks__dispatches_all)
+{
+    collector sink;
+    framer instance(magic, version, std::ref(sink));
+    const auto stream = two_messages();
+
+    for (const auto byte: stream)
+    {
+        const data_chunk chunk{ byte };
+        BOOST_REQUIRE_EQUAL(instance.write(chunk), error::success);
+    }
+
+    BOOST_REQUIRE_EQUAL(sink.commands.size(), 3u);
+    BOOST_REQUIRE_EQUAL(sink.commands[2], pong::command);
+
+    pong result;
+    BOOST_REQUIRE(deserialize(result, version, sink.payloads[2]));
+    BOOST_REQUIRE_EQUAL(result.nonce(), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(framer__write__split_payload__pending_counts_down)
+{
+    collector sink;
+    framer instance(magic, version, std::ref(sink));
+    const auto stream = serialize(version, ping(42), magic);
+    const auto split = heading::maximum_size() + 3;
+    const data_chunk first(stream.begin(), stream.begin() + split);
+    const data_chunk second(stream.begin() + split, stream.end());
+    BOOST_REQUIRE_EQUAL(instance.write(first), error::success);
+    BOOST_REQUIRE_EQUAL(instance.pending(), stream.size() - split);
+    BOOST_REQUIRE(sink.commands.empty());
+    BOOST_REQUIRE_EQUAL(instance.write(second), error::success);
+    BOOST_REQUIRE_EQUAL(sink.commands.size(), 1u);
+
+    ping result;
+    BOOST_REQUIRE(deserialize(result, version, sink.payloads[0]));
+    BOOST_REQUIRE_EQUAL(result.nonce(), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(framer__write__bad_magic__bad_stream_until_reset)
+{
+    collector sink;
+    framer instance(magic + 1, version, std::ref(sink));
+    BOOST_REQUIRE_EQUAL(instance.write(two_messages()), error::bad_stream);
+    BOOST_REQUIRE(sink.commands.empty());
+    BOOST_REQUIRE_EQUAL(instance.write(data_chunk{ 0 }), error::bad_stream);
+    instance.reset();
+    BOOST_REQUIRE_EQUAL(instance.write(data_chunk{ 0 }), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(framer__write__excess_payload_size__bad_stream)
+{
+    collector sink;
+    framer instance(magic, version, std::ref(sink));
+    const auto limit = heading::maximum_payload_size(version);
+    const heading head(magic, ping::command,
+        static_cast<uint32_t>(limit + 1), 0);
+
+    BOOST_REQUIRE_EQUAL(instance.write(head.to_data()), error::bad_stream);
+    BOOST_REQUIRE(sink.commands.empty());
+}
+
+BOOST_AUTO_TEST_CASE(framer__write__bad_checksum__bad_stream)
+{
+    collector sink;
+    framer instance(magic, version, std::ref(sink));
+    auto stream = serialize(version, ping(42), magic);
+    stream.back() ^= 0x01;
+    const auto split = stream.size() - 1;
+    const data_chunk first(stream.begin(), stream.begin() + split);
+    const data_chunk second(stream.begin() + split, stream.end());
+    BOOST_REQUIRE_EQUAL(instance.write(first), error::success);
+    BOOST_REQUIRE_EQUAL(instance.write(second), error::bad_stream);
+    BOOST_REQUIRE(sink.commands.empty());
+}
+
+BOOST_AUTO_TEST_CASE(framer__write__handler_rejects__bad_stream)
+{
+    collector sink;
+    sink.accept = false;
+    framer instance(magic, version, std::ref(sink));
+    BOOST_REQUIRE_EQUAL(instance.write(two_messages()), error::bad_stream);
+    BOOST_REQUIRE_EQUAL(sink.commands.size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
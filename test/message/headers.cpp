@@ -634,4 +634,53 @@ BOOST_AUTO_TEST_CASE(headers__to_inventory__non_empty__returns_header_hash_inven
     BOOST_REQUIRE(expected == result);
 }
 
+#define HEADER0 "0100000000000000000000000000000000000000000000000000000000000000000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4a29ab5f49ffff001d1dac2b7c"
+#define HEADER1 "010000006fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d6190000000000982051fd1e4ba744bbbe680e1fee14677ba1a3c3540bf7b1cdb606e857233e0e61bc6649ffff001d01e36299"
+#define HEADER2 "010000004860eb18bf1b1620e37e9490fc8a427514416fd75159ab86688e9a8300000000d5fdcc541e25de1c7a5addedf24858b8bb665c9f36ef744ee42c316022c90f9bb0bc6649ffff001d08d2bd61"
+
+static chain::header::list mainnet_headers()
+{
+    chain::header::list out(3);
+    BOOST_REQUIRE(out[0].from_data(to_chunk(base16_literal(HEADER0)), false));
+    BOOST_REQUIRE(out[1].from_data(to_chunk(base16_literal(HEADER1)), false));
+    BOOST_REQUIRE(out[2].from_data(to_chunk(base16_literal(HEADER2)), false));
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__empty__success)
+{
+    const message::headers instance;
+    size_t index = 42;
+    BOOST_REQUIRE_EQUAL(instance.check(index), error::success);
+    BOOST_REQUIRE_EQUAL(index, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__mainnet_chain__success)
+{
+    const message::headers instance(mainnet_headers());
+    size_t index = 42;
+    BOOST_REQUIRE_EQUAL(instance.check(index, 2), error::success);
+    BOOST_REQUIRE_EQUAL(index, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__unlinked__orphan_at_first_unlinked)
+{
+    auto elements = mainnet_headers();
+    std::swap(elements[1], elements[2]);
+    const message::headers instance(std::move(elements));
+    size_t index = 42;
+    BOOST_REQUIRE_EQUAL(instance.check(index, 3), error::orphan);
+    BOOST_REQUIRE_EQUAL(index, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__check__insufficient_work__invalid_proof_of_work_at_index)
+{
+    auto elements = mainnet_headers();
+    elements[2].set_nonce(0);
+    const message::headers instance(std::move(elements));
+    size_t index = 42;
+    BOOST_REQUIRE_EQUAL(instance.check(index), error::invalid_proof_of_work);
+    BOOST_REQUIRE_EQUAL(index, 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -596,4 +596,59 @@ BOOST_AUTO_TEST_CASE(merkle_block__operator_boolean_not_equals__differs__returns
     BOOST_REQUIRE_EQUAL(true, instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_6__always__partial_tree_of_matches)
+{
+    const hash_list leaves
+    {
+        hash_literal("8c14f0db3df150123e6f3dbbf30f8b955a8249b62ac1d1ff16284aefa3d06d87"),
+        hash_literal("fff2525b8931402dd09222c50775608f75787bd2b87e56995a7bdd30f79702c4"),
+        hash_literal("6359f0868171b1d194cbee1af2f16ea598ae8fad666d9b012c8ed2b79a236ec4"),
+        hash_literal("e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d")
+    };
+
+    const chain::merkle_tree tree(leaves);
+    chain::header header;
+    header.set_merkle(tree.root());
+
+    const message::merkle_block instance(header, tree, { 1, 3 });
+    BOOST_REQUIRE_EQUAL(instance.header().transaction_count(), 4u);
+
+    hash_list matches;
+    chain::merkle_tree::indexes positions;
+    BOOST_REQUIRE(instance.extract(matches, positions));
+    BOOST_REQUIRE_EQUAL(positions.size(), 2u);
+    BOOST_REQUIRE_EQUAL(positions[0], 1u);
+    BOOST_REQUIRE_EQUAL(positions[1], 3u);
+    BOOST_REQUIRE(matches[0] == leaves[1]);
+    BOOST_REQUIRE(matches[1] == leaves[3]);
+
+    // The round trip through the wire encoding preserves the tree.
+    const auto copy = message::merkle_block::factory_from_data(
+        message::version::level::maximum,
+        instance.to_data(message::version::level::maximum));
+    BOOST_REQUIRE(copy == instance);
+    BOOST_REQUIRE(copy.extract(matches, positions));
+    BOOST_REQUIRE_EQUAL(positions.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__header_merkle_mismatch__false)
+{
+    const chain::merkle_tree tree(hash_list{ null_hash, hash_literal("e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d") });
+    const message::merkle_block instance(chain::header{}, tree, { 0 });
+
+    hash_list matches;
+    chain::merkle_tree::indexes positions;
+    BOOST_REQUIRE(!instance.extract(matches, positions));
+    BOOST_REQUIRE(matches.empty());
+    BOOST_REQUIRE(positions.empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract__default__false)
+{
+    const message::merkle_block instance;
+    hash_list matches;
+    chain::merkle_tree::indexes positions;
+    BOOST_REQUIRE(!instance.extract(matches, positions));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(partial_block_tests)
+
+// Each transaction is distinct by its locktime.
+static chain::block make_block(size_t count)
+{
+    chain::block block;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        chain::transaction tx;
+        tx.set_locktime(static_cast<uint32_t>(index));
+        tx.outputs().emplace_back(index, chain::script{});
+        block.transactions().push_back(std::move(tx));
+    }
+
+    block.header().set_merkle(block.generate_merkle_root());
+    block.header().set_transaction_count(count);
+    return block;
+}
+
+static message::transaction_message::const_ptr_list make_pool(
+    const chain::block& block, const chain::block::indexes& positions)
+{
+    message::transaction_message::const_ptr_list pool;
+
+    for (const auto position: positions)
+        pool.push_back(std::make_shared<const message::transaction_message>(
+            block.transactions()[position]));
+
+    return pool;
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__constructor__default_compact_block__invalid)
+{
+    const message::partial_block instance(message::compact_block{});
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(!instance.is_complete());
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__constructor__coinbase_only__complete)
+{
+    const auto block = make_block(1);
+    const message::partial_block instance(message::compact_block(block, 1));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.is_complete());
+
+    chain::block out;
+    BOOST_REQUIRE(instance.to_block(out));
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__constructor__duplicate_short_ids__invalid)
+{
+    const auto block = make_block(3);
+    message::compact_block compact(block, 1);
+    compact.short_ids()[1] = compact.short_ids()[0];
+    const message::partial_block instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__constructor__prefilled_index_overflow__invalid)
+{
+    const auto block = make_block(3);
+    message::compact_block compact(block, 1);
+    compact.transactions()[0].set_index(3);
+    const message::partial_block instance(compact);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__constructor__differential_prefill__resolved)
+{
+    const auto block = make_block(5);
+    const auto& txs = block.transactions();
+    const auto key = message::compact_block(block, 7).to_short_id_key();
+
+    // Positions 0, 2 and 3 are prefilled, encoded as 0, 1, 0.
+    const message::compact_block compact(block.header(), 7,
+        {
+            message::compact_block::to_short_id(key, txs[1].hash()),
+            message::compact_block::to_short_id(key, txs[4].hash())
+        },
+        {
+            message::prefilled_transaction(0, txs[0]),
+            message::prefilled_transaction(1, txs[2]),
+            message::prefilled_transaction(0, txs[3])
+        });
+
+    message::partial_block instance(compact);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.missing(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.fill(make_pool(block, { 4, 1 })), 2u);
+    BOOST_REQUIRE(instance.is_complete());
+
+    chain::block out;
+    BOOST_REQUIRE(instance.to_block(out));
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__fill__full_pool__reconstructs_block)
+{
+    const auto block = make_block(6);
+    message::partial_block instance(message::compact_block(block, 42));
+    BOOST_REQUIRE_EQUAL(instance.missing(), 5u);
+
+    // The pool order and unrelated transactions are irrelevant.
+    auto pool = make_pool(block, { 5, 3, 1, 2, 4 });
+    pool.push_back(std::make_shared<const message::transaction_message>(
+        chain::transaction(1, 99, {}, {})));
+
+    BOOST_REQUIRE_EQUAL(instance.fill(pool), 5u);
+    BOOST_REQUIRE(instance.is_complete());
+    BOOST_REQUIRE(instance.request().indexes().empty());
+
+    chain::block out;
+    BOOST_REQUIRE(instance.to_block(out));
+    BOOST_REQUIRE(out == block);
+    BOOST_REQUIRE(out.header() == block.header());
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__fill__duplicate_candidate__not_collision)
+{
+    const auto block = make_block(2);
+    message::partial_block instance(message::compact_block(block, 42));
+    BOOST_REQUIRE_EQUAL(instance.fill(make_pool(block, { 1, 1 })), 1u);
+    BOOST_REQUIRE(instance.is_complete());
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__request__misses__differential_indexes)
+{
+    const auto block = make_block(7);
+    message::partial_block instance(message::compact_block(block, 42));
+    BOOST_REQUIRE_EQUAL(instance.fill(make_pool(block, { 1, 4, 5 })), 3u);
+    BOOST_REQUIRE_EQUAL(instance.missing(), 3u);
+    BOOST_REQUIRE(!instance.is_complete());
+
+    chain::block out;
+    BOOST_REQUIRE(!instance.to_block(out));
+
+    // Positions 2, 3 and 6 are encoded as 2, 0, 2.
+    const auto request = instance.request();
+    BOOST_REQUIRE(request.block_hash() == block.hash());
+    BOOST_REQUIRE_EQUAL(request.indexes().size(), 3u);
+    BOOST_REQUIRE_EQUAL(request.indexes()[0], 2u);
+    BOOST_REQUIRE_EQUAL(request.indexes()[1], 0u);
+    BOOST_REQUIRE_EQUAL(request.indexes()[2], 2u);
+
+    const auto& txs = block.transactions();
+    const message::block_transactions reply(block.hash(),
+        { txs[2], txs[3], txs[6] });
+
+    BOOST_REQUIRE(instance.fill(reply));
+    BOOST_REQUIRE(instance.is_complete());
+    BOOST_REQUIRE(instance.to_block(out));
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__fill__mismatched_reply__false)
+{
+    const auto block = make_block(3);
+    message::partial_block instance(message::compact_block(block, 42));
+    const auto& txs = block.transactions();
+    const message::block_transactions wrong_block(null_hash, { txs[1], txs[2] });
+    const message::block_transactions wrong_size(block.hash(), { txs[1] });
+    BOOST_REQUIRE(!instance.fill(wrong_block));
+    BOOST_REQUIRE(!instance.fill(wrong_size));
+    BOOST_REQUIRE_EQUAL(instance.missing(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(partial_block__to_block__wrong_transaction__merkle_mismatch)
+{
+    const auto block = make_block(3);
+    message::compact_block compact(block, 42);
+
+    // Simulate an undetected short id collision with a foreign transaction.
+    const chain::transaction foreign(1, 99, {}, {});
+    const auto key = compact.to_short_id_key();
+    compact.short_ids()[1] = message::compact_block::to_short_id(key,
+        foreign.hash());
+
+    message::partial_block instance(compact);
+    auto pool = make_pool(block, { 1 });
+    pool.push_back(std::make_shared<const message::transaction_message>(
+        foreign));
+
+    BOOST_REQUIRE_EQUAL(instance.fill(pool), 2u);
+    BOOST_REQUIRE(instance.is_complete());
+
+    chain::block out;
+    BOOST_REQUIRE(!instance.to_block(out));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
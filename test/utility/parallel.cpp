@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(parallel_tests)
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__zero_count__not_invoked)
+{
+    threadpool pool(2);
+    std::atomic<size_t> calls(0);
+    parallel_for(pool, 0, [&](size_t, size_t) { ++calls; });
+    BOOST_REQUIRE_EQUAL(calls.load(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__pool__covers_each_element_once)
+{
+    threadpool pool(3);
+    std::vector<std::atomic<size_t>> visits(1001);
+    for (auto& visit: visits)
+        visit = 0;
+
+    std::atomic<size_t> ranges(0);
+    parallel_for(pool, visits.size(), [&](size_t begin, size_t end)
+    {
+        BOOST_REQUIRE_LT(begin, end);
+        ++ranges;
+
+        for (auto index = begin; index < end; ++index)
+            ++visits[index];
+    });
+
+    BOOST_REQUIRE_EQUAL(ranges.load(), 4u);
+    for (const auto& visit: visits)
+        BOOST_REQUIRE_EQUAL(visit.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__empty_pool__single_range)
+{
+    threadpool pool;
+    size_t calls = 0;
+    parallel_for(pool, 42, [&](size_t begin, size_t end)
+    {
+        BOOST_REQUIRE_EQUAL(begin, 0u);
+        BOOST_REQUIRE_EQUAL(end, 42u);
+        ++calls;
+    });
+
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__threads_exceed_count__one_range_per_element)
+{
+    std::atomic<size_t> ranges(0);
+    parallel_for(size_t(8), 3, [&](size_t begin, size_t end)
+    {
+        BOOST_REQUIRE_EQUAL(end - begin, 1u);
+        ++ranges;
+    });
+
+    BOOST_REQUIRE_EQUAL(ranges.load(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__one_thread__calling_thread)
+{
+    const auto caller = std::this_thread::get_id();
+    size_t calls = 0;
+    parallel_for(size_t(1), 42, [&](size_t begin, size_t end)
+    {
+        BOOST_REQUIRE(std::this_thread::get_id() == caller);
+        BOOST_REQUIRE_EQUAL(begin, 0u);
+        BOOST_REQUIRE_EQUAL(end, 42u);
+        ++calls;
+    });
+
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__handler_throws__rethrown)
+{
+    threadpool pool(2);
+    const auto thrower = [](size_t begin, size_t)
+    {
+        if (begin == 0)
+            throw std::runtime_error("range");
+    };
+
+    BOOST_REQUIRE_THROW(parallel_for(pool, 3, thrower), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
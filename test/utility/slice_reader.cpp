@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(slice_reader_tests)
+
+BOOST_AUTO_TEST_CASE(slice_reader__is_exhausted__empty__true)
+{
+    const data_chunk data;
+    slice_reader source(data);
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(source);
+    BOOST_REQUIRE(!!source);
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__is_exhausted__nonempty__false)
+{
+    const data_chunk data(1);
+    slice_reader source(data);
+    BOOST_REQUIRE(!source.is_exhausted());
+    BOOST_REQUIRE(source);
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read__roundtrip__expected)
+{
+    data_chunk data(1 + 2 + 4 + 8 + 4 + 3 + 32 + 6);
+    auto sink = make_serializer(data.begin());
+    sink.write_byte(0x80);
+    sink.write_2_bytes_little_endian(0x8040);
+    sink.write_4_bytes_little_endian(0x80402010);
+    sink.write_8_bytes_little_endian(0x8040201011223344);
+    sink.write_4_bytes_big_endian(0x80402010);
+    sink.write_variable_uint_little_endian(1234);
+    sink.write_hash(null_hash);
+    sink.write_string("hello");
+
+    slice_reader source(data);
+    BOOST_REQUIRE_EQUAL(source.read_byte(), 0x80u);
+    BOOST_REQUIRE_EQUAL(source.read_2_bytes_little_endian(), 0x8040u);
+    BOOST_REQUIRE_EQUAL(source.read_4_bytes_little_endian(), 0x80402010u);
+    BOOST_REQUIRE_EQUAL(source.read_8_bytes_little_endian(), 0x8040201011223344u);
+    BOOST_REQUIRE_EQUAL(source.read_4_bytes_big_endian(), 0x80402010u);
+    BOOST_REQUIRE_EQUAL(source.read_variable_uint_little_endian(), 1234u);
+    BOOST_REQUIRE(source.read_hash() == null_hash);
+    BOOST_REQUIRE_EQUAL(source.read_string(), "hello");
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(source);
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read_4_bytes__insufficient__invalid)
+{
+    const data_chunk data{ 0x01, 0x02 };
+    slice_reader source(data);
+    BOOST_REQUIRE_EQUAL(source.read_4_bytes_little_endian(), 0u);
+    BOOST_REQUIRE(!source);
+    BOOST_REQUIRE(!source.is_exhausted());
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read_data__insufficient__partial_invalid)
+{
+    const data_chunk data{ 0x01, 0x02, 0x03 };
+    slice_reader source(data);
+    BOOST_REQUIRE(source.read_data(1) == data_chunk{ 0x01 });
+    BOOST_REQUIRE(source);
+    BOOST_REQUIRE(source.read_data(max_size_t) == (data_chunk{ 0x02, 0x03 }));
+    BOOST_REQUIRE(!source);
+    BOOST_REQUIRE(source.read_data(1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read_data_to_eof__remaining__expected)
+{
+    const data_chunk data{ 0x01, 0x02, 0x03 };
+    slice_reader source(data);
+    BOOST_REQUIRE_EQUAL(source.read_byte(), 0x01u);
+    BOOST_REQUIRE_EQUAL(source.remaining(), 2u);
+    BOOST_REQUIRE(source.read_data_to_eof() == (data_chunk{ 0x02, 0x03 }));
+    BOOST_REQUIRE(source.is_exhausted());
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__transaction_from_data__matches_stream)
+{
+    const auto data = to_chunk(base16_literal(
+        "0100000001b63634c25f23018c18cbb24ad503672fe7c5edc3fef193ec0f581dd"
+        "b27d4e401490000006a47304402203b361bfb7e189c77379d6ffc90babe1b9658"
+        "39d0b9b60966ade0c4b8de28385f022057432fe6f8f530c54d3513e41da6fb138"
+        "fba2440c877cd2bfb0c94cdb5610fbe0121020d2d76d6db0d1c0bda17950f6468"
+        "6e4bf42481337707e9a81bbe48458cfc8389ffffffff010000000000000000566"
+        "a54e38193e381aee4b896e7958ce381afe4bb96e4babae381abe38288e381a3e3"
+        "81a6e7ac91e9a194e38292e5a5aae3828fe3828ce3828be7bea9e58b99e38292e"
+        "8a8ade38191e381a6e381afe38184e381aae3818400000000"));
+
+    chain::transaction expected;
+    data_source istream(data);
+    BOOST_REQUIRE(expected.from_data(istream));
+
+    chain::transaction instance;
+    slice_reader source(data);
+    BOOST_REQUIRE(instance.from_data(source));
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(instance == expected);
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__transaction_from_data__truncated__false)
+{
+    const auto data = to_chunk(base16_literal(
+        "0100000001b63634c25f23018c18cbb24ad503672fe7c5edc3fef193ec0f581dd"
+        "b27d4e401490000006a47304402203b361bfb7e189c77379d6ffc90babe1b9658"));
+
+    chain::transaction instance;
+    slice_reader source(data);
+    BOOST_REQUIRE(!instance.from_data(source));
+    BOOST_REQUIRE(!source);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
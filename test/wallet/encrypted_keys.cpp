@@ -209,6 +209,31 @@ BOOST_AUTO_TEST_CASE(encrypted__encrypt_private__vector_unicode__expected)
     BC_REQUIRE_ENCRYPT(secret, passphrase, version, compression, expected);
 }
 
+BOOST_AUTO_TEST_CASE(encrypted__encrypt_private__batch__matches_single)
+{
+    const auto compression = false;
+    const uint8_t version = 0x00;
+    const auto passphrase = "TestingOneTwoThree";
+    const secret_list secrets
+    {
+        base16_literal("cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5"),
+        base16_literal("09c2686880095b1a4c249ee3ac4eea8a014f11e6f986d0b5025ac1f39afbd9ae"),
+        base16_literal("64eeab5f9be2a01a8365a579511eb3373c87c40da6d2a25f05bda68fe077b66e")
+    };
+
+    encrypted_private_list out_privates;
+    BOOST_REQUIRE(encrypt(out_privates, secrets, passphrase, version, compression, 2));
+    BOOST_REQUIRE_EQUAL(out_privates.size(), secrets.size());
+    BOOST_REQUIRE_EQUAL(encode_base58(out_privates[0]), "6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg");
+
+    for (size_t index = 0; index < secrets.size(); ++index)
+    {
+        encrypted_private out_private;
+        BOOST_REQUIRE(encrypt(out_private, secrets[index], passphrase, version, compression));
+        BOOST_REQUIRE(out_privates[index] == out_private);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ----------------------------------------------------------------------------
@@ -333,6 +358,32 @@ BOOST_AUTO_TEST_CASE(encrypted__decrypt_private__vector_9_multiplied__expected)
     BOOST_REQUIRE(!out_is_compressed);
 }
 
+BOOST_AUTO_TEST_CASE(encrypted__decrypt_private__batch_wrong_passphrase__null_secret)
+{
+    const encrypted_private_list keys
+    {
+        base58_literal("6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg"),
+        base58_literal("6PRNFFkZc2NZ6dJqFfhRoFNMR9Lnyj7dYGrzdgXXVMXcxoKTePPX1dWByq"),
+        base58_literal("6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo")
+    };
+
+    secret_list out_secrets;
+    data_chunk out_versions;
+    std::vector<bool> out_compressed;
+    BOOST_REQUIRE(!decrypt(out_secrets, out_versions, out_compressed, keys, "TestingOneTwoThree", 3));
+    BOOST_REQUIRE_EQUAL(out_secrets.size(), keys.size());
+    BOOST_REQUIRE_EQUAL(out_versions.size(), keys.size());
+    BOOST_REQUIRE_EQUAL(out_compressed.size(), keys.size());
+
+    // The second key is encrypted with another passphrase.
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[0]), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE(out_secrets[1] == null_hash);
+    BOOST_REQUIRE_EQUAL(encode_base16(out_secrets[2]), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE(!out_compressed[0]);
+    BOOST_REQUIRE(out_compressed[2]);
+    BOOST_REQUIRE_EQUAL(out_versions[2], 0x00);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ----------------------------------------------------------------------------
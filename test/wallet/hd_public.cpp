@@ -96,4 +96,73 @@ BOOST_AUTO_TEST_CASE(hd_public__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__hardened__empty)
+{
+    const hd_public key("xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8");
+    BOOST_REQUIRE(key.derive_public_range(hd_first_hardened_key, 1).empty());
+    BOOST_REQUIRE(key.derive_public_range(hd_first_hardened_key - 1, 2).empty());
+    BOOST_REQUIRE(key.derive_hash_range(hd_first_hardened_key, 1).empty());
+    BOOST_REQUIRE(hd_public().derive_address_range(0, 1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__threads__matches_derive_public)
+{
+    const hd_public key("xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8");
+    const uint32_t first = 5;
+    const size_t count = 17;
+    const auto children = key.derive_public_range(first, count, 4);
+    const auto hashes = key.derive_hash_range(first, count, 3);
+    const auto addresses = key.derive_address_range(first, count,
+        payment_address::mainnet_p2kh, 2);
+
+    BOOST_REQUIRE_EQUAL(children.size(), count);
+    BOOST_REQUIRE_EQUAL(hashes.size(), count);
+    BOOST_REQUIRE_EQUAL(addresses.size(), count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto child = key.derive_public(first + index);
+        BOOST_REQUIRE(children[index] == child);
+        BOOST_REQUIRE(hashes[index] == bitcoin_short_hash(child.point()));
+        BOOST_REQUIRE_EQUAL(addresses[index].encoded(),
+            payment_address(ec_public(child.point())).encoded());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__threadpool__matches_derive_public)
+{
+    const hd_public key("xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8");
+    const uint32_t first = 11;
+    const size_t count = 9;
+    threadpool pool(3);
+    const auto children = key.derive_public_range(first, count, pool);
+    const auto hashes = key.derive_hash_range(first, count, pool);
+    const auto addresses = key.derive_address_range(first, count,
+        payment_address::mainnet_p2kh, pool);
+
+    BOOST_REQUIRE_EQUAL(children.size(), count);
+    BOOST_REQUIRE_EQUAL(hashes.size(), count);
+    BOOST_REQUIRE_EQUAL(addresses.size(), count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto child = key.derive_public(first + index);
+        BOOST_REQUIRE(children[index] == child);
+        BOOST_REQUIRE(hashes[index] == bitcoin_short_hash(child.point()));
+        BOOST_REQUIRE_EQUAL(addresses[index].encoded(),
+            payment_address(ec_public(child.point())).encoded());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__private_parent__matches_derive_public)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto children = m.derive_public_range(0, 3);
+    BOOST_REQUIRE_EQUAL(children.size(), 3u);
+    BOOST_REQUIRE_EQUAL(children[2].encoded(), m.derive_public(2).encoded());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,24 @@ BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__no_passphrase)
     }
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__no_passphrase__expected)
+{
+    word_lists mnemonics;
+    for (const auto& vector: mnemonic_trezor_vectors)
+        mnemonics.push_back(split(vector.mnemonic, ","));
+
+    const auto seeds = decode_mnemonics(mnemonics, 3);
+    BOOST_REQUIRE_EQUAL(seeds.size(), mnemonics.size());
+
+    for (size_t index = 0; index < mnemonics.size(); ++index)
+        BOOST_REQUIRE(seeds[index] == decode_mnemonic(mnemonics[index]));
+}
+
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__empty__empty)
+{
+    BOOST_REQUIRE(decode_mnemonics(word_lists{}, 4).empty());
+}
+
 #ifdef WITH_ICU
 
 BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__trezor)
@@ -62,6 +80,20 @@ BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__bx)
     }
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__passphrases__expected)
+{
+    const auto& vector = mnemonic_trezor_vectors.front();
+    const auto words = split(vector.mnemonic, ",");
+    const string_list passphrases{ "", "wrong", vector.passphrase, "TREZOR!", "trezor" };
+
+    const auto seeds = decode_mnemonics(words, passphrases, 2);
+    BOOST_REQUIRE_EQUAL(seeds.size(), passphrases.size());
+    BOOST_REQUIRE_EQUAL(encode_base16(seeds[2]), vector.seed);
+
+    for (size_t index = 0; index < passphrases.size(); ++index)
+        BOOST_REQUIRE(seeds[index] == decode_mnemonic(words, passphrases[index]));
+}
+
 #endif
 
 BOOST_AUTO_TEST_CASE(mnemonic__create_mnemonic__trezor)